@@ -5,10 +5,13 @@
 #ifndef HL_ARCHIVE_H_INCLUDED
 #define HL_ARCHIVE_H_INCLUDED
 #include "../hl_text.h"
+#include "../hl_memory.h"
 #include <vector>
 
 namespace hl
 {
+class thread_pool;
+
 // TODO: Make this an enum class
 enum archive_entry_flags : std::size_t
 {
@@ -24,6 +27,29 @@ class archive_entry
 {
     friend archive_entry_list;
 
+    /**
+        @brief Deleter for m_path which does nothing if the path
+        is owned by an arena rather than by this entry.
+    */
+    struct in_path_deleter
+    {
+        bool ownsPath = true;
+
+        inline void operator()(nchar* path) const noexcept
+        {
+            if (ownsPath) delete[] path;
+        }
+
+        inline in_path_deleter() noexcept = default;
+
+        inline in_path_deleter(bool ownsPath) noexcept :
+            ownsPath(ownsPath) {}
+
+        inline in_path_deleter(const std::default_delete<nchar[]>&) noexcept {}
+    };
+
+    using in_path_ptr = std::unique_ptr<nchar[], in_path_deleter>;
+
     /**
         @brief Various metadata related to the entry, including flags specifying what
         type of entry this is.
@@ -54,7 +80,7 @@ class archive_entry
         @brief The name of the file or directory represented by this entry, or the
         absolute path to the file if this entry is a file reference.
     */
-    std::unique_ptr<nchar[]> m_path;
+    in_path_ptr m_path;
     /**
         @brief The uncompressed size of the file if this entry represents a file.
         Unused if this entry represents a directory.
@@ -93,6 +119,20 @@ class archive_entry
         m_path(text::make_copy(path)), m_size(size),
         m_streamingData(dataNum) {}
 
+    inline archive_entry(std::size_t meta, in_path_ptr path,
+        std::size_t size, void* dataPtr) noexcept : m_meta(meta),
+        m_path(std::move(path)), m_size(size), m_data(dataPtr) {}
+
+    inline archive_entry(std::size_t meta, in_path_ptr path,
+        std::size_t size, std::uintmax_t dataNum) noexcept : m_meta(meta),
+        m_path(std::move(path)), m_size(size), m_streamingData(dataNum) {}
+
+    static in_path_ptr in_arena_copy_path(arena& arena, const nchar* path);
+
+#ifdef HL_IN_WIN32_UNICODE
+    static in_path_ptr in_arena_copy_path(arena& arena, const char* path);
+#endif
+
 public:
     inline bool is_streaming_file() const noexcept
     {
@@ -188,6 +228,17 @@ public:
         std::size_t uncompressedSize, std::size_t compressedSize = 0,
         std::uintmax_t customData = 0);
 
+    /**
+        @brief Constructs an archive_entry which represents a streaming file,
+               and whose name is allocated from the given arena.
+
+        The returned entry must not outlive the given arena!
+        @ingroup archives
+    */
+    HL_API static archive_entry make_streaming_file_utf8(arena& arena,
+        const char* fileName, std::size_t uncompressedSize,
+        std::size_t compressedSize = 0, std::uintmax_t customData = 0);
+
     inline static archive_entry make_streaming_file(const nstring& fileName,
         std::size_t uncompressedSize, std::size_t compressedSize = 0,
         std::uintmax_t customData = 0)
@@ -219,6 +270,17 @@ public:
         return make_dir(dirName.c_str(), initialEntryCount);
     }
 
+    /**
+        @brief Constructs an archive_entry which represents a directory, and whose
+               name is allocated from the given arena. Entries added to the
+               directory via its archive_entry_list will also use the arena.
+
+        The returned entry must not outlive the given arena!
+        @ingroup archives
+    */
+    HL_API static archive_entry make_dir(arena& arena, const nchar* dirName,
+        std::size_t initialEntryCount = 0);
+
     /**
         @brief Constructs an archive_entry which represents a file and which does
                *NOT* create its own copy of data, meaning you will have to manually
@@ -285,6 +347,32 @@ public:
         return make_regular_file_utf8(fileName.c_str(), fileSize, data);
     }
 
+    /**
+        @brief Constructs an archive_entry which represents a file, and whose
+               name (and copy of data) are allocated from the given arena.
+
+        @param[in] arena        The arena to allocate the name and data from.
+                                The returned entry must not outlive it!
+        @param[in] fileName     The name of the file + its extension if it has one.
+        @param[in] fileSize     The uncompressed size of the file, in bytes.
+        @param[in] data         A pointer to the file's uncompressed data.
+
+        @return The newly-constructed archive_entry.
+        @ingroup archives
+    */
+    HL_API static archive_entry make_regular_file_utf8(arena& arena,
+        const char* fileName, std::size_t fileSize, const void* data);
+
+    /**
+        @brief Constructs an archive_entry which represents a file, and whose name
+               is allocated from the given arena. Like make_regular_file_no_alloc_utf8,
+               this does *NOT* create its own copy of data.
+
+        @ingroup archives
+    */
+    HL_API static archive_entry make_regular_file_no_alloc_utf8(arena& arena,
+        const char* fileName, std::size_t fileSize, void* data);
+
     /**
         @brief Constructs an archive_entry which represents a file and which does
                *NOT* create its own copy of data, meaning you will have to manually
@@ -351,6 +439,22 @@ public:
         return make_regular_file(fileName.c_str(), fileSize, data);
     }
 
+    /**
+        @brief Constructs an archive_entry which represents a file, and whose
+               name (and copy of data) are allocated from the given arena.
+
+        @param[in] arena        The arena to allocate the name and data from.
+                                The returned entry must not outlive it!
+        @param[in] fileName     The name of the file + its extension if it has one.
+        @param[in] fileSize     The uncompressed size of the file, in bytes.
+        @param[in] data         A pointer to the file's uncompressed data.
+
+        @return The newly-constructed archive_entry.
+        @ingroup archives
+    */
+    HL_API static archive_entry make_regular_file(arena& arena,
+        const nchar* fileName, std::size_t fileSize, const void* data);
+
     /**
         @brief Constructs an archive_entry which represents a file.
         @param[in] filePath     The path to the file.
@@ -411,11 +515,50 @@ public:
 
 struct archive_entry_list : public std::vector<archive_entry>
 {
-    HL_API void extract(const nchar* dirPath, bool recursive = true) const;
+private:
+    arena* m_arena = nullptr;
+
+public:
+    /**
+        @brief Returns the arena used to allocate the names/data of entries
+        added via this list's add_* functions, or null if those entries
+        are allocated individually on the heap.
+    */
+    inline arena* get_arena() const noexcept
+    {
+        return m_arena;
+    }
+
+    /**
+        @brief Sets the arena used to allocate the names/data of entries
+        added via this list's add_* functions from now on.
+
+        @param[in] arena    The arena to use, or null to allocate entries
+                            individually on the heap. Entries allocated from
+                            an arena must not outlive it!
+    */
+    inline void set_arena(arena* arena) noexcept
+    {
+        m_arena = arena;
+    }
+
+    /**
+        @brief Extracts this list's entries into the given directory.
+
+        All directories are created first, after which, all files are written.
+
+        @param[in] dirPath      The directory to extract the entries into.
+        @param[in] recursive    Whether to extract directory entries' contents as well.
+        @param[in] pool         An optional thread pool to write files in parallel
+                                with, or null to write them one-by-one.
+    */
+    HL_API void extract(const nchar* dirPath, bool recursive = true,
+        thread_pool* pool = nullptr) const;
 
-    inline void extract(const nstring& dirPath, bool recursive = true) const
+    inline void extract(const nstring& dirPath, bool recursive = true,
+        thread_pool* pool = nullptr) const
     {
-        extract(dirPath.c_str(), recursive);
+        extract(dirPath.c_str(), recursive, pool);
     }
 
     inline void add_file(const nchar* filePath, bool loadData = false)
@@ -439,8 +582,16 @@ struct archive_entry_list : public std::vector<archive_entry>
     inline void add_file(const nchar* fileName,
         std::size_t fileSize, const void* data)
     {
-        emplace_back(archive_entry::make_regular_file(
-            fileName, fileSize, data));
+        if (m_arena)
+        {
+            emplace_back(archive_entry::make_regular_file(
+                *m_arena, fileName, fileSize, data));
+        }
+        else
+        {
+            emplace_back(archive_entry::make_regular_file(
+                fileName, fileSize, data));
+        }
     }
 
     /**
@@ -454,8 +605,7 @@ struct archive_entry_list : public std::vector<archive_entry>
     inline void add_file(const nstring& fileName,
         std::size_t fileSize, const void* data)
     {
-        emplace_back(archive_entry::make_regular_file(
-            fileName, fileSize, data));
+        add_file(fileName.c_str(), fileSize, data);
     }
 
     /**
@@ -469,8 +619,16 @@ struct archive_entry_list : public std::vector<archive_entry>
     inline void add_file_utf8(const char* fileName,
         std::size_t fileSize, const void* data)
     {
-        emplace_back(archive_entry::make_regular_file_utf8(
-            fileName, fileSize, data));
+        if (m_arena)
+        {
+            emplace_back(archive_entry::make_regular_file_utf8(
+                *m_arena, fileName, fileSize, data));
+        }
+        else
+        {
+            emplace_back(archive_entry::make_regular_file_utf8(
+                fileName, fileSize, data));
+        }
     }
 
     /**
@@ -484,8 +642,85 @@ struct archive_entry_list : public std::vector<archive_entry>
     inline void add_file_utf8(const std::string& fileName,
         std::size_t fileSize, const void* data)
     {
-        emplace_back(archive_entry::make_regular_file_utf8(
-            fileName, fileSize, data));
+        add_file_utf8(fileName.c_str(), fileSize, data);
+    }
+
+    /**
+        @brief Adds an archive_entry which represents a file and which does
+               *NOT* create its own copy of data (e.g. a view into a mapped_file).
+
+        @param[in] fileName     The name of the file + its extension if it has one.
+        @param[in] fileSize     The uncompressed size of the file, in bytes.
+        @param[in] data         A pointer to the file's uncompressed data.
+                                This pointer must remain valid for as long as
+                                the archive_entry exists!
+
+        @ingroup archives
+    */
+    inline void add_file_no_alloc_utf8(const char* fileName,
+        std::size_t fileSize, void* data)
+    {
+        if (m_arena)
+        {
+            emplace_back(archive_entry::make_regular_file_no_alloc_utf8(
+                *m_arena, fileName, fileSize, data));
+        }
+        else
+        {
+            emplace_back(archive_entry::make_regular_file_no_alloc_utf8(
+                fileName, fileSize, data));
+        }
+    }
+
+    /**
+        @brief Adds an archive_entry which represents a file and which does
+               *NOT* create its own copy of data (e.g. a view into a mapped_file).
+
+        @param[in] fileName     The name of the file + its extension if it has one.
+        @param[in] fileSize     The uncompressed size of the file, in bytes.
+        @param[in] data         A pointer to the file's uncompressed data.
+                                This pointer must remain valid for as long as
+                                the archive_entry exists!
+
+        @ingroup archives
+    */
+    inline void add_file_no_alloc_utf8(const std::string& fileName,
+        std::size_t fileSize, void* data)
+    {
+        add_file_no_alloc_utf8(fileName.c_str(), fileSize, data);
+    }
+
+    /**
+        @brief Adds an archive_entry which represents a streaming file.
+        @param[in] fileName         The name of the file + its extension if it has one.
+        @param[in] uncompressedSize The uncompressed size of the file, in bytes.
+        @param[in] compressedSize   The compressed size of the file, or 0 if it isn't compressed.
+        @param[in] customData       Format-specific data used to locate the file later.
+
+        @ingroup archives
+    */
+    inline void add_streaming_file_utf8(const char* fileName,
+        std::size_t uncompressedSize, std::size_t compressedSize = 0,
+        std::uintmax_t customData = 0)
+    {
+        if (m_arena)
+        {
+            emplace_back(archive_entry::make_streaming_file_utf8(*m_arena,
+                fileName, uncompressedSize, compressedSize, customData));
+        }
+        else
+        {
+            emplace_back(archive_entry::make_streaming_file_utf8(
+                fileName, uncompressedSize, compressedSize, customData));
+        }
+    }
+
+    inline void add_streaming_file_utf8(const std::string& fileName,
+        std::size_t uncompressedSize, std::size_t compressedSize = 0,
+        std::uintmax_t customData = 0)
+    {
+        add_streaming_file_utf8(fileName.c_str(),
+            uncompressedSize, compressedSize, customData);
     }
 
     HL_API void add_dir_contents(const nchar* dirPath,
@@ -498,6 +733,18 @@ struct archive_entry_list : public std::vector<archive_entry>
     }
 
     inline archive_entry_list() = default;
+
+    /**
+        @brief Constructs an empty list which allocates the names/data of
+        entries added via its add_* functions from the given arena.
+
+        This avoids making several small heap allocations per entry when
+        loading archives with lots of files. The arena must outlive every
+        entry allocated from it (including entries moved out of this list;
+        copies are always heap-allocated), but can then free them all at once.
+    */
+    inline explicit archive_entry_list(arena& arena) noexcept :
+        m_arena(&arena) {}
     
     inline archive_entry_list(const nchar* dirPath,
         bool loadData = false, bool recursive = true)
@@ -2,7 +2,7 @@
 #define HL_HH_ARCHIVE_H_INCLUDED
 #include "hl_archive.h"
 #include "../hl_compression.h"
-#include"../io/hl_stream.h"
+#include "../io/hl_file.h"
 
 namespace hl
 {
@@ -62,6 +62,14 @@ struct header
 
     HL_API void parse(std::size_t hhArcSize,
         archive_entry_list& hlArc) const;
+
+    /**
+        @brief Parses this archive without making copies of the files' data.
+        The resulting archive entries point directly into this archive's data,
+        so it must remain valid for as long as the entries exist.
+    */
+    HL_API void parse_no_alloc(std::size_t hhArcSize,
+        archive_entry_list& hlArc);
 };
 
 HL_STATIC_ASSERT_SIZE(header, 16);
@@ -133,6 +141,13 @@ inline void parse(const blob& hhArc, archive_entry_list& hlArc)
     parse(hhArc.data(), hhArc.size(), hlArc);
 }
 
+inline void parse_no_alloc(void* hhArc, std::size_t hhArcSize,
+    archive_entry_list& hlArc)
+{
+    header* ar = static_cast<header*>(hhArc);
+    ar->parse_no_alloc(hhArcSize, hlArc);
+}
+
 HL_API void read(blob& hhArc, archive_entry_list* hlArc,
     std::vector<blob>* hhArcs = nullptr);
 
@@ -179,6 +194,33 @@ inline archive load(const nstring& filePath)
     return load(filePath.c_str());
 }
 
+/**
+    @brief Memory-maps the given archive and parses it without copying any of
+    its files' data; the resulting archive entries point directly into the
+    mapping, which is added to hhArcs, and so remain valid only for as long
+    as hhArcs is kept around.
+*/
+HL_API void load_mapped_single(const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& hhArcs);
+
+inline void load_mapped_single(const nstring& filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& hhArcs)
+{
+    load_mapped_single(filePath.c_str(), hlArc, hhArcs);
+}
+
+/**
+    @brief Memory-maps the given archive (and all of its splits, if the given
+    path is a split) and parses it without copying any of its files' data.
+
+    See load_mapped_single for details.
+*/
+HL_API void load_mapped(const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& hhArcs);
+
+HL_API void load_mapped(const nstring& filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& hhArcs);
+
 HL_API void save(const archive_entry_list& arc,
     const nchar* filePath, u32 splitLimit = default_split_limit,
     u32 dataAlignment = default_alignment, compress_type compressType = compress_type::none,
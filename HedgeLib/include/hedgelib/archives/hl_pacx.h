@@ -3,10 +3,13 @@
 #include "hl_archive.h"
 #include "../hl_blob.h"
 #include "../io/hl_bina.h"
+#include "../io/hl_file.h"
 #include "../hl_compression.h"
 
 namespace hl
 {
+class thread_pool;
+
 namespace pacx
 {
 constexpr u32 sig = make_sig("PACx");
@@ -200,6 +203,9 @@ struct data_entry
 
     HL_API bool has_merged_bina_data(bina::off_table_handle::iterator beg,
         const bina::off_table_handle::iterator& end, const void* base) const noexcept;
+
+    HL_API bool has_merged_bina_data(const std::vector<u32>& offPositions,
+        const void* base) const noexcept;
 };
 
 HL_STATIC_ASSERT_SIZE(data_entry, 16);
@@ -429,6 +435,14 @@ struct block_data_header
     HL_API void parse(const void* header, bina::endian_flag endianFlag,
         archive_entry_list& hlArc, bool skipProxies = true) const;
 
+    /**
+        @brief Parses this data block without making copies of the files' data
+        where possible. The resulting archive entries may point directly into
+        this pac's data, so it must remain valid for as long as they exist.
+    */
+    HL_API void parse_no_alloc(void* header, bina::endian_flag endianFlag,
+        archive_entry_list& hlArc, bool skipProxies = true);
+
     HL_API static void start_write(stream& stream);
 
     HL_API static void finish_write(std::size_t dataBlockPos,
@@ -518,6 +532,13 @@ struct header
     HL_API void fix();
     HL_API void parse(archive_entry_list& hlArc, bool skipProxies = true) const;
 
+    /**
+        @brief Parses this pac without making copies of the files' data where
+        possible. The resulting archive entries may point directly into this
+        pac's data, so it must remain valid for as long as they exist.
+    */
+    HL_API void parse_no_alloc(archive_entry_list& hlArc, bool skipProxies = true);
+
     HL_API static void start_write(bina::ver version,
         bina::endian_flag endianFlag, stream& stream);
 
@@ -546,6 +567,43 @@ inline void parse(const void* pac, archive_entry_list& hlArc,
     headerPtr->parse(hlArc, skipProxies);
 }
 
+inline void parse_no_alloc(void* pac, archive_entry_list& hlArc,
+    bool skipProxies = true)
+{
+    header* headerPtr = static_cast<header*>(pac);
+    headerPtr->parse_no_alloc(hlArc, skipProxies);
+}
+
+/**
+    @brief Memory-maps the given pac and parses it without copying its files'
+    data where possible; the resulting archive entries may point directly into
+    the mapping, which is added to pacs, and so remain valid only for as long
+    as pacs is kept around.
+*/
+HL_API void load_mapped_single(const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs);
+
+inline void load_mapped_single(const nstring& filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs)
+{
+    load_mapped_single(filePath.c_str(), hlArc, pacs);
+}
+
+/**
+    @brief Memory-maps the given pac and all of its dependencies, and parses
+    them without copying their files' data where possible.
+
+    See load_mapped_single for details.
+*/
+HL_API void load_mapped(const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs);
+
+inline void load_mapped(const nstring& filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs)
+{
+    load_mapped(filePath.c_str(), hlArc, pacs);
+}
+
 HL_API void read(blob& pac, archive_entry_list* hlArc,
     std::vector<blob>* pacs = nullptr);
 
@@ -601,15 +659,17 @@ inline archive load(const nstring& filePath)
 HL_API void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     const supported_ext* exts, const std::size_t extCount,
     const nchar* filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr);
+    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr,
+    thread_pool* pool = nullptr);
 
 inline void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     const supported_ext* exts, const std::size_t extCount,
     const nstring& filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr)
+    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr,
+    thread_pool* pool = nullptr)
 {
     save(arc, endianFlag, exts, extCount,
-        filePath, splitLimit, dataAlignment, pfi);
+        filePath.c_str(), splitLimit, dataAlignment, pfi, pool);
 }
 } // v2
 
@@ -1009,6 +1069,13 @@ struct header
     HL_API void fix();
     HL_API void parse(archive_entry_list& hlArc, bool skipProxies = true) const;
 
+    /**
+        @brief Parses this pac without making copies of the files' data where
+        possible. The resulting archive entries may point directly into this
+        pac's data, so it must remain valid for as long as they exist.
+    */
+    HL_API void parse_no_alloc(archive_entry_list& hlArc, bool skipProxies = true);
+
     HL_API static void start_write(bina::ver version,
         u32 uid, pac_type type, compress_type compressType,
         bina::endian_flag endianFlag, stream& stream);
@@ -1042,6 +1109,43 @@ inline void parse(const void* pac, archive_entry_list& hlArc,
     headerPtr->parse(hlArc, skipProxies);
 }
 
+inline void parse_no_alloc(void* pac, archive_entry_list& hlArc,
+    bool skipProxies = true)
+{
+    header* headerPtr = static_cast<header*>(pac);
+    headerPtr->parse_no_alloc(hlArc, skipProxies);
+}
+
+/**
+    @brief Memory-maps the given pac and parses it without copying its files'
+    data where possible; the resulting archive entries may point directly into
+    the mapping, which is added to pacs, and so remain valid only for as long
+    as pacs is kept around.
+*/
+HL_API void load_mapped_single(const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs);
+
+inline void load_mapped_single(const nstring& filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs)
+{
+    load_mapped_single(filePath.c_str(), hlArc, pacs);
+}
+
+/**
+    @brief Memory-maps the given pac and all of its dependencies, and parses
+    them without copying their files' data where possible.
+
+    See load_mapped_single for details.
+*/
+HL_API void load_mapped(const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs);
+
+inline void load_mapped(const nstring& filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs)
+{
+    load_mapped(filePath.c_str(), hlArc, pacs);
+}
+
 HL_API void read(blob& pac, archive_entry_list* hlArc,
     std::vector<blob>* pacs = nullptr);
 
@@ -1096,18 +1200,26 @@ inline archive load(const nstring& filePath)
 
 HL_API u32 generate_uid();
 
+/**
+    @brief Re-seeds the random number generator used by generate_uid, so the
+    same sequence of UIDs (and thus byte-identical pacs) is generated afterwards.
+*/
+HL_API void seed_uid_generator(u32 seed);
+
 HL_API void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     const supported_ext* exts, const std::size_t extCount,
     const nchar* filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr);
+    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr,
+    thread_pool* pool = nullptr);
 
 inline void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     const supported_ext* exts, const std::size_t extCount,
     const nstring& filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr)
+    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr,
+    thread_pool* pool = nullptr)
 {
     save(arc, endianFlag, exts, extCount,
-        filePath, splitLimit, dataAlignment, pfi);
+        filePath.c_str(), splitLimit, dataAlignment, pfi, pool);
 }
 } // v3
 
@@ -1177,7 +1289,8 @@ struct lz4_dep_info
         hl::endian_swap<swapOffsets>(chunks);
     }
 
-    HL_API blob decompress_dep(const void* pac) const;
+    HL_API blob decompress_dep(const void* pac,
+        thread_pool* pool = nullptr) const;
 };
 
 HL_STATIC_ASSERT_SIZE(lz4_dep_info, 0x20);
@@ -1202,7 +1315,8 @@ struct deflate_dep_info
         hl::endian_swap(dataPos);
     }
 
-    HL_API blob decompress_dep(const void* pac) const;
+    HL_API blob decompress_dep(const void* pac,
+        thread_pool* pool = nullptr) const;
 };
 
 HL_STATIC_ASSERT_SIZE(deflate_dep_info, 0x18);
@@ -1326,7 +1440,7 @@ struct header
     }
 
     HL_API void fix();
-    HL_API blob decompress_root() const;
+    HL_API blob decompress_root(thread_pool* pool = nullptr) const;
 
     HL_API static void start_write(u32 uid, compress_type compressType,
         bina::endian_flag endianFlag, stream& stream);
@@ -1344,37 +1458,42 @@ inline void fix(void* pac)
     headerPtr->fix();
 }
 
-inline blob decompress_root(const void* pac)
+inline blob decompress_root(const void* pac,
+    thread_pool* pool = nullptr)
 {
     const header* headerPtr = static_cast<const header*>(pac);
-    return headerPtr->decompress_root();
+    return headerPtr->decompress_root(pool);
 }
 
 HL_API void read(void* pac, archive_entry_list* hlArc,
-    std::vector<blob>* pacs = nullptr, bool readSplits = true);
+    std::vector<blob>* pacs = nullptr, bool readSplits = true,
+    thread_pool* pool = nullptr);
 
 HL_API void write(const archive_entry_list& arc,
     const nchar* pacName, u32 maxChunkSize,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     stream& stream, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, bool noCompress = false);
+    u32 dataAlignment = default_alignment, bool noCompress = false,
+    thread_pool* pool = nullptr);
 
 HL_API void save(archive_entry_list& arc, u32 maxChunkSize,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     const nchar* filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, bool noCompress = false);
+    u32 dataAlignment = default_alignment, bool noCompress = false,
+    thread_pool* pool = nullptr);
 
 inline void save(archive_entry_list& arc, u32 maxChunkSize,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     const nstring& filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, bool noCompress = false)
+    u32 dataAlignment = default_alignment, bool noCompress = false,
+    thread_pool* pool = nullptr)
 {
     save(arc, maxChunkSize, compressType, endianFlag,
         extCount, exts, filePath, splitLimit, dataAlignment,
-        noCompress);
+        noCompress, pool);
 }
 } // v02
 
@@ -1543,7 +1662,7 @@ struct header
     }
 
     HL_API void fix();
-    HL_API blob decompress_root() const;
+    HL_API blob decompress_root(thread_pool* pool = nullptr) const;
 
     HL_API static void start_write(u32 uid, bool hasParents,
         compress_type compressType, bina::endian_flag endianFlag,
@@ -1562,15 +1681,17 @@ inline void fix(void* pac)
     headerPtr->fix();
 }
 
-inline blob decompress_root(const void* pac)
+inline blob decompress_root(const void* pac,
+    thread_pool* pool = nullptr)
 {
     const header* headerPtr = static_cast<const header*>(pac);
-    return headerPtr->decompress_root();
+    return headerPtr->decompress_root(pool);
 }
 
 HL_API void read(void* pac, archive_entry_list* hlArc,
     std::vector<blob>* pacs = nullptr, bool readSplits = true,
-    std::vector<std::string>* parentPaths = nullptr);
+    std::vector<std::string>* parentPaths = nullptr,
+    thread_pool* pool = nullptr);
 
 HL_API std::vector<std::string> parse_dependencies_file(
     const char* depsFile, std::size_t depsFileSize);
@@ -1590,7 +1711,8 @@ HL_API void write(const archive_entry_list& arc,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     stream& stream, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, bool noCompress = false);
+    u32 dataAlignment = default_alignment, bool noCompress = false,
+    thread_pool* pool = nullptr);
 
 HL_API void save(const archive_entry_list& arc,
     const std::vector<std::string>* parentPaths,
@@ -1599,7 +1721,8 @@ HL_API void save(const archive_entry_list& arc,
     const supported_ext* exts, const nchar* filePath,
     u32 splitLimit = default_split_limit,
     u32 dataAlignment = default_alignment,
-    bool noCompress = false);
+    bool noCompress = false,
+    thread_pool* pool = nullptr);
 
 inline void save(const archive_entry_list& arc,
     const std::vector<std::string>* parentPaths,
@@ -1608,28 +1731,31 @@ inline void save(const archive_entry_list& arc,
     const supported_ext* exts, const nstring& filePath,
     u32 splitLimit = default_split_limit,
     u32 dataAlignment = default_alignment,
-    bool noCompress = false)
+    bool noCompress = false,
+    thread_pool* pool = nullptr)
 {
     save(arc, parentPaths, maxChunkSize, compressType,
         endianFlag, extCount, exts, filePath.c_str(),
-        splitLimit, dataAlignment, noCompress);
+        splitLimit, dataAlignment, noCompress, pool);
 }
 
 HL_API void save(archive_entry_list& arc, u32 maxChunkSize,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     const nchar* filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, bool noCompress = false);
+    u32 dataAlignment = default_alignment, bool noCompress = false,
+    thread_pool* pool = nullptr);
 
 inline void save(archive_entry_list& arc, u32 maxChunkSize,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     const nstring& filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, bool noCompress = false)
+    u32 dataAlignment = default_alignment, bool noCompress = false,
+    thread_pool* pool = nullptr)
 {
     save(arc, maxChunkSize, compressType, endianFlag,
         extCount, exts, filePath.c_str(), splitLimit, dataAlignment,
-        noCompress);
+        noCompress, pool);
 }
 } // v03
 
@@ -1643,17 +1769,19 @@ inline void fix(void* pac)
     headerPtr->fix();
 }
 
-inline blob decompress_root(const void* pac)
+inline blob decompress_root(const void* pac,
+    thread_pool* pool = nullptr)
 {
     const header* headerPtr = static_cast<const header*>(pac);
-    return headerPtr->decompress_root();
+    return headerPtr->decompress_root(pool);
 }
 
 inline void read(void* pac, archive_entry_list* hlArc,
     std::vector<blob>* pacs = nullptr, bool readSplits = true,
-    std::vector<std::string>* parentPaths = nullptr)
+    std::vector<std::string>* parentPaths = nullptr,
+    thread_pool* pool = nullptr)
 {
-    v03::read(pac, hlArc, pacs, readSplits, parentPaths);
+    v03::read(pac, hlArc, pacs, readSplits, parentPaths, pool);
 }
 
 HL_API void write(const archive_entry_list& arc,
@@ -1662,7 +1790,8 @@ HL_API void write(const archive_entry_list& arc,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     stream& stream, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, bool noCompress = false);
+    u32 dataAlignment = default_alignment, bool noCompress = false,
+    thread_pool* pool = nullptr);
 
 HL_API void save(const archive_entry_list& arc,
     const std::vector<std::string>* parentPaths,
@@ -1671,7 +1800,8 @@ HL_API void save(const archive_entry_list& arc,
     const supported_ext* exts, const nchar* filePath,
     u32 splitLimit = default_split_limit,
     u32 dataAlignment = default_alignment,
-    bool noCompress = false);
+    bool noCompress = false,
+    thread_pool* pool = nullptr);
 
 inline void save(const archive_entry_list& arc,
     const std::vector<std::string>* parentPaths,
@@ -1680,28 +1810,31 @@ inline void save(const archive_entry_list& arc,
     const supported_ext* exts, const nstring& filePath,
     u32 splitLimit = default_split_limit,
     u32 dataAlignment = default_alignment,
-    bool noCompress = false)
+    bool noCompress = false,
+    thread_pool* pool = nullptr)
 {
     save(arc, parentPaths, maxChunkSize, compressType,
         endianFlag, extCount, exts, filePath.c_str(),
-        splitLimit, dataAlignment, noCompress);
+        splitLimit, dataAlignment, noCompress, pool);
 }
 
 HL_API void save(archive_entry_list& arc, u32 maxChunkSize,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     const nchar* filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, bool noCompress = false);
+    u32 dataAlignment = default_alignment, bool noCompress = false,
+    thread_pool* pool = nullptr);
 
 inline void save(archive_entry_list& arc, u32 maxChunkSize,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     const nstring& filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, bool noCompress = false)
+    u32 dataAlignment = default_alignment, bool noCompress = false,
+    thread_pool* pool = nullptr)
 {
     save(arc, maxChunkSize, compressType, endianFlag,
         extCount, exts, filePath.c_str(), splitLimit, dataAlignment,
-        noCompress);
+        noCompress, pool);
 }
 } // v05
 
@@ -1709,17 +1842,27 @@ using header = v03::header;
 
 HL_API void fix(void* pac);
 
+/**
+    @brief Decompresses the given chunked LZ4 data into dst.
+
+    @param pool If not null, the chunks will be decompressed in parallel
+    across the given thread pool. This is possible as the position of every
+    chunk within both src and dst is known before decompression begins.
+*/
 HL_API void decompress_no_alloc_lz4(u32 chunkCount,
     const chunk* chunks, u32 srcSize,
-    const void* src, u32 dstSize, void* dst);
+    const void* src, u32 dstSize, void* dst,
+    thread_pool* pool = nullptr);
 
 HL_API std::unique_ptr<u8[]> decompress_lz4(u32 chunkCount,
     const chunk* chunks, u32 srcSize,
-    const void* src, u32 dstSize);
+    const void* src, u32 dstSize,
+    thread_pool* pool = nullptr);
 
 HL_API blob decompress_lz4_blob(u32 chunkCount,
     const chunk* chunks, u32 srcSize,
-    const void* src, u32 dstSize);
+    const void* src, u32 dstSize,
+    thread_pool* pool = nullptr);
 
 HL_API void decompress_no_alloc_deflate(u32 srcSize,
     const void* src, u32 dstSize, void* dst);
@@ -1742,6 +1885,21 @@ HL_API blob compress_blob_lz4(u32 maxChunkSize,
     std::size_t srcSize, const void* src,
     std::vector<chunk>& chunks);
 
+/**
+    @brief Compresses the given data into LZ4 chunks, writing each chunk to
+    the given stream as soon as it has been compressed, so that only a single
+    compressed chunk is ever held in memory at a time.
+
+    If a thread pool is given, one chunk per thread is compressed in
+    parallel instead, and the whole batch is written once it has finished.
+    The output is identical either way.
+
+    @return The total compressed size of all of the chunks written.
+*/
+HL_API std::size_t compress_to_stream_lz4(u32 maxChunkSize,
+    std::size_t srcSize, const void* src, stream& stream,
+    std::vector<chunk>& chunks, thread_pool* pool = nullptr);
+
 HL_API std::size_t compress_no_alloc_deflate(std::size_t srcSize,
     const void* src, std::size_t dstBufSize, void* dst);
 
@@ -1749,65 +1907,70 @@ HL_API std::unique_ptr<u8[]> compress_deflate(std::size_t srcSize,
     const void* src, std::size_t& dstSize);
 
 HL_API blob compress_blob_deflate(std::size_t srcSize, const void* src);
-HL_API blob decompress_root(const void* pac);
+
+HL_API std::size_t compress_to_stream_deflate(std::size_t srcSize,
+    const void* src, stream& stream);
+
+HL_API blob decompress_root(const void* pac, thread_pool* pool = nullptr);
 
 HL_API void read(void* pac, archive_entry_list* hlArc,
     std::vector<blob>* pacs = nullptr, bool readSplits = true,
-    std::vector<std::string>* parentPaths = nullptr);
+    std::vector<std::string>* parentPaths = nullptr,
+    thread_pool* pool = nullptr);
 
 HL_API void load(const nchar* filePath,
     std::vector<std::string>* parentPaths,
     archive_entry_list* hlArc, std::vector<blob>* pacs = nullptr,
-    bool readSplits = true);
+    bool readSplits = true, thread_pool* pool = nullptr);
 
 inline void load(const nstring& filePath,
     std::vector<std::string>* parentPaths,
     archive_entry_list* hlArc, std::vector<blob>* pacs = nullptr,
-    bool readSplits = true)
+    bool readSplits = true, thread_pool* pool = nullptr)
 {
-    load(filePath.c_str(), parentPaths, hlArc, pacs, readSplits);
+    load(filePath.c_str(), parentPaths, hlArc, pacs, readSplits, pool);
 }
 
 HL_API void load(const nchar* filePath,
     archive_entry_list* hlArc, std::vector<blob>* pacs = nullptr,
-    bool readSplits = true);
+    bool readSplits = true, thread_pool* pool = nullptr);
 
 inline void load(const nstring& filePath,
     archive_entry_list* hlArc, std::vector<blob>* pacs = nullptr,
-    bool readSplits = true)
+    bool readSplits = true, thread_pool* pool = nullptr)
 {
-    load(filePath.c_str(), hlArc, pacs, readSplits);
+    load(filePath.c_str(), hlArc, pacs, readSplits, pool);
 }
 
 inline archive load(const nchar* filePath,
     std::vector<std::string>* parentPaths,
-    bool readSplits = true)
+    bool readSplits = true, thread_pool* pool = nullptr)
 {
     archive hlArc;
-    load(filePath, parentPaths, &hlArc, nullptr, readSplits);
+    load(filePath, parentPaths, &hlArc, nullptr, readSplits, pool);
     return hlArc;
 }
 
 inline archive load(const nstring& filePath,
     std::vector<std::string>* parentPaths,
-    bool readSplits = true)
+    bool readSplits = true, thread_pool* pool = nullptr)
 {
-    return load(filePath.c_str(), parentPaths, readSplits);
+    return load(filePath.c_str(), parentPaths, readSplits, pool);
 }
 
 inline archive load(const nchar* filePath,
-    bool readSplits = true)
+    bool readSplits = true, thread_pool* pool = nullptr)
 {
     archive hlArc;
-    load(filePath, &hlArc, nullptr, readSplits);
+    load(filePath, &hlArc, nullptr, readSplits, pool);
     return hlArc;
 }
 
 inline archive load(const nstring& filePath,
-    bool readSplits = true)
+    bool readSplits = true, thread_pool* pool = nullptr)
 {
     archive hlArc;
-    load(filePath, &hlArc, nullptr, readSplits);
+    load(filePath, &hlArc, nullptr, readSplits, pool);
     return hlArc;
 }
 } // v4
@@ -1820,24 +1983,41 @@ inline nstring get_root_path(const nstring& filePath)
 }
 
 HL_API void load(const nchar* filePath, archive_entry_list* hlArc,
-    std::vector<blob>* pacs = nullptr);
+    std::vector<blob>* pacs = nullptr, thread_pool* pool = nullptr);
 
 inline void load(const nstring& filePath, archive_entry_list* hlArc,
-    std::vector<blob>* pacs = nullptr)
+    std::vector<blob>* pacs = nullptr, thread_pool* pool = nullptr)
 {
-    load(filePath.c_str(), hlArc, pacs);
+    load(filePath.c_str(), hlArc, pacs, pool);
 }
 
-inline archive load(const nchar* filePath)
+inline archive load(const nchar* filePath, thread_pool* pool = nullptr)
 {
     archive hlArc;
-    load(filePath, &hlArc);
+    load(filePath, &hlArc, nullptr, pool);
     return hlArc;
 }
 
-inline archive load(const nstring& filePath)
+inline archive load(const nstring& filePath, thread_pool* pool = nullptr)
 {
-    return load(filePath.c_str());
+    return load(filePath.c_str(), pool);
+}
+
+/**
+    @brief Memory-maps the given pac and all of its dependencies, and parses
+    them without copying their files' data where possible; the resulting
+    archive entries may point directly into the mappings, which are added
+    to pacs, and so remain valid only for as long as pacs is kept around.
+
+    NOTE: PACxV4 data is compressed, so PACxV4 pacs are just loaded normally.
+*/
+HL_API void load_mapped(const nchar* filePath, archive_entry_list& hlArc,
+    std::vector<mapped_file>& pacs, thread_pool* pool = nullptr);
+
+inline void load_mapped(const nstring& filePath, archive_entry_list& hlArc,
+    std::vector<mapped_file>& pacs, thread_pool* pool = nullptr)
+{
+    load_mapped(filePath.c_str(), hlArc, pacs, pool);
 }
 } // pacx
 } // hl
@@ -4,10 +4,18 @@
 #include "../sets/hl_hson.h"
 #include "../csl/hl_csl_move_array.h"
 #include "../io/hl_bina.h"
+#include <exception>
+#include <vector>
 
 namespace hl
 {
 class set_object_type_database;
+class thread_pool;
+
+namespace reflect
+{
+class struct_definition;
+} // reflect
 
 namespace hh
 {
@@ -331,6 +339,7 @@ HL_STATIC_ASSERT_SIZE(raw_world, 0x30);
 namespace v3
 {
 struct raw_world;
+class raw_world_index;
 
 struct alignas(8) raw_object_id : public guid
 {
@@ -392,6 +401,9 @@ struct raw_object
 
     HL_API matrix4x4A get_global_transform_matrix(const raw_world& world) const;
 
+    HL_API matrix4x4A get_global_transform_matrix(
+        const raw_world_index& worldIndex) const;
+
     HL_API void add_to_hson(ordered_map<guid, hson::object>& hsonObjects,
         const set_object_type_database* objTypeDB = nullptr,
         bool tailEndAlignParentStructs = true) const;
@@ -450,29 +462,198 @@ struct raw_world
 
 HL_STATIC_ASSERT_SIZE(raw_world, 0x30);
 
+/**
+    @brief A GUID-hashed index over the objects within a fixed raw_world,
+    which allows objects to be looked up without scanning the entire world.
+
+    NOTE: The index only refers to the objects within the world, so the
+    world must outlive the index, and its objects must not be added,
+    removed, or have their IDs changed while the index is in use.
+*/
+class raw_world_index
+{
+    const raw_world* m_world;
+    robin_hood::unordered_flat_map<guid, std::size_t> m_objIndices;
+
+public:
+    /** @brief Returned by index_of when the given object could not be found. */
+    static constexpr std::size_t npos = SIZE_MAX;
+
+    inline const raw_world& world() const noexcept
+    {
+        return *m_world;
+    }
+
+    /**
+        @brief Returns the index of the object with the given ID within the
+        world's objects array, or npos if no such object exists.
+
+        If multiple objects share the same ID, the first one is returned
+        (just like raw_world::get_object).
+    */
+    HL_API std::size_t index_of(const raw_object_id& id) const noexcept;
+
+    HL_API const raw_object* get_object(const raw_object_id& id) const noexcept;
+
+    /**
+        @brief Computes the global transform matrix of every object within
+        the world in a single pass, such that each object's parent chain is
+        only ever resolved once.
+
+        @param matrices The vector to store the matrices in. It will be resized
+        to match the world's objects array, with each matrix stored at the same
+        index as its object. Null objects are given an identity matrix.
+        Objects whose parent chain loops back on itself are treated as though
+        they have no parent where the loop would begin.
+    */
+    HL_API void get_global_transform_matrices(
+        std::vector<matrix4x4A>& matrices) const;
+
+    HL_API raw_world_index(const raw_world& world);
+};
+
+/**
+    @brief Keeps the encoded parameter data of every object written by a
+    previous call to write or save, so that later calls can re-use the data
+    of any objects whose parameters haven't changed since then rather than
+    encoding them all over again.
+
+    Objects are matched up by ID, and their types and flattened parameters
+    are fingerprinted to quickly tell whether they've changed. Since different
+    parameters can share the same fingerprint, the cache also keeps a copy of
+    every object's flattened parameters, which are compared against the
+    current ones whenever the fingerprints match. The cache is cleared
+    automatically whenever it's used with a different type database,
+    endianness, or tailEndAlignParentStructs value than last time; if the
+    type database itself is modified, however, clear must be called manually.
+*/
+class write_cache
+{
+    friend class in_world_writer;
+
+    struct in_block
+    {
+        /** @brief The encoded parameter data, as if written at position 0. */
+        std::vector<u8> data;
+        /** @brief The (position, target) pairs of every offset within the data. */
+        std::vector<std::pair<std::size_t, std::size_t>> offsets;
+        /** @brief The strings referenced by the data (with relative offset positions). */
+        str_table strings;
+        /** @brief The largest alignment the data's padding depends on. */
+        std::size_t alignment = 1;
+    };
+
+    struct in_entry
+    {
+        u64 fingerprint = 0;
+        /** @brief The struct type the parameters were encoded as. */
+        const reflect::struct_definition* structDef = nullptr;
+        /** @brief The flattened parameters the data was encoded from. */
+        radix_tree<hson::parameter> parameters;
+        in_block block;
+    };
+
+    robin_hood::unordered_node_map<guid, in_entry> m_entries;
+    const set_object_type_database* m_objTypeDB = nullptr;
+    bina::endian_flag m_endianFlag = bina::endian_flag::little;
+    bool m_tailEndAlignParentStructs = true;
+
+public:
+    /** @brief Returns the number of objects whose data is currently cached. */
+    inline std::size_t size() const noexcept
+    {
+        return m_entries.size();
+    }
+
+    inline void clear() noexcept
+    {
+        m_entries.clear();
+        m_objTypeDB = nullptr;
+    }
+};
+
+/**
+    @brief Writes the given project's objects as a gedit data block.
+
+    @param cache If not null, any objects whose data is in this cache and
+    haven't changed since it was cached will re-use that data rather than be
+    encoded again, and the cache will be updated to match what was written.
+    @param pool If not null, the parameters of every object will be encoded
+    in parallel on this pool before being written out.
+
+    The resulting data is identical whether or not a cache or pool is used.
+*/
 HL_API void write(const hson::project& project,
     const set_object_type_database& objTypeDB,
     bina::v2::writer64& writer,
-    bool tailEndAlignParentStructs = true);
+    bool tailEndAlignParentStructs = true,
+    write_cache* cache = nullptr,
+    thread_pool* pool = nullptr);
 
 HL_API void save(const hson::project& project,
     const set_object_type_database& objTypeDB,
     bina::endian_flag endianFlag, stream& stream,
-    bool tailEndAlignParentStructs = true);
+    bool tailEndAlignParentStructs = true,
+    write_cache* cache = nullptr,
+    thread_pool* pool = nullptr);
 
 HL_API void save(const hson::project& project,
     const set_object_type_database& objTypeDB,
     bina::endian_flag endianFlag, const nchar* filePath,
-    bool tailEndAlignParentStructs = true);
+    bool tailEndAlignParentStructs = true,
+    write_cache* cache = nullptr,
+    thread_pool* pool = nullptr);
 
 inline void save(const hson::project& project,
     const set_object_type_database& objTypeDB,
     bina::endian_flag endianFlag, const nstring& filePath,
-    bool tailEndAlignParentStructs = true)
+    bool tailEndAlignParentStructs = true,
+    write_cache* cache = nullptr,
+    thread_pool* pool = nullptr)
 {
-    save(project, objTypeDB, endianFlag,
-        filePath.c_str(), tailEndAlignParentStructs);
+    save(project, objTypeDB, endianFlag, filePath.c_str(),
+        tailEndAlignParentStructs, cache, pool);
 }
+
+/**
+    @brief Loads the given gedit file and saves its objects as a HSON file.
+
+    @param inputFilePath The path to the gedit file to convert.
+    @param outputFilePath The path to save the resulting HSON file to.
+    @param objTypeDB The database used to convert each object's parameters.
+    Objects whose types aren't in this database are skipped.
+*/
+HL_API void convert_to_hson(const nchar* inputFilePath,
+    const nchar* outputFilePath,
+    const set_object_type_database& objTypeDB,
+    bool tailEndAlignParentStructs = true);
+
+/**
+    @brief Converts a batch of gedit files into HSON files, spreading the
+    files across the given thread pool.
+
+    The type database is only ever read from, so a single database is shared
+    by every file. Each file is converted into its own HSON project, so the
+    resulting files are identical regardless of how many threads are used.
+
+    @param inputFilePaths The paths to the gedit files to convert.
+    @param outputFilePaths The paths to save the resulting HSON files to.
+    Must be the same size as inputFilePaths.
+    @param objTypeDB The database used to convert each object's parameters.
+    @param errors If not null, this will be resized to match inputFilePaths,
+    and any exception thrown while converting each file will be stored at
+    the same index (or null if the file was converted successfully).
+    If null, once every file has been attempted, the exception thrown by the
+    lowest-indexed file which failed will be re-thrown.
+    @param pool The pool to convert the files on. If null, the files
+    will simply be converted one after another on the calling thread.
+*/
+HL_API void convert_to_hson(const std::vector<nstring>& inputFilePaths,
+    const std::vector<nstring>& outputFilePaths,
+    const set_object_type_database& objTypeDB,
+    bool tailEndAlignParentStructs = true,
+    std::vector<std::exception_ptr>* errors = nullptr,
+    thread_pool* pool = nullptr);
 } // v3
 } // gedit
 } // hh
@@ -140,6 +140,13 @@ public:
     bool try_load(hl::stream* stream);
 
     const raw_package_entry* get_entry(const char* str) const;
+
+    /**
+        @brief Loads the given blob's data from the package's stream.
+
+        Safe to call from multiple threads at once, so long as the package's
+        stream supports concurrent positional reads (e.g. hl::file_stream).
+    */
     hl::blob load_blob(u32 index) const;
 };
 
@@ -1,9 +1,12 @@
 #ifndef HL_COMPRESSION_H_INCLUDED
 #define HL_COMPRESSION_H_INCLUDED
 #include "hl_blob.h"
+#include <vector>
 
 namespace hl
 {
+class thread_pool;
+
 enum class compress_type
 {
     /** @brief No compression. */
@@ -20,9 +23,154 @@ enum class compress_type
     deflate
 };
 
+/**
+    @brief Tells the compression functions to use the given
+    compression type's own default compression level.
+*/
+constexpr int compress_level_default = -1;
+
+/**
+    @brief The lowest LZ4 compression level which uses LZ4 HC.
+
+    LZ4 HC is much slower to compress (but no slower to decompress) than
+    regular LZ4, so it's generally only worth using for offline builds.
+    Any LZ4 level below this uses regular LZ4 compression.
+*/
+constexpr int lz4_hc_level_min = 3;
+
+/** @brief The highest (slowest, but smallest) LZ4 HC compression level. */
+constexpr int lz4_hc_level_max = 12;
+
+/** @brief The highest (slowest, but smallest) deflate compression level. */
+constexpr int deflate_level_max = 9;
+
+/**
+    @brief The block size used by the block compression functions
+    when the caller doesn't have a specific block size in mind.
+*/
+constexpr std::size_t compress_default_block_size = 131072;
+
+/**
+    @brief A reusable zlib inflate stream, which avoids the cost of setting
+    up (and tearing down) zlib's state every time a buffer is decompressed.
+
+    A single context must not be used by multiple threads at once; use
+    get_thread_local to get a context which is private to the calling thread.
+*/
+class deflate_decompress_context
+{
+    void* m_stream = nullptr;
+
+    HL_API void in_close() noexcept;
+
+public:
+    HL_API void decompress_no_alloc(std::size_t srcSize,
+        const void* src, std::size_t dstSize, void* dst);
+
+    /**
+        @brief Returns a context which is lazily created the first time it's
+        requested on the calling thread, and destroyed when the thread exits.
+    */
+    HL_API static deflate_decompress_context& get_thread_local();
+
+    HL_API deflate_decompress_context& operator=(
+        deflate_decompress_context&& other) noexcept;
+
+    deflate_decompress_context() noexcept = default;
+
+    deflate_decompress_context(const deflate_decompress_context& other) = delete;
+    deflate_decompress_context& operator=(const deflate_decompress_context& other) = delete;
+
+    HL_API deflate_decompress_context(deflate_decompress_context&& other) noexcept;
+
+    inline ~deflate_decompress_context()
+    {
+        in_close();
+    }
+};
+
+/**
+    @brief A reusable zlib deflate stream, which avoids the cost of setting
+    up (and tearing down) zlib's state every time a buffer is compressed.
+
+    A single context must not be used by multiple threads at once; use
+    get_thread_local to get a context which is private to the calling thread.
+*/
+class deflate_compress_context
+{
+    void* m_stream = nullptr;
+    int m_level = compress_level_default;
+
+    HL_API void in_close() noexcept;
+
+public:
+    /**
+        @brief Compresses the given data as a raw deflate stream.
+
+        @param finish If false, the stream is ended with a full flush
+        rather than being finished, so that another raw deflate stream
+        can be directly appended to it (see deflate_compress_blocks_no_alloc).
+
+        @return The compressed size of the data.
+    */
+    HL_API std::size_t compress_no_alloc(std::size_t srcSize,
+        const void* src, std::size_t dstBufSize, void* dst,
+        int level = compress_level_default, bool finish = true);
+
+    /**
+        @brief Returns a context which is lazily created the first time it's
+        requested on the calling thread, and destroyed when the thread exits.
+    */
+    HL_API static deflate_compress_context& get_thread_local();
+
+    HL_API deflate_compress_context& operator=(
+        deflate_compress_context&& other) noexcept;
+
+    deflate_compress_context() noexcept = default;
+
+    deflate_compress_context(const deflate_compress_context& other) = delete;
+    deflate_compress_context& operator=(const deflate_compress_context& other) = delete;
+
+    HL_API deflate_compress_context(deflate_compress_context&& other) noexcept;
+
+    inline ~deflate_compress_context()
+    {
+        in_close();
+    }
+};
+
+/**
+    @brief Reusable LZ4 (and LZ4 HC) compression state, which avoids having
+    to allocate (or zero out a large stack buffer for) the state every time
+    a buffer is compressed.
+
+    A single context must not be used by multiple threads at once; use
+    get_thread_local to get a context which is private to the calling thread.
+*/
+class lz4_compress_context
+{
+    std::unique_ptr<u8[]> m_state;
+    std::unique_ptr<u8[]> m_stateHC;
+
+public:
+    HL_API std::size_t compress_no_alloc(std::size_t srcSize,
+        const void* src, std::size_t dstBufSize, void* dst,
+        int level = compress_level_default);
+
+    /**
+        @brief Returns a context which is lazily created the first time it's
+        requested on the calling thread, and destroyed when the thread exits.
+    */
+    HL_API static lz4_compress_context& get_thread_local();
+};
+
 HL_API void lz4_decompress_no_alloc(std::size_t srcSize,
     const void* src, std::size_t dstSize, void* dst);
 
+/**
+    @brief Decompresses the given raw deflate data, using the
+    calling thread's deflate_decompress_context.
+*/
 HL_API void deflate_decompress_no_alloc(std::size_t srcSize, 
     const void* src, std::size_t dstSize, void* dst);
 
@@ -42,20 +190,119 @@ HL_API std::size_t deflate_compress_bound(std::size_t uncompressedSize) noexcept
 HL_API std::size_t compress_bound(compress_type type,
     std::size_t uncompressedSize) noexcept;
 
+/**
+    @brief Compresses the given data as LZ4, using
+    the calling thread's lz4_compress_context.
+*/
 HL_API std::size_t lz4_compress_no_alloc(std::size_t srcSize,
-    const void* src, std::size_t dstBufSize, void* dst);
+    const void* src, std::size_t dstBufSize, void* dst,
+    int level = compress_level_default);
 
+/**
+    @brief Compresses the given data as raw deflate, using
+    the calling thread's deflate_compress_context.
+*/
 HL_API std::size_t deflate_compress_no_alloc(std::size_t srcSize,
-    const void* src, std::size_t dstBufSize, void* dst);
+    const void* src, std::size_t dstBufSize, void* dst,
+    int level = compress_level_default);
 
 HL_API std::size_t compress_no_alloc(compress_type type,
     std::size_t srcSize, const void* src,
-    std::size_t dstBufSize, void* dst);
+    std::size_t dstBufSize, void* dst,
+    int level = compress_level_default);
 
 HL_API std::unique_ptr<u8[]> compress(compress_type type,
-    std::size_t srcSize, const void* src, std::size_t& dstSize);
+    std::size_t srcSize, const void* src, std::size_t& dstSize,
+    int level = compress_level_default);
 
 HL_API blob compress_blob(compress_type type,
-    std::size_t srcSize, const void* src);
+    std::size_t srcSize, const void* src,
+    int level = compress_level_default);
+
+/**
+    @brief Returns the number of blocks the given amount of data
+    would be split into by the block compression functions.
+*/
+HL_API std::size_t compress_block_count(compress_type type,
+    std::size_t srcSize, std::size_t blockSize) noexcept;
+
+/**
+    @brief Returns the worst-case size of the data written by the
+    block compression functions for the given uncompressed size.
+*/
+HL_API std::size_t compress_blocks_bound(compress_type type,
+    std::size_t srcSize, std::size_t blockSize) noexcept;
+
+/**
+    @brief Splits the given data into independent LZ4 blocks of (at most)
+    blockSize bytes each, compresses them, and writes them back-to-back.
+
+    This matches the semantics of PACxV4 LZ4 chunks; each block can be
+    decompressed on its own with lz4_decompress_no_alloc.
+
+    @param srcSize The size of the data to compress.
+    @param src The data to compress.
+    @param blockSize The maximum uncompressed size of each block.
+    If 0, all of the data is compressed as a single block.
+    @param dstBufSize The size of dst. Ideally at least compress_blocks_bound.
+    @param dst The buffer to write the compressed blocks to.
+    @param blockSizes If not null, the compressed size of each
+    block will be appended to this vector.
+    @param level The LZ4 compression level to use.
+    @param pool If not null, the blocks will be compressed
+    in parallel using the threads from this pool.
+
+    @return The total compressed size of all of the blocks.
+*/
+HL_API std::size_t lz4_compress_blocks_no_alloc(std::size_t srcSize,
+    const void* src, std::size_t blockSize, std::size_t dstBufSize,
+    void* dst, std::vector<std::size_t>* blockSizes = nullptr,
+    int level = compress_level_default, thread_pool* pool = nullptr);
+
+/**
+    @brief Splits the given data into blocks of (at most) blockSize bytes
+    each, compresses each block as its own raw deflate stream, and writes
+    them back-to-back.
+
+    Every block except the last is ended with a full flush rather than
+    being finished, so the result is a single valid deflate stream which
+    can be decompressed with deflate_decompress_no_alloc (the same approach
+    pigz uses). Blocks don't share history, so the output is slightly
+    larger than (and never byte-identical to) that of deflate_compress_no_alloc,
+    but it's the same whether or not a thread pool is given.
+
+    @param srcSize The size of the data to compress.
+    @param src The data to compress.
+    @param blockSize The maximum uncompressed size of each block.
+    If 0, all of the data is compressed as a single block.
+    @param dstBufSize The size of dst. Ideally at least compress_blocks_bound.
+    @param dst The buffer to write the compressed blocks to.
+    @param blockSizes If not null, the compressed size of each
+    block will be appended to this vector.
+    @param level The deflate compression level to use.
+    @param pool If not null, the blocks will be compressed
+    in parallel using the threads from this pool.
+
+    @return The total compressed size of all of the blocks.
+*/
+HL_API std::size_t deflate_compress_blocks_no_alloc(std::size_t srcSize,
+    const void* src, std::size_t blockSize, std::size_t dstBufSize,
+    void* dst, std::vector<std::size_t>* blockSizes = nullptr,
+    int level = compress_level_default, thread_pool* pool = nullptr);
+
+HL_API std::size_t compress_blocks_no_alloc(compress_type type,
+    std::size_t srcSize, const void* src, std::size_t blockSize,
+    std::size_t dstBufSize, void* dst,
+    std::vector<std::size_t>* blockSizes = nullptr,
+    int level = compress_level_default, thread_pool* pool = nullptr);
+
+HL_API std::unique_ptr<u8[]> compress_blocks(compress_type type,
+    std::size_t srcSize, const void* src, std::size_t blockSize,
+    std::size_t& dstSize, int level = compress_level_default,
+    thread_pool* pool = nullptr);
+
+HL_API blob compress_blocks_blob(compress_type type,
+    std::size_t srcSize, const void* src, std::size_t blockSize,
+    int level = compress_level_default, thread_pool* pool = nullptr);
 } // hl
 #endif
@@ -431,6 +431,52 @@ inline std::enable_if_t<!std::is_enum_v<T>>
     v.template endian_swap<swapOffsets>();
 }
 
+/* Bulk endian swapping */
+/**
+    @brief Endian-swaps every value within the given contiguous array in-place.
+
+    Uses SSSE3/AVX2 byte shuffles when available (and not disabled via
+    HL_DISABLE_INTRINSICS), falling back to scalar swaps otherwise.
+    The array does not need to be aligned.
+
+    @param[in] count    The number of values within the array.
+    @param[in,out] arr  The array of values to endian-swap.
+*/
+HL_API void endian_swap_arr(std::size_t count, u16* arr) noexcept;
+HL_API void endian_swap_arr(std::size_t count, u32* arr) noexcept;
+HL_API void endian_swap_arr(std::size_t count, u64* arr) noexcept;
+
+inline void endian_swap_arr(std::size_t count, u8* arr) noexcept {}
+
+inline void endian_swap_arr(std::size_t count, s8* arr) noexcept {}
+
+inline void endian_swap_arr(std::size_t count, s16* arr) noexcept
+{
+    endian_swap_arr(count, reinterpret_cast<u16*>(arr));
+}
+
+inline void endian_swap_arr(std::size_t count, s32* arr) noexcept
+{
+    endian_swap_arr(count, reinterpret_cast<u32*>(arr));
+}
+
+inline void endian_swap_arr(std::size_t count, s64* arr) noexcept
+{
+    endian_swap_arr(count, reinterpret_cast<u64*>(arr));
+}
+
+inline void endian_swap_arr(std::size_t count, float* arr) noexcept
+{
+    HL_STATIC_ASSERT_SIZE(float, sizeof(u32));
+    endian_swap_arr(count, reinterpret_cast<u32*>(arr));
+}
+
+inline void endian_swap_arr(std::size_t count, double* arr) noexcept
+{
+    HL_STATIC_ASSERT_SIZE(double, sizeof(u64));
+    endian_swap_arr(count, reinterpret_cast<u64*>(arr));
+}
+
 /* Offsets */
 template<typename T>
 class off32
@@ -2,6 +2,7 @@
 #define HL_MEMORY_H_INCLUDED
 #include "hl_internal.h"
 #include <new>
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <utility>
@@ -1314,5 +1315,164 @@ public:
         in_destroy();
     }
 };
+
+/**
+ * @brief A monotonic ("bump") allocator which hands out memory from large
+ * blocks, and which only ever frees that memory all at once (either via
+ * release() or when the arena itself is destructed).
+ *
+ * This makes allocating lots of small, similarly-lived objects (e.g. the
+ * names and data of every entry within an archive) very cheap.
+ *
+ * NOTE: The arena never calls destructors for anything allocated from it,
+ * and is not thread-safe.
+ */
+class arena
+{
+    struct in_block_header
+    {
+        in_block_header* prev;
+        std::size_t size;
+    };
+
+    static constexpr std::size_t in_block_header_size = (
+        (sizeof(in_block_header) + (alignof(std::max_align_t) - 1)) &
+        ~(alignof(std::max_align_t) - 1));
+
+    in_block_header* m_curBlock = nullptr;
+    u8* m_curPtr = nullptr;
+    u8* m_curEnd = nullptr;
+    std::size_t m_blockSize;
+
+    [[nodiscard]] in_block_header* in_alloc_block(std::size_t dataSize)
+    {
+        const auto block = static_cast<in_block_header*>(
+            hl::allocate(in_block_header_size + dataSize));
+
+        block->size = dataSize;
+        return block;
+    }
+
+    [[nodiscard]] void* in_allocate_slow(std::size_t size, std::size_t alignment)
+    {
+        // Give large allocations their own block, and place it behind the
+        // current block so the rest of the current block can still be used.
+        const std::size_t paddedSize = (size + alignment);
+        if (m_curBlock && paddedSize > (m_blockSize / 4))
+        {
+            in_block_header* block = in_alloc_block(paddedSize);
+            block->prev = m_curBlock->prev;
+            m_curBlock->prev = block;
+
+            const auto data = (reinterpret_cast<std::uintptr_t>(block) +
+                in_block_header_size + (alignment - 1)) & ~(alignment - 1);
+
+            return reinterpret_cast<void*>(data);
+        }
+
+        // Otherwise, start a new block and allocate from it.
+        in_block_header* block = in_alloc_block(
+            std::max<std::size_t>(m_blockSize, paddedSize));
+
+        block->prev = m_curBlock;
+        m_curBlock = block;
+        m_curPtr = (reinterpret_cast<u8*>(block) + in_block_header_size);
+        m_curEnd = (m_curPtr + block->size);
+
+        return allocate(size, alignment);
+    }
+
+public:
+    constexpr static std::size_t default_block_size = 65536;
+
+    inline std::size_t block_size() const noexcept
+    {
+        return m_blockSize;
+    }
+
+    /**
+     * @brief Allocates uninitialized memory from the arena.
+     *
+     * @param size The amount of bytes to allocate.
+     * @param alignment The alignment of the memory. Must be a power of two.
+     * @return A pointer to the allocated memory. This memory remains valid
+     * until release() is called, or until the arena is destructed.
+     */
+    [[nodiscard]] void* allocate(std::size_t size,
+        std::size_t alignment = alignof(std::max_align_t))
+    {
+        // Bump-allocate from the current block if there's enough room left.
+        if (m_curPtr)
+        {
+            const auto curAddr = reinterpret_cast<std::uintptr_t>(m_curPtr);
+            const auto endAddr = reinterpret_cast<std::uintptr_t>(m_curEnd);
+            const auto alignedAddr = ((curAddr + (alignment - 1)) & ~(alignment - 1));
+
+            if (alignedAddr <= endAddr && size <= (endAddr - alignedAddr))
+            {
+                m_curPtr = reinterpret_cast<u8*>(alignedAddr + size);
+                return reinterpret_cast<void*>(alignedAddr);
+            }
+        }
+
+        // Otherwise, allocate a new block.
+        return in_allocate_slow(size, alignment);
+    }
+
+    template<typename T>
+    [[nodiscard]] inline T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * @brief Frees all of the memory which was allocated from this arena.
+     */
+    void release() noexcept
+    {
+        while (m_curBlock)
+        {
+            in_block_header* prevBlock = m_curBlock->prev;
+            hl::free(m_curBlock);
+            m_curBlock = prevBlock;
+        }
+
+        m_curPtr = nullptr;
+        m_curEnd = nullptr;
+    }
+
+    arena& operator=(const arena& other) = delete;
+
+    arena& operator=(arena&& other) noexcept
+    {
+        if (&other != this)
+        {
+            release();
+
+            m_curBlock = std::exchange(other.m_curBlock, nullptr);
+            m_curPtr = std::exchange(other.m_curPtr, nullptr);
+            m_curEnd = std::exchange(other.m_curEnd, nullptr);
+            m_blockSize = other.m_blockSize;
+        }
+
+        return *this;
+    }
+
+    explicit arena(std::size_t blockSize = default_block_size) noexcept :
+        m_blockSize(blockSize) {}
+
+    arena(const arena& other) = delete;
+
+    arena(arena&& other) noexcept :
+        m_curBlock(std::exchange(other.m_curBlock, nullptr)),
+        m_curPtr(std::exchange(other.m_curPtr, nullptr)),
+        m_curEnd(std::exchange(other.m_curEnd, nullptr)),
+        m_blockSize(other.m_blockSize) {}
+
+    inline ~arena()
+    {
+        release();
+    }
+};
 } // hl
 #endif
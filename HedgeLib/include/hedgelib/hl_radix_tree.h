@@ -5,13 +5,24 @@
 #define HL_RADIX_TREE_H_INCLUDED
 #include "hl_internal.h"
 #include <string>
+#include <cstring>
 #include <algorithm>
 #include <utility>
 #include <vector>
 #include <array>
+#include <cassert>
 
 namespace hl
 {
+class arena;
+
+struct sorted_keys_t final
+{
+    constexpr explicit sorted_keys_t() noexcept = default;
+};
+
+[[maybe_unused]] constexpr sorted_keys_t sorted_keys;
+
 namespace internal
 {
 enum class in_radix_node_type : u8
@@ -31,6 +42,8 @@ HL_ENUM_CLASS_DEF_BITWISE_OPS(in_radix_node_type)
 
 constexpr u8 in_radix_max_prefix_len = 10;
 
+struct in_radix_pool;
+
 struct in_radix_node
 {
     u8 flags;
@@ -59,8 +72,6 @@ struct in_radix_node
 
     HL_API void* get_child_ptr(u8 key) const;
 
-    HL_API void destroy() noexcept;
-
     HL_API in_radix_node(in_radix_node_type type) noexcept;
 
     HL_API in_radix_node(in_radix_node_type newType, const in_radix_node& other) noexcept;
@@ -68,6 +79,8 @@ struct in_radix_node
 
 struct in_radix_node4 : public in_radix_node
 {
+    constexpr static in_radix_node_type node_type = in_radix_node_type::node4;
+
     std::array<u8, 4> keys;
     std::array<void*, 4> children;
 
@@ -82,6 +95,8 @@ struct in_radix_node4 : public in_radix_node
 
 struct in_radix_node16 : public in_radix_node
 {
+    constexpr static in_radix_node_type node_type = in_radix_node_type::node16;
+
     alignas(16) std::array<u8, 16> keys;
     std::array<void*, 16> children;
 
@@ -98,6 +113,8 @@ struct in_radix_node16 : public in_radix_node
 
 struct in_radix_node48 : public in_radix_node
 {
+    constexpr static in_radix_node_type node_type = in_radix_node_type::node48;
+
     std::array<u8, 256> childIndices;
     std::array<void*, 48> children;
 
@@ -116,6 +133,8 @@ struct in_radix_node48 : public in_radix_node
 
 struct in_radix_node256 : public in_radix_node
 {
+    constexpr static in_radix_node_type node_type = in_radix_node_type::node256;
+
     std::array<void*, 256> children;
 
     HL_API in_radix_node256() noexcept;
@@ -145,8 +164,8 @@ struct in_radix_leaf
             alignof(char)) - __STDCPP_DEFAULT_NEW_ALIGNMENT__);
     }
 
-    HL_API static in_radix_leaf* create(std::size_t size,
-        std::size_t index, const char* key);
+    HL_API static in_radix_leaf* create(in_radix_pool& pool,
+        std::size_t size, std::size_t index, const char* key);
 };
 
 using in_radix_sort_func = int (*)(unsigned char a, unsigned char b);
@@ -157,6 +176,8 @@ protected:
     void* m_rootNode = nullptr;
     in_radix_sort_func m_sortFuncPtr;
     std::vector<in_radix_leaf*> m_leafNodes;
+    arena* m_arena = nullptr;
+    in_radix_pool* m_pool = nullptr;
 
     using in_const_iterator = std::vector<in_radix_leaf*>::const_iterator;
     using in_iterator = std::vector<in_radix_leaf*>::iterator;
@@ -171,6 +192,8 @@ protected:
         return (m_leafNodes.begin() + index);
     }
 
+    HL_API in_radix_pool& in_get_pool();
+
     HL_API in_iterator in_add_leaf(in_radix_leaf& leaf);
 
     HL_API std::pair<in_iterator, bool> in_insert(
@@ -186,6 +209,9 @@ protected:
             this)->in_find_leaf(key, leafSize));
     }
 
+    HL_API bool in_build_sorted(const char* const* keys,
+        std::size_t keyCount, std::size_t leafSize);
+
     HL_API void in_destroy() noexcept;
 
     in_radix_tree& operator=(const in_radix_tree& other) = delete;
@@ -197,6 +223,8 @@ protected:
     in_radix_tree(in_radix_sort_func sortFuncPtr) noexcept :
         m_sortFuncPtr(sortFuncPtr) {}
 
+    HL_API in_radix_tree(arena* arena) noexcept;
+
     HL_API in_radix_tree(in_radix_tree&& other) noexcept;
 
     inline ~in_radix_tree()
@@ -247,6 +275,69 @@ protected:
         }
     }
 
+    inline static const char* in_get_c_str(const char* str) noexcept
+    {
+        return str;
+    }
+
+    inline static const char* in_get_c_str(const std::string& str) noexcept
+    {
+        return str.c_str();
+    }
+
+    template<typename ForwardIt>
+    void in_assign_sorted(ForwardIt first, ForwardIt last)
+    {
+        // Gather keys, skipping over any duplicates just like insert() would.
+        std::vector<const char*> keys;
+        std::vector<ForwardIt> its;
+
+        for (; first != last; ++first)
+        {
+            const auto key = in_get_c_str((*first).first);
+            if (!keys.empty() && std::strcmp(keys.back(), key) == 0)
+            {
+                continue;
+            }
+
+            keys.push_back(key);
+            its.push_back(first);
+        }
+
+        // Build the tree's nodes all at once, or just insert the
+        // elements one-by-one if the keys weren't actually sorted.
+        if (!in_build_sorted(keys.data(), keys.size(), leaf_size()))
+        {
+            reserve(its.size());
+            for (std::size_t i = 0; i < its.size(); ++i)
+            {
+                insert(keys[i], (*its[i]).second);
+            }
+
+            return;
+        }
+
+        // Construct the data within the new leaf nodes.
+        std::size_t i = 0;
+        try
+        {
+            for (; i < its.size(); ++i)
+            {
+                new (in_get_data_ptr(*m_leafNodes[i])) T((*its[i]).second);
+            }
+        }
+        catch (...)
+        {
+            while (i > 0)
+            {
+                in_get_data_ptr(*m_leafNodes[--i])->~T();
+            }
+
+            m_leafNodes.clear();
+            throw;
+        }
+    }
+
     template<typename U = T>
     std::enable_if_t<!std::is_trivially_destructible_v<U>>
         in_destroy_data() noexcept
@@ -352,6 +443,32 @@ public:
         }
     };
 
+    /**
+        @brief Returns the arena this tree's nodes are allocated from, or
+        null if they're allocated from slabs of heap memory owned by the tree.
+    */
+    inline arena* get_arena() const noexcept
+    {
+        return m_arena;
+    }
+
+    /**
+        @brief Sets the arena this tree's nodes are allocated from.
+
+        NOTE: This may only be called while the tree has no nodes, as nodes
+        are only ever freed the same way they were allocated.
+
+        @param arena The arena to use, or null to allocate nodes from slabs
+        of heap memory owned by the tree. Trees whose nodes are allocated from
+        an arena must not outlive it!
+    */
+    inline void set_arena(arena* arena) noexcept
+    {
+        assert(!m_rootNode && "Cannot change the arena of a non-empty tree!");
+        in_destroy();
+        m_arena = arena;
+    }
+
     inline static constexpr std::size_t leaf_size() noexcept
     {
         return internal::in_radix_leaf::compute_size(sizeof(T), alignof(T));
@@ -552,7 +669,7 @@ public:
     void clear() noexcept
     {
         in_destroy_data();
-        m_rootNode = nullptr;
+        in_destroy();
         m_leafNodes.clear();
     }
 
@@ -608,6 +725,44 @@ public:
     radix_tree(internal::in_radix_sort_func sortFunc) noexcept :
         in_radix_tree(sortFunc) {}
 
+    /**
+        @brief Constructs an empty tree which allocates its nodes (including
+        the nodes which store its keys and values) from the given arena.
+
+        This lets many small trees share the arena's memory blocks rather than
+        each allocating slabs of their own, and means the tree's nodes aren't
+        freed at all until the arena is. The arena must outlive the tree
+        (including any trees it is moved into; copies always allocate their
+        nodes on the heap).
+    */
+    explicit radix_tree(arena& arena) noexcept :
+        in_radix_tree(&arena) {}
+
+    /**
+        @brief Constructs a tree from the given range of key/value pairs,
+        whose keys must already be sorted (e.g. by strcmp).
+
+        Rather than inserting each element one-by-one, this builds all of
+        the tree's nodes at once, which is much faster for large databases.
+        Elements are stored in the same order they're given in, and if there
+        are duplicate keys, only the first one is used (just like insert()).
+        If the keys turn out not to be sorted, the elements are just inserted
+        one-by-one instead.
+
+        @param first An iterator to the first pair. Each pair's first member
+        must be a key (either a const char* or std::string), and each pair's
+        second member is used to construct the corresponding value.
+        @param last An iterator past the last pair.
+        @param arena An optional arena to allocate the tree's nodes from.
+    */
+    template<typename ForwardIt>
+    radix_tree(sorted_keys_t, ForwardIt first, ForwardIt last,
+        arena* arena = nullptr) :
+        in_radix_tree(arena)
+    {
+        in_assign_sorted(first, last);
+    }
+
     radix_tree(const radix_tree& other) :
         in_radix_tree(other.m_sortFuncPtr)
     {
@@ -0,0 +1,92 @@
+#ifndef HL_THREAD_POOL_H_INCLUDED
+#define HL_THREAD_POOL_H_INCLUDED
+#include "hl_internal.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hl
+{
+/**
+    @brief A fixed-size pool of worker threads which can be used to
+    split independent pieces of work (e.g. compressed chunks) across cores.
+
+    The thread which calls parallel_for always participates in the work
+    itself, so it's safe to call parallel_for from within a job that is
+    already running on the pool.
+*/
+class thread_pool
+{
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_jobs;
+    std::mutex m_jobsMutex;
+    std::condition_variable m_jobsCondition;
+    bool m_isStopping = false;
+
+    void in_worker_main();
+    void in_stop() noexcept;
+    void in_push_jobs(std::size_t count, const std::function<void()>& job);
+
+public:
+    /**
+        @brief Returns the number of worker threads owned by this pool.
+
+        NOTE: This does not include the calling thread, which also
+        performs work during calls to parallel_for.
+    */
+    inline std::size_t thread_count() const noexcept
+    {
+        return m_workers.size();
+    }
+
+    /**
+        @brief Returns the maximum number of threads which can
+        be working on a single parallel_for call at once.
+    */
+    inline std::size_t concurrency() const noexcept
+    {
+        return (m_workers.size() + 1);
+    }
+
+    /**
+        @brief Calls func once for every index in the range [0, count),
+        distributing the calls across this pool's worker threads, and
+        blocks until every call has finished.
+
+        If any call throws, no further indices will be started, and the
+        first exception which was thrown is re-thrown on the calling thread.
+
+        @param count The number of indices to call func with.
+        @param func The function to call. Must be safe to call concurrently.
+    */
+    HL_API void parallel_for(std::size_t count,
+        const std::function<void(std::size_t)>& func);
+
+    /**
+        @brief Returns a process-wide thread pool which is lazily
+        created on first use, and sized to the host's hardware.
+    */
+    HL_API static thread_pool& get_default();
+
+    /**
+        @brief Creates a new thread pool with one less worker thread than
+        the number of hardware threads, as the thread calling parallel_for
+        always participates in the work.
+    */
+    HL_API thread_pool();
+
+    /**
+        @brief Creates a new thread pool.
+
+        @param threadCount The number of worker threads to create. If 0,
+        all work will simply be performed on the calling thread.
+    */
+    HL_API explicit thread_pool(std::size_t threadCount);
+
+    HL_API ~thread_pool();
+};
+} // hl
+#endif
@@ -190,6 +190,11 @@ public:
 
         HL_API u32 operator*() const;
 
+        inline const u8* ptr() const noexcept
+        {
+            return m_ptr;
+        }
+
         inline bool operator==(const iterator& other) const noexcept
         {
             return (m_ptr == other.m_ptr);
@@ -219,18 +224,45 @@ public:
     HL_API off_table_handle(const u8* offTable, u32 offTableSize) noexcept;
 };
 
+/**
+    @brief Decodes the given offset table into a flat list of offset positions.
+
+    Each decoded position is absolute (relative to the offset table's base,
+    rather than to the previous offset), so the resulting list is sorted
+    and can be walked or searched any number of times without decoding
+    the table again.
+
+    @param[in] offTable         The offset table to decode.
+    @param[out] offPositions    The list to store the decoded positions in.
+                                Any existing contents are replaced.
+*/
+HL_API void offsets_decode(off_table_handle offTable,
+    std::vector<u32>& offPositions);
+
 HL_API void offsets_fix32(off_table_handle offTable,
     const endian_flag endianFlag, void* base);
 
+HL_API void offsets_fix32(const std::vector<u32>& offPositions,
+    const endian_flag endianFlag, void* base);
+
 HL_API void offsets_fix64(off_table_handle offTable,
     const endian_flag endianFlag, void* base);
 
+HL_API void offsets_fix64(const std::vector<u32>& offPositions,
+    const endian_flag endianFlag, void* base);
+
 HL_API void offsets_copy32(off_table_handle srcOffTable,
     const void* srcBase, void* dstBase);
 
+HL_API void offsets_copy32(const std::vector<u32>& srcOffPositions,
+    const void* srcBase, void* dstBase);
+
 HL_API void offsets_copy64(off_table_handle srcOffTable,
     const void* srcBase, void* dstBase);
 
+HL_API void offsets_copy64(const std::vector<u32>& srcOffPositions,
+    const void* srcBase, void* dstBase);
+
 HL_API void offsets_write_no_sort(std::size_t dataPos,
     const off_table& offTable, stream& stream);
 
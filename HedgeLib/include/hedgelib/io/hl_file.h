@@ -53,12 +53,69 @@ inline void save(const blob& fileData, const nstring& filePath)
 }
 } // file
 
+/**
+    @brief A stream which reads from and/or writes to a file.
+
+    Writes are buffered: small writes are coalesced into one large in-memory
+    window which is only written to the file once it fills up, or once data
+    outside of it is written (or anything is read). Seeking is tracked within
+    the stream itself rather than by the OS, so jumping back to patch data
+    that's still within the window (e.g. via fix_off32) and then jumping back
+    to the end again doesn't touch the file at all.
+
+    Buffered data is written to the file when calling flush() or close(), or
+    when the stream is destructed. Errors encountered while writing from the
+    destructor are silently ignored, so call close() when you're done writing
+    if you need to know whether all of your data actually made it to the file.
+
+    Small reads are served from a separate read-ahead buffer, so reading lots
+    of small values or strings one after another doesn't make a system call
+    for each one. Writing anything discards the read-ahead buffer.
+
+    read_at() reads straight from the file (using pread on POSIX platforms),
+    so multiple threads can read from the same file_stream at once, as long
+    as nothing is written to it at the same time.
+*/
 class file_stream : public stream
 {
+    constexpr static std::size_t in_write_buf_size = 1048576U;  // 1 MB
+    constexpr static std::size_t in_read_buf_size = 65536U;     // 64 KB
+
     std::uintmax_t m_handle = 0;
+    std::unique_ptr<u8[]> m_writeBuf;
+    /** @brief The position within the file of the first byte in the write buffer. */
+    std::size_t m_writeBufPos = 0;
+    /** @brief The number of bytes within the write buffer which have yet to be written. */
+    std::size_t m_writeBufLen = 0;
+    std::unique_ptr<u8[]> m_readBuf;
+    /** @brief The position within the file of the first byte in the read buffer. */
+    std::size_t m_readBufPos = 0;
+    /** @brief The number of bytes within the read buffer which were read from the file. */
+    std::size_t m_readBufLen = 0;
+    /** @brief The position within the file the OS' file pointer is actually at. */
+    std::size_t m_handlePos = 0;
 
     HL_API void in_open(const nchar* filePath, file::mode mode);
 
+    HL_API void in_handle_jump_to(std::size_t pos);
+
+    HL_API std::size_t in_handle_read(std::size_t size, void* buf);
+
+    HL_API std::size_t in_handle_write(std::size_t size, const void* buf);
+
+    HL_API std::size_t in_handle_read_at(std::size_t pos,
+        std::size_t size, void* buf) const;
+
+    HL_API std::size_t in_handle_write_at(std::size_t pos,
+        std::size_t size, const void* buf);
+
+    HL_API void in_flush_write_buf();
+
+    HL_API std::size_t in_fill_read_buf();
+
+protected:
+    bool in_get_read_buf(const void*& data, std::size_t& size) override;
+
 public:
     std::size_t read(std::size_t size, void* buf) override;
     std::size_t write(std::size_t size, const void* buf) override;
@@ -66,6 +123,8 @@ public:
     void jump_to(std::size_t pos) override;
     void flush() override;
     std::size_t get_size() override;
+    std::size_t read_at(std::size_t pos, std::size_t size, void* buf) override;
+    std::size_t write_at(std::size_t pos, std::size_t size, const void* buf) override;
     ~file_stream() override;
 
     HL_API void close();
@@ -87,5 +146,80 @@ public:
         in_open(filePath.c_str(), mode);
     }
 };
+
+/**
+    @brief A private, copy-on-write view of an entire file's contents.
+
+    On POSIX platforms, the file is memory-mapped, so only the pages which are
+    actually accessed get read from disk, and no extra copy of the file is made.
+    On other platforms (or if the file cannot be mapped), the file's contents are
+    simply read into a heap buffer using a file_stream instead.
+
+    The data can be freely modified (e.g. to fix offsets in-place), but these
+    modifications are never written back to the file.
+*/
+class mapped_file
+{
+    void* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_isMapped = false;
+
+    HL_API void in_open(const nchar* filePath);
+    HL_API void in_close() noexcept;
+
+public:
+    template<typename T = void>
+    inline const T* data() const noexcept
+    {
+        return static_cast<const T*>(m_data);
+    }
+
+    template<typename T = void>
+    inline T* data() noexcept
+    {
+        return static_cast<T*>(m_data);
+    }
+
+    inline std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+        @brief Returns whether the file's contents are actually memory-mapped,
+        rather than having been read into a heap buffer.
+    */
+    inline bool is_mapped() const noexcept
+    {
+        return m_isMapped;
+    }
+
+    inline void close() noexcept
+    {
+        in_close();
+    }
+
+    HL_API mapped_file& operator=(mapped_file&& other) noexcept;
+
+    inline mapped_file(const nchar* filePath)
+    {
+        in_open(filePath);
+    }
+
+    inline mapped_file(const nstring& filePath)
+    {
+        in_open(filePath.c_str());
+    }
+
+    mapped_file(const mapped_file& other) = delete;
+    mapped_file& operator=(const mapped_file& other) = delete;
+
+    HL_API mapped_file(mapped_file&& other) noexcept;
+
+    inline ~mapped_file()
+    {
+        in_close();
+    }
+};
 } // hl
 #endif
@@ -11,6 +11,8 @@ protected:
     const u8* m_handle;
     std::size_t m_dataSize;
 
+    bool in_get_read_buf(const void*& data, std::size_t& size) override;
+
 public:
     std::size_t read(std::size_t size, void* buf) override;
     std::size_t write(std::size_t size, const void* buf) override;
@@ -18,6 +20,8 @@ public:
     void jump_to(std::size_t pos) override;
     void flush() override;
     std::size_t get_size() override;
+    std::size_t read_at(std::size_t pos, std::size_t size, void* buf) override;
+    std::size_t write_at(std::size_t pos, std::size_t size, const void* buf) override;
     ~readonly_mem_stream() override;
 
     template<typename T = void>
@@ -45,6 +49,7 @@ class mem_stream : public readonly_mem_stream
 
 public:
     std::size_t write(std::size_t size, const void* buf) override;
+    std::size_t write_at(std::size_t pos, std::size_t size, const void* buf) override;
     ~mem_stream() override;
 
     template<typename T = void>
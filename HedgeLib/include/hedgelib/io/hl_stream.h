@@ -26,6 +26,22 @@ protected:
 
     inline stream() = default;
 
+    /**
+        @brief Gets a pointer to data starting at the stream's current position
+        which can be read directly, without having to be copied first.
+
+        Used to speed up reading strings. The returned data is only valid until
+        the next time the stream is used, and reading it doesn't advance the
+        stream's current position; jump ahead to consume it.
+
+        @param data Set to a pointer to the readable data.
+        @param size Set to the amount of bytes which can be read from data,
+        or 0 if the end of the stream has been reached.
+        @return False if this stream doesn't support direct reading, in which
+        case data and size are left unchanged; true otherwise.
+    */
+    HL_API virtual bool in_get_read_buf(const void*& data, std::size_t& size);
+
 public:
     virtual std::size_t read(std::size_t size, void* buf) = 0;
 
@@ -39,6 +55,36 @@ public:
 
     virtual std::size_t get_size() = 0;
 
+    /**
+        @brief Reads data starting at the given position within the stream,
+        without using or changing the stream's current position.
+
+        By default, this just seeks to the given position, reads the data,
+        and then seeks back. Streams which can read from arbitrary positions
+        directly (file_stream and readonly_mem_stream) override this so that
+        it can safely be called from multiple threads at once, as long as no
+        other thread is writing to the stream at the same time.
+
+        @param pos The position to read from.
+        @param size The amount of bytes to read.
+        @param buf The buffer to read the data into.
+        @return The amount of bytes which were actually read.
+    */
+    HL_API virtual std::size_t read_at(std::size_t pos, std::size_t size, void* buf);
+
+    /**
+        @brief Writes data starting at the given position within the stream,
+        without using or changing the stream's current position.
+
+        Unlike read_at(), this is never safe to call from multiple threads at once.
+
+        @param pos The position to write to.
+        @param size The amount of bytes to write.
+        @param buf The data to write.
+        @return The amount of bytes which were actually written.
+    */
+    HL_API virtual std::size_t write_at(std::size_t pos, std::size_t size, const void* buf);
+
     virtual ~stream() = 0;
 
     inline void jump_ahead(long long amount)
@@ -65,6 +111,10 @@ public:
 
     HL_API void write_all(std::size_t size, const void* buf);
 
+    HL_API void read_all_at(std::size_t pos, std::size_t size, void* buf);
+
+    HL_API void write_all_at(std::size_t pos, std::size_t size, const void* buf);
+
     template<typename T>
     inline void read_obj(T& obj)
     {
@@ -159,6 +209,22 @@ public:
 
     HL_API std::string read_str();
 
+    /**
+        @brief Reads the given number of consecutive null-terminated strings
+        (e.g. a string table) from the stream.
+
+        @param count The number of strings to read.
+        @param strs The array the strings are to be read into.
+    */
+    HL_API void read_strs(std::size_t count, std::string* strs);
+
+    inline std::vector<std::string> read_strs(std::size_t count)
+    {
+        std::vector<std::string> strs(count);
+        read_strs(count, strs.data());
+        return strs;
+    }
+
     std::size_t write_str(const char* str)
     {
         const std::size_t size = text::size(str);
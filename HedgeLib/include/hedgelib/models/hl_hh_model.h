@@ -3,6 +3,7 @@
 #include "../hl_scene.h"
 #include "../hl_resource.h"
 #include "../io/hl_hh_mirage.h"
+#include <robin_hood.h>
 #include <unordered_set>
 
 namespace hl
@@ -16,6 +17,11 @@ class skeletal_model;
 class terrain_model;
 struct node;
 
+/**
+ * @brief Maps the names of a model's nodes to the bones which were added to a scene for them.
+ */
+using bone_table = robin_hood::unordered_flat_map<std::string, hl::bone*>;
+
 /**
  * @brief Seems to be D3D_PRIMITIVE_TOPOLOGY, but with 1 subtracted from each value?
  * Perhaps this was done to make it impossible to use D3D_PRIMITIVE_TOPOLOGY_UNDEFINED?
@@ -657,7 +663,8 @@ struct mesh
         topology_type topType = topology_type::triangle_strip,
         const std::vector<mirage::node>* hhNodes = nullptr,
         bool includeLibGensTags = true,
-        const char* libGensLayerName = nullptr) const;
+        const char* libGensLayerName = nullptr,
+        const bone_table* boneTable = nullptr) const;
 
     HL_API void write(writer& writer, u32 revision = 1) const;
 
@@ -677,7 +684,8 @@ struct mesh_slot : public std::vector<mesh>
         topology_type topType = topology_type::triangle_strip,
         const std::vector<mirage::node>* hhNodes = nullptr,
         bool includeLibGensTags = true,
-        const char* libGensLayerName = nullptr) const;
+        const char* libGensLayerName = nullptr,
+        const bone_table* boneTable = nullptr) const;
 
     HL_API void write(writer& writer, u32 revision = 1) const;
 
@@ -695,10 +703,11 @@ struct special_mesh_slot : public mesh_slot
     inline void add_to_node(hl::node& node,
         topology_type topType = topology_type::triangle_strip,
         const std::vector<mirage::node>* hhNodes = nullptr,
-        bool includeLibGensTags = true) const
+        bool includeLibGensTags = true,
+        const bone_table* boneTable = nullptr) const
     {
-        mesh_slot::add_to_node(node, topType,
-            hhNodes, includeLibGensTags, type.c_str());
+        mesh_slot::add_to_node(node, topType, hhNodes,
+            includeLibGensTags, type.c_str(), boneTable);
     }
 
     special_mesh_slot(std::string type) noexcept :
@@ -734,7 +743,8 @@ struct mesh_group
     HL_API void add_to_node(hl::node& node,
         topology_type topType = topology_type::triangle_strip,
         const std::vector<mirage::node>* hhNodes = nullptr,
-        bool includeLibGensTags = true) const;
+        bool includeLibGensTags = true,
+        const bone_table* boneTable = nullptr) const;
 
     HL_API void write(writer& writer, u32 revision = 1,
         bool allowNullOffsets = true) const;
@@ -14,7 +14,7 @@ class stream;
 
 namespace internal
 {
-class in_rapidjson_writer;
+class in_json_writer;
 } // internal
 
 namespace hson
@@ -56,10 +56,10 @@ class parameter
     };
 
 protected:
-    static void in_write_all(internal::in_rapidjson_writer& writer,
+    static void in_write_all(internal::in_json_writer& writer,
         const radix_tree<parameter>& parameters);
 
-    void in_write(internal::in_rapidjson_writer& writer) const;
+    void in_write(internal::in_json_writer& writer) const;
 
 private:
     void in_default_construct_value();
@@ -213,7 +213,7 @@ class object
     const parameter* in_get_parameter_from_path(const char* firstNameSep,
         const char* fullPath, const ordered_map<guid, object>& objects) const;
 
-    void in_write(internal::in_rapidjson_writer& writer) const;
+    void in_write(internal::in_json_writer& writer) const;
 
 public:
     static const std::string default_name;
@@ -384,7 +384,7 @@ class project_metadata
     friend project;
 
 protected:
-    void in_write(internal::in_rapidjson_writer& writer) const;
+    void in_write(internal::in_json_writer& writer) const;
 
 public:
     std::string name;
@@ -401,6 +401,8 @@ public:
 
 class project
 {
+    arena* m_arena = nullptr;
+
     void in_parse(const void* rawData, std::size_t rawDataSize);
 
     void in_read(stream& stream);
@@ -412,6 +414,30 @@ public:
     ordered_map<guid, object> objects;
     radix_tree<parameter> customProperties;
 
+    /**
+        @brief Returns the arena used to allocate the parameter trees which
+        are parsed into this project, or null if their nodes are allocated
+        individually on the heap.
+    */
+    inline arena* get_arena() const noexcept
+    {
+        return m_arena;
+    }
+
+    /**
+        @brief Sets the arena used to allocate the parameter trees which
+        are parsed into this project from now on.
+
+        @param arena The arena to use, or null to allocate parameter tree
+        nodes individually on the heap. Parameters allocated from an arena
+        (including any objects or parameters moved out of this project)
+        must not outlive it! Copies are always allocated on the heap.
+    */
+    inline void set_arena(arena* arena) noexcept
+    {
+        m_arena = arena;
+    }
+
     HL_API void clear() noexcept;
 
     HL_API void parse(const void* rawData, std::size_t rawDataSize);
@@ -437,6 +463,18 @@ public:
     project() noexcept(noexcept(
         typename ordered_map<guid, object>::ordered_map())) = default;
 
+    /**
+        @brief Constructs an empty project which allocates the nodes of the
+        parameter trees parsed into it from the given arena.
+
+        Parsing creates at least one tree node per parameter, so this avoids
+        a great deal of small heap allocations when loading projects with lots
+        of objects, and lets those nodes all be freed at once with the arena.
+    */
+    explicit project(arena& arena) noexcept(noexcept(
+        typename ordered_map<guid, object>::ordered_map())) :
+        m_arena(&arena) {}
+
     HL_API project(const void* rawData, std::size_t rawDataSize);
 
     HL_API project(stream& stream);
@@ -537,6 +575,124 @@ inline radix_tree<parameter> object::get_flattened_parameters(
 {
     return get_flattened_parameters(project.objects, rootPath);
 }
+
+/**
+    @brief A cached view of a project, which resolves the inherited values,
+    global transforms, and flattened parameters of every object in the
+    project once, rather than walking each object's parent and instance
+    chains every time one of these values is requested.
+
+    Objects are referred to by index, in the same order as they appear
+    within the project's objects map. Values are stored in separate arrays
+    (one per value type), so iterating over e.g. every object's global
+    transform only touches the transforms themselves.
+
+    NOTE: The view does not own the project, so the project must outlive
+    it. Any time an object within the project is modified, added, or
+    removed, invalidate must be called with that object's ID, which will
+    also invalidate any objects which are parented to or instance it.
+*/
+class project_view
+{
+    const project* m_project;
+    robin_hood::unordered_flat_map<guid, std::size_t> m_indices;
+    std::vector<const guid*> m_ids;
+    std::vector<const object*> m_objects;
+    std::vector<std::size_t> m_instanceIndices;
+    std::vector<std::size_t> m_parentIndices;
+    std::vector<const std::string*> m_names;
+    std::vector<const std::string*> m_types;
+    std::vector<const guid*> m_parentIDs;
+    std::vector<matrix4x4A> m_globalTransforms;
+    std::vector<radix_tree<parameter>> m_flatParams;
+    std::vector<unsigned char> m_flags;
+    std::vector<std::size_t> m_dependentsBegin;
+    std::vector<std::size_t> m_dependents;
+    bool m_needsRebuild = true;
+    bool m_hasDirtyObjects = false;
+
+    std::size_t in_find_index(const guid& id) const noexcept;
+
+    template<typename T, typename getter_t>
+    T in_get_inherited_value(std::size_t index,
+        const getter_t& getter) const noexcept;
+
+    void in_rebuild();
+
+    void in_resolve_values(std::size_t index) noexcept;
+
+    void in_resolve_global_transforms();
+
+    inline void in_update_if_necessary()
+    {
+        if (m_needsRebuild || m_hasDirtyObjects)
+        {
+            update();
+        }
+    }
+
+public:
+    /** @brief Returned by index_of when the given object could not be found. */
+    static constexpr std::size_t npos = SIZE_MAX;
+
+    inline const hson::project& get_project() const noexcept
+    {
+        return *m_project;
+    }
+
+    HL_API std::size_t size();
+
+    HL_API std::size_t index_of(const guid& id);
+
+    HL_API const guid& get_id(std::size_t index);
+
+    HL_API const object& get_object(std::size_t index);
+
+    /** @brief Equivalent to object::get_inherited_name. */
+    HL_API const std::string* get_inherited_name(std::size_t index);
+
+    /** @brief Equivalent to object::get_inherited_type. */
+    HL_API const std::string* get_inherited_type(std::size_t index);
+
+    /** @brief Equivalent to object::get_inherited_parent_id. */
+    HL_API const guid* get_inherited_parent_id(std::size_t index);
+
+    /**
+        @brief Returns the index of the object's (inherited) parent
+        within this view, or npos if it doesn't have one.
+    */
+    HL_API std::size_t get_parent_index(std::size_t index);
+
+    /** @brief Equivalent to object::get_global_transform. */
+    HL_API const matrix4x4A& get_global_transform(std::size_t index);
+
+    /**
+        @brief Equivalent to object::get_flattened_parameters.
+        The parameters are only flattened the first time they're requested.
+    */
+    HL_API const radix_tree<parameter>& get_flattened_parameters(std::size_t index);
+
+    /**
+        @brief Marks the object with the given ID (and every object which is
+        parented to or instances it, directly or indirectly) as needing to be
+        resolved again. Must be called whenever an object is modified, added,
+        or removed.
+    */
+    HL_API void invalidate(const guid& id);
+
+    /** @brief Marks every object as needing to be resolved again. */
+    HL_API void invalidate_all() noexcept;
+
+    /**
+        @brief Resolves every object which has been invalidated. Called
+        automatically when accessing values, but can be called up-front, after
+        which every function except get_flattened_parameters can safely be
+        called from multiple threads at once (as long as nothing is invalidated).
+    */
+    HL_API void update();
+
+    HL_API explicit project_view(const hson::project& project);
+};
 } // hson
 } // hl
 #endif
@@ -23,6 +23,8 @@ enum class set_object_format
     gedit_v3,
 };
 
+inline constexpr nchar set_object_type_database_cache_extension[] = HL_NTEXT(".hlcache");
+
 class set_object_type_database : public radix_tree<set_object_type>
 {
     void in_parse(const void* rawData, std::size_t rawDataSize);
@@ -31,6 +33,13 @@ class set_object_type_database : public radix_tree<set_object_type>
 
     void in_load(const nchar* filePath);
 
+    bool in_read_cache(const void* rawData, std::size_t rawDataSize,
+        u64 sourceSize, u64 sourceHash);
+
+    void in_write_cache(stream& stream, u64 sourceSize, u64 sourceHash) const;
+
+    void in_load(const nchar* filePath, const nchar* cacheFilePath);
+
 public:
     set_object_format                       format = set_object_format::unknown;
     reflect::enum_definition_database       enums;
@@ -49,6 +58,25 @@ public:
         load(filePath.c_str());
     }
 
+    /**
+        @brief Loads the given JSON template file, using the given binary
+        cache file instead of parsing the JSON data whenever possible.
+
+        If the cache file is missing, corrupt, was written by a different
+        version of HedgeLib, or was generated from different JSON data, the
+        JSON data is parsed as usual, and the cache file is re-generated from
+        the result. Failing to write the cache file is not treated as an error.
+
+        @param filePath The path to the JSON template file to load.
+        @param cacheFilePath The path to the binary cache file to use.
+    */
+    HL_API void load(const nchar* filePath, const nchar* cacheFilePath);
+
+    inline void load(const nstring& filePath, const nstring& cacheFilePath)
+    {
+        load(filePath.c_str(), cacheFilePath.c_str());
+    }
+
     set_object_type_database() noexcept = default;
 
     HL_API set_object_type_database(const void* rawData, std::size_t rawDataSize);
@@ -59,6 +87,13 @@ public:
 
     inline set_object_type_database(const nstring& filePath) :
         set_object_type_database(filePath.c_str()) {}
+
+    HL_API set_object_type_database(const nchar* filePath,
+        const nchar* cacheFilePath);
+
+    inline set_object_type_database(const nstring& filePath,
+        const nstring& cacheFilePath) :
+        set_object_type_database(filePath.c_str(), cacheFilePath.c_str()) {}
 };
 } // hl
 #endif
@@ -1,6 +1,10 @@
 #include "hedgelib/archives/hl_archive.h"
 #include "hedgelib/io/hl_path.h"
 #include "hedgelib/io/hl_file.h"
+#include "hedgelib/hl_thread_pool.h"
+#include "hedgelib/hl_text.h"
+#include <robin_hood.h>
+#include <algorithm>
 #include <utility>
 #include <cstring>
 
@@ -18,6 +22,32 @@ std::size_t archive_entry::size() const noexcept
     return ((is_dir()) ? dir_entries().size() : m_size);
 }
 
+archive_entry::in_path_ptr archive_entry::in_arena_copy_path(
+    arena& arena, const nchar* path)
+{
+    // Copy path (including null terminator) into arena.
+    const std::size_t pathLen = (text::len(path) + 1);
+    nchar* pathBuf = arena.allocate<nchar>(pathLen);
+    std::memcpy(pathBuf, path, pathLen * sizeof(nchar));
+
+    return in_path_ptr(pathBuf, in_path_deleter(false));
+}
+
+#ifdef HL_IN_WIN32_UNICODE
+archive_entry::in_path_ptr archive_entry::in_arena_copy_path(
+    arena& arena, const char* path)
+{
+    // Convert path (including null terminator) directly into arena.
+    const std::size_t pathLen = (text::conv_no_alloc<
+        text::utf8_to_native>(path) + 1);
+
+    nchar* pathBuf = arena.allocate<nchar>(pathLen);
+    text::conv_no_alloc<text::utf8_to_native>(path, pathBuf, pathLen);
+
+    return in_path_ptr(pathBuf, in_path_deleter(false));
+}
+#endif
+
 archive_entry archive_entry::make_streaming_file_utf8(const char* fileName,
     std::size_t uncompressedSize, std::size_t compressedSize,
     std::uintmax_t customData)
@@ -36,10 +66,20 @@ archive_entry archive_entry::make_streaming_file(const nchar* fileName,
         fileName, uncompressedSize, customData);
 }
 
+archive_entry archive_entry::make_streaming_file_utf8(arena& arena,
+    const char* fileName, std::size_t uncompressedSize,
+    std::size_t compressedSize, std::uintmax_t customData)
+{
+    return archive_entry(
+        (HL_ARC_ENTRY_IS_STREAMING_FLAG | compressedSize),
+        in_arena_copy_path(arena, fileName),
+        uncompressedSize, customData);
+}
+
 archive_entry archive_entry::make_dir(const nchar* dirName,
     std::size_t initialEntryCount)
 {
-    std::vector<archive_entry>* subEntries = new std::vector<archive_entry>();
+    archive_entry_list* subEntries = new archive_entry_list();
     subEntries->reserve(initialEntryCount);
 
     try
@@ -54,6 +94,29 @@ archive_entry archive_entry::make_dir(const nchar* dirName,
     }
 }
 
+archive_entry archive_entry::make_dir(arena& arena,
+    const nchar* dirName, std::size_t initialEntryCount)
+{
+    // NOTE: The directory's list itself is still heap-allocated (and freed
+    // with the entry), as its entries need to be destructed; only the name
+    // and the names/data of the entries added to it use the arena.
+    in_path_ptr dirNameCopy = in_arena_copy_path(arena, dirName);
+    archive_entry_list* subEntries = new archive_entry_list(arena);
+
+    try
+    {
+        subEntries->reserve(initialEntryCount);
+    }
+    catch (...)
+    {
+        delete subEntries;
+        throw;
+    }
+
+    return archive_entry(HL_ARC_ENTRY_IS_DIR_FLAG,
+        std::move(dirNameCopy), 0, subEntries);
+}
+
 archive_entry archive_entry::make_regular_file_no_alloc_utf8(
     const char* fileName, std::size_t fileSize, void* data)
 {
@@ -82,6 +145,26 @@ archive_entry archive_entry::make_regular_file_utf8(const char* fileName,
     }
 }
 
+archive_entry archive_entry::make_regular_file_utf8(arena& arena,
+    const char* fileName, std::size_t fileSize, const void* data)
+{
+    // Create copy of data within arena.
+    in_path_ptr fileNameCopy = in_arena_copy_path(arena, fileName);
+    void* dataPtr = arena.allocate(fileSize);
+    std::memcpy(dataPtr, data, fileSize);
+
+    // Create archive_entry and return it.
+    return archive_entry(HL_ARC_ENTRY_NOT_OWNS_DATA_FLAG,
+        std::move(fileNameCopy), fileSize, dataPtr);
+}
+
+archive_entry archive_entry::make_regular_file_no_alloc_utf8(arena& arena,
+    const char* fileName, std::size_t fileSize, void* data)
+{
+    return archive_entry(HL_ARC_ENTRY_NOT_OWNS_DATA_FLAG,
+        in_arena_copy_path(arena, fileName), fileSize, data);
+}
+
 archive_entry archive_entry::make_regular_file_no_alloc(
     const nchar* fileName, std::size_t fileSize, void* data)
 {
@@ -110,6 +193,19 @@ archive_entry archive_entry::make_regular_file(const nchar* fileName,
     }
 }
 
+archive_entry archive_entry::make_regular_file(arena& arena,
+    const nchar* fileName, std::size_t fileSize, const void* data)
+{
+    // Create copy of data within arena.
+    in_path_ptr fileNameCopy = in_arena_copy_path(arena, fileName);
+    void* dataPtr = arena.allocate(fileSize);
+    std::memcpy(dataPtr, data, fileSize);
+
+    // Create archive_entry and return it.
+    return archive_entry(HL_ARC_ENTRY_NOT_OWNS_DATA_FLAG,
+        std::move(fileNameCopy), fileSize, dataPtr);
+}
+
 archive_entry archive_entry::make_file(const nchar* filePath, bool loadData)
 {
     if (loadData)
@@ -153,7 +249,7 @@ archive_entry& archive_entry::operator=(const archive_entry& other)
             void* newData;
             if (other.is_dir())
             {
-                newData = new std::vector<archive_entry>(other.dir_entries());
+                newData = new archive_entry_list(other.dir_entries());
                 if (owns_data()) delete &dir_entries();
             }
             else if (other.is_reference_file())
@@ -170,7 +266,12 @@ archive_entry& archive_entry::operator=(const archive_entry& other)
             m_data = newData;
         }
 
-        m_meta = other.m_meta;
+        // NOTE: Copies of file data are always owned by the copy,
+        // even if the original entry's data was not owned by it.
+        m_meta = (other.is_regular_file()) ?
+            (other.m_meta & ~HL_ARC_ENTRY_NOT_OWNS_DATA_FLAG) :
+            other.m_meta;
+
         m_path = std::move(newPath);
         m_size = other.m_size;
     }
@@ -211,7 +312,7 @@ archive_entry::archive_entry(const archive_entry& other) :
     }
     else if (other.is_dir())
     {
-        m_data = new std::vector<archive_entry>(other.dir_entries());
+        m_data = new archive_entry_list(other.dir_entries());
     }
     else if (other.is_reference_file())
     {
@@ -219,8 +320,11 @@ archive_entry::archive_entry(const archive_entry& other) :
     }
     else
     {
+        // NOTE: Copies of file data are always owned by the copy,
+        // even if the original entry's data was not owned by it.
         m_data = new u8[other.m_size];
         std::memcpy(m_data, other.m_data, other.m_size);
+        m_meta &= ~HL_ARC_ENTRY_NOT_OWNS_DATA_FLAG;
     }
 }
 
@@ -255,8 +359,36 @@ archive_entry::~archive_entry()
     }
 }
 
-static void in_archive_extract(const std::vector<archive_entry>& entries,
-    bool recursive, nstring& pathBuf)
+struct in_archive_extract_job
+{
+    const archive_entry* entry;
+    nstring path;
+};
+
+static nstring in_archive_get_extract_file_key(const nstring& filePath)
+{
+    nstring key(filePath);
+
+    // Windows and macOS file systems are case-insensitive by default,
+    // so paths which only differ by case refer to the same file there.
+#if defined(_WIN32) || defined(__APPLE__)
+    for (auto& c : key)
+    {
+        c = text::to_lower(c);
+    }
+#endif
+
+    // Windows also treats forward slashes as path separators.
+#ifdef _WIN32
+    std::replace(key.begin(), key.end(), HL_NTEXT('/'), path::separator);
+#endif
+
+    return key;
+}
+
+static void in_archive_gather_extract_files(const std::vector<archive_entry>& entries,
+    bool recursive, nstring& pathBuf, std::vector<in_archive_extract_job>& files,
+    robin_hood::unordered_map<nstring, std::size_t>& fileIndices)
 {
     // Append path combine separator if necessary.
     if (path::combine_needs_sep1(pathBuf))
@@ -267,7 +399,7 @@ static void in_archive_extract(const std::vector<archive_entry>& entries,
     // Store path buffer length for later.
     const std::size_t pathBufLen = pathBuf.length();
 
-    // Extract entries.
+    // Gather entries.
     for (const auto& entry : entries)
     {
         // Skip streaming entries.
@@ -282,30 +414,35 @@ static void in_archive_extract(const std::vector<archive_entry>& entries,
         // Append entry name to end of path buffer.
         pathBuf += name;
 
-        // Extract regular file entries.
+        // Gather regular file entries.
         if (entry.is_regular_file())
         {
-            // Copy referenced files.
-            if (entry.is_reference_file())
+            // If an earlier entry would be extracted to the same path, extract
+            // this entry in its place instead, since it would've overwritten it
+            // anyway, and writing both at once on different threads isn't safe.
+            auto fileKey = in_archive_get_extract_file_key(pathBuf);
+            const auto it = fileIndices.find(fileKey);
+
+            if (it != fileIndices.end())
             {
-                path::copy_file(entry.path(), pathBuf.c_str());
+                files[it->second].entry = &entry;
             }
-
-            // Extract normal files.
             else
             {
-                file::save(entry.file_data(), entry.size(), pathBuf);
+                fileIndices.emplace(std::move(fileKey), files.size());
+                files.push_back({ &entry, pathBuf });
             }
         }
 
-        // Extract directory entries.
+        // Create directories up-front, so they all exist before any files get written.
         else if (recursive)
         {
             // Create directory.
             path::create_dir(pathBuf);
 
-            // Recursively extract sub-entries.
-            in_archive_extract(entry.dir_entries(), recursive, pathBuf);
+            // Recursively gather sub-entries.
+            in_archive_gather_extract_files(entry.dir_entries(),
+                recursive, pathBuf, files, fileIndices);
         }
 
         // Remove name from end of path.
@@ -313,14 +450,53 @@ static void in_archive_extract(const std::vector<archive_entry>& entries,
     }
 }
 
-void archive_entry_list::extract(const nchar* dirPath, bool recursive) const
+static void in_archive_extract_file(const in_archive_extract_job& file)
+{
+    // Copy referenced files.
+    if (file.entry->is_reference_file())
+    {
+        path::copy_file(file.entry->path(), file.path.c_str());
+    }
+
+    // Extract normal files.
+    else
+    {
+        file::save(file.entry->file_data(), file.entry->size(), file.path);
+    }
+}
+
+void archive_entry_list::extract(const nchar* dirPath,
+    bool recursive, thread_pool* pool) const
 {
     // Ensure extraction directory exists.
     nstring pathBuf(dirPath);
     path::create_dir(pathBuf);
 
-    // Extract files/directories as requested.
-    in_archive_extract(*this, recursive, pathBuf);
+    // Create all of the directories we need, and gather every file we need to write.
+    std::vector<in_archive_extract_job> files;
+    {
+        robin_hood::unordered_map<nstring, std::size_t> fileIndices;
+        in_archive_gather_extract_files(*this, recursive,
+            pathBuf, files, fileIndices);
+    }
+
+    // Extract files one-by-one if we weren't given a thread pool.
+    if (!pool)
+    {
+        for (const auto& file : files)
+        {
+            in_archive_extract_file(file);
+        }
+
+        return;
+    }
+
+    // Otherwise, extract files in parallel, so that extracting lots of small
+    // files isn't bottlenecked by waiting on each one to be opened/written/closed.
+    pool->parallel_for(files.size(), [&files](std::size_t i)
+    {
+        in_archive_extract_file(files[i]);
+    });
 }
 
 static void in_archive_add_dir_contents(nstring& pathBuf,
@@ -54,6 +54,28 @@ void header::parse(std::size_t hhArcSize,
     }
 }
 
+void header::parse_no_alloc(std::size_t hhArcSize,
+    archive_entry_list& hlArc)
+{
+    // Get start and end pointers.
+    u8* curPtr = ptradd(this, sizeof(header));
+    const u8* endPtr = ptradd(this, hhArcSize);
+
+    // Setup file entries in this split.
+    while (curPtr < endPtr)
+    {
+        // Get file entry pointer.
+        file_entry* hhFileEntry = reinterpret_cast<file_entry*>(curPtr);
+
+        // Add file entry to archive, pointing directly to the entry's data.
+        hlArc.add_file_no_alloc_utf8(hhFileEntry->name(),
+            hhFileEntry->dataSize, hhFileEntry->data());
+
+        // Go to next file entry within the archive.
+        curPtr += hhFileEntry->entrySize;
+    }
+}
+
 static void in_get_root_path(nstring& filePath)
 {
     // Get the extension.
@@ -191,13 +213,80 @@ void load(const nstring& filePath, archive_entry_list* hlArc,
     in_load(filePath, hlArc, hhArcs);
 }
 
+void load_mapped_single(const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& hhArcs)
+{
+    // Map file into memory.
+    mapped_file hhArc(filePath);
+
+    // Fix and parse data without copying it.
+    fix(hhArc.data(), hhArc.size());
+    parse_no_alloc(hhArc.data(), hhArc.size(), hlArc);
+
+    // Keep the mapping alive for as long as the caller needs the entries.
+    hhArcs.push_back(std::move(hhArc));
+}
+
+template<typename T>
+void in_load_mapped(T& filePath, archive_entry_list& hlArc,
+    std::vector<mapped_file>& hhArcs)
+{
+    // Load splits if necessary.
+    const nchar* ext = path::get_ext(filePath);
+    if (path::ext_is_split(ext))
+    {
+        nstring splitPathBuf(filePath);
+        bool loadedAtLeastOneSplit = false;
+
+        for (auto splitPath : path::split_iterator2<>(splitPathBuf))
+        {
+            // Break out of loop when we've reached the final split.
+            if (!path::exists(splitPath))
+            {
+                if (loadedAtLeastOneSplit)
+                {
+                    // We've just reached the final split; return successfully.
+                    return;
+                }
+                else
+                {
+                    // The first split didn't even exist; raise an error.
+                    throw not_found_exception();
+                }
+            }
+
+            // Load split archive.
+            load_mapped_single(splitPath, hlArc, hhArcs);
+            loadedAtLeastOneSplit = true;
+        }
+    }
+
+    // Otherwise, just load a single archive.
+    else
+    {
+        load_mapped_single(filePath, hlArc, hhArcs);
+    }
+}
+
+void load_mapped(const nchar* filePath, archive_entry_list& hlArc,
+    std::vector<mapped_file>& hhArcs)
+{
+    in_load_mapped(filePath, hlArc, hhArcs);
+}
+
+void load_mapped(const nstring& filePath, archive_entry_list& hlArc,
+    std::vector<mapped_file>& hhArcs)
+{
+    in_load_mapped(filePath, hlArc, hhArcs);
+}
+
 void save(const archive_entry_list& arc,
     const nchar* filePath, u32 splitLimit,
     u32 dataAlignment, compress_type compressType,
     bool generateARL, packed_file_info* pfi)
 {
     // TODO: Support compression.
-    std::unique_ptr<stream> arl, ar;
+    std::unique_ptr<file_stream> arl, ar;
     const nchar* exts = path::get_exts(filePath);
     const size_t noExtsLen = (size_t)(exts - filePath);
     nstring pathBuf(filePath, noExtsLen);
@@ -357,6 +446,9 @@ void save(const archive_entry_list& arc,
                 throw out_of_range_exception();
             }
 
+            // Finish writing the current split.
+            ar->close();
+
             // Open the next split for writing.
             ar = std::unique_ptr<file_stream>(new file_stream(
                 pathBuf, file::mode::write));
@@ -492,7 +584,13 @@ void save(const archive_entry_list& arc,
             // Write file name to ARL without null terminator.
             arl->write_arr(fileNameUTF8Len, fileNameUTF8Ptr);
         }
+
+        // Finish writing ARL.
+        arl->close();
     }
+
+    // Finish writing the final split.
+    ar->close();
 }
 } // ar
 
@@ -674,6 +772,9 @@ void save(const packed_file_info& pfi,
     mirage::standard::raw_header::finish_write(0,
         sizeof(mirage::standard::raw_header),
         version, offTable, file, "");
+
+    // Close file.
+    file.close();
 }
 } // pfi
 } // hh
@@ -4,6 +4,7 @@
 #include "hedgelib/io/hl_mem_stream.h"
 #include "hedgelib/io/hl_file.h"
 #include "hedgelib/io/hl_path.h"
+#include "hedgelib/hl_thread_pool.h"
 #include <cstring>
 #include <iterator>
 #include <random>
@@ -202,6 +203,69 @@ static int in_compare_file_names(const nchar* fileName1, const nchar* fileName2,
     return nameSortWeight;
 }
 
+/**
+    @brief A stream which discards everything written to it, and only keeps
+    track of the size of the data that would have been written. Used to
+    measure pacs before writing them for real.
+*/
+class in_size_stream : public stream
+{
+    std::size_t m_size = 0;
+
+public:
+    std::size_t read(std::size_t size, void* buf) override
+    {
+        throw unsupported_exception();
+    }
+
+    std::size_t write(std::size_t size, const void* buf) override
+    {
+        m_curPos += size;
+        if (m_curPos > m_size)
+        {
+            m_size = m_curPos;
+        }
+
+        return size;
+    }
+
+    void seek(seek_mode mode, long long offset) override
+    {
+        switch (mode)
+        {
+        default:
+        case seek_mode::beg:
+            jump_to(static_cast<std::size_t>(offset));
+            break;
+
+        case seek_mode::cur:
+            jump_to(static_cast<std::size_t>(m_curPos + offset));
+            break;
+
+        case seek_mode::end:
+            jump_to(static_cast<std::size_t>(m_size + offset));
+            break;
+        }
+    }
+
+    void jump_to(std::size_t pos) override
+    {
+        if (pos > m_size)
+        {
+            throw out_of_range_exception();
+        }
+
+        m_curPos = pos;
+    }
+
+    void flush() override {}
+
+    std::size_t get_size() override
+    {
+        return m_size;
+    }
+};
+
 namespace v2
 {
 bool data_entry::has_merged_bina_data(bina::off_table_handle::iterator beg,
@@ -233,6 +297,21 @@ bool data_entry::has_merged_bina_data(bina::off_table_handle::iterator beg,
     return false;
 }
 
+bool data_entry::has_merged_bina_data(const std::vector<u32>& offPositions,
+    const void* base) const noexcept
+{
+    // Find the first offset which comes at or after the start of this data entry.
+    const std::size_t dataStartPos = static_cast<std::size_t>(
+        data<u8>() - static_cast<const u8*>(base));
+
+    const auto offIt = std::lower_bound(offPositions.begin(),
+        offPositions.end(), dataStartPos);
+
+    // This is a merged BINA file if that offset lies within this data entry.
+    return (offIt != offPositions.end() &&
+        (*offIt - dataStartPos) < dataSize);
+}
+
 const char* type_dic_node::type_sep() const
 {
     // Get type string, if any.
@@ -358,11 +437,11 @@ void block_data_header::fix(bina::endian_flag endianFlag, void* header)
 
 static void in_add_file_entry(const data_entry& dataEntry,
     const std::string& fileName, bina::endian_flag endianFlag, const void* header,
-    const char* strings, bina::off_table_handle::iterator offIt,
-    const bina::off_table_handle::iterator& offEnd, archive_entry_list& hlArc)
+    const char* strings, const std::vector<u32>& offPositions,
+    bool noAlloc, archive_entry_list& hlArc)
 {
     // Determine if this is a "merged" BINA file.
-    if (dataEntry.has_merged_bina_data(offIt, offEnd, header))
+    if (dataEntry.has_merged_bina_data(offPositions, header))
     {
         // Account for BINA header, DATA block, and padding.
         std::size_t dataSize = (static_cast<std::size_t>(dataEntry.dataSize) +
@@ -389,15 +468,14 @@ static void in_add_file_entry(const data_entry& dataEntry,
         u32* dstDataStart = ptradd<u32>(unmergedData.get_data_ptr(), 
             sizeof(bina::v2::raw_header) + (sizeof(bina::v2::raw_data_block_header) * 2));
 
-        const u32* curOff = static_cast<const u32*>(header);
+        // Skip offsets which come before the entry's data.
+        auto offIt = std::lower_bound(offPositions.begin(), offPositions.end(),
+            static_cast<u32>(reinterpret_cast<const u8*>(dataStart) -
+            static_cast<const u8*>(header)));
 
-        while (offIt != offEnd)
+        for (; offIt != offPositions.end(); ++offIt)
         {
-            curOff = ptradd<u32>(curOff, *offIt);
-            ++offIt;
-
-            // Continue if this offset comes before the entry's data.
-            if (curOff < dataStart) continue;
+            const u32* curOff = ptradd<u32>(header, *offIt);
 
             // Break if this offset comes after this entry's data.
             if (curOff >= dataEnd) break;
@@ -452,6 +530,13 @@ static void in_add_file_entry(const data_entry& dataEntry,
         hlArc.emplace_back(archive_entry::make_regular_file_no_alloc_utf8(
             fileName, dataSize, unmergedData.release()));
     }
+    else if (noAlloc)
+    {
+        // Add file entry to archive, pointing directly to the entry's data.
+        // NOTE: This is only done when parsing non-const data, so this is safe.
+        hlArc.add_file_no_alloc_utf8(fileName, dataEntry.dataSize,
+            const_cast<void*>(dataEntry.data()));
+    }
     else
     {
         // Add file entry to archive.
@@ -459,18 +544,19 @@ static void in_add_file_entry(const data_entry& dataEntry,
     }
 }
 
-void block_data_header::parse(const void* header,
+static void in_parse(const block_data_header& dataBlock, const void* header,
     bina::endian_flag endianFlag, archive_entry_list& hlArc,
-    bool skipProxies) const
+    bool skipProxies, bool noAlloc)
 {
     // Get strings and offsets pointers.
-    const char* strTable = str_table();
-    const bina::off_table_handle offTable = offsets();
-    const auto offIt = offTable.begin();
-    const auto offEnd = offTable.end();
+    const char* strTable = dataBlock.str_table();
+
+    // Decode offset table once up-front, as it's searched once per file.
+    std::vector<u32> offPositions;
+    bina::offsets_decode(dataBlock.offsets(), offPositions);
 
     // Setup file entries in this pac.
-    for (const auto& typeNode : types())
+    for (const auto& typeNode : dataBlock.types())
     {
         // Skip invalid types.
         const char* typeSep = typeNode.type_sep();
@@ -506,21 +592,35 @@ void block_data_header::parse(const void* header,
             // Add streaming files.
             if (dataEntry.is_proxy_entry())
             {
-                hlArc.emplace_back(archive_entry::make_streaming_file_utf8(
-                    fileName, dataEntry.dataSize));
+                hlArc.add_streaming_file_utf8(
+                    fileName, dataEntry.dataSize);
             }
 
             // Add regular files.
             else
             {
                 in_add_file_entry(dataEntry, fileName,
-                    endianFlag, header, strTable, offIt,
-                    offEnd, hlArc);
+                    endianFlag, header, strTable, offPositions,
+                    noAlloc, hlArc);
             }
         }
     }
 }
 
+void block_data_header::parse(const void* header,
+    bina::endian_flag endianFlag, archive_entry_list& hlArc,
+    bool skipProxies) const
+{
+    in_parse(*this, header, endianFlag, hlArc, skipProxies, false);
+}
+
+void block_data_header::parse_no_alloc(void* header,
+    bina::endian_flag endianFlag, archive_entry_list& hlArc,
+    bool skipProxies)
+{
+    in_parse(*this, header, endianFlag, hlArc, skipProxies, true);
+}
+
 void block_data_header::start_write(stream& stream)
 {
     // Generate data block header.
@@ -664,6 +764,17 @@ void header::parse(archive_entry_list& hlArc, bool skipProxies) const
     dataBlock->parse(this, endian_flag(), hlArc, skipProxies);
 }
 
+void header::parse_no_alloc(archive_entry_list& hlArc, bool skipProxies)
+{
+    // Get data block, if any.
+    // NOTE: Some .pac files in LW actually don't have DATA blocks (e.g. w1a03_far.pac).
+    block_data_header* dataBlock = get_data_block();
+    if (!dataBlock) return;
+
+    // Parse data block
+    dataBlock->parse_no_alloc(this, endian_flag(), hlArc, skipProxies);
+}
+
 void header::start_write(bina::ver version,
     bina::endian_flag endianFlag, stream& stream)
 {
@@ -711,14 +822,12 @@ void read(blob& pac, archive_entry_list* hlArc,
     }
 }
 
-static void in_load(blob& pac, const nchar* filePath,
-    archive_entry_list* hlArc, std::vector<blob>* pacs)
+template<typename load_dep_func_t>
+static void in_load_deps(const void* pac, const nchar* filePath,
+    load_dep_func_t loadDep)
 {
-    // Read data and parse it as necessary.
-    read(pac, hlArc, pacs);
-
     // Get data block.
-    const block_data_header* dataBlock = get_data_block(pac.data());
+    const block_data_header* dataBlock = get_data_block(pac);
     if (!dataBlock) return;
 
     // Load dependencies.
@@ -749,7 +858,7 @@ static void in_load(blob& pac, const nchar* filePath,
 #endif
 
                     // Load dependency.
-                    load_single(pathBuf, hlArc, pacs);
+                    loadDep(pathBuf);
 
                     // Remove dependency file name from path buffer.
                     pathBuf.erase(dirLen);
@@ -759,6 +868,19 @@ static void in_load(blob& pac, const nchar* filePath,
     }
 }
 
+static void in_load(blob& pac, const nchar* filePath,
+    archive_entry_list* hlArc, std::vector<blob>* pacs)
+{
+    // Read data and parse it as necessary.
+    read(pac, hlArc, pacs);
+
+    // Load dependencies.
+    in_load_deps(pac.data(), filePath, [hlArc, pacs](const nstring& depPath)
+    {
+        load_single(depPath, hlArc, pacs);
+    });
+}
+
 void load(const nchar* filePath, archive_entry_list* hlArc,
     std::vector<blob>* pacs)
 {
@@ -769,6 +891,52 @@ void load(const nchar* filePath, archive_entry_list* hlArc,
     in_load(pac, filePath, hlArc, pacs);
 }
 
+static void in_read_mapped(mapped_file& pac, archive_entry_list& hlArc,
+    std::vector<mapped_file>& pacs)
+{
+    // Fix and parse data without copying it.
+    fix(pac.data());
+    parse_no_alloc(pac.data(), hlArc);
+
+    // Keep the mapping alive for as long as the caller needs the entries.
+    pacs.push_back(std::move(pac));
+}
+
+void load_mapped_single(const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs)
+{
+    // Map file into memory.
+    mapped_file pac(filePath);
+
+    // Read data and parse it.
+    in_read_mapped(pac, hlArc, pacs);
+}
+
+static void in_load_mapped(mapped_file& pac, const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs)
+{
+    // Read data and parse it.
+    // NOTE: The pac's data is still valid after being moved into pacs.
+    void* pacData = pac.data();
+    in_read_mapped(pac, hlArc, pacs);
+
+    // Load dependencies.
+    in_load_deps(pacData, filePath, [&hlArc, &pacs](const nstring& depPath)
+    {
+        load_mapped_single(depPath, hlArc, pacs);
+    });
+}
+
+void load_mapped(const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs)
+{
+    // Map file into memory.
+    mapped_file pac(filePath);
+
+    // Finish loading data and parsing it.
+    in_load_mapped(pac, filePath, hlArc, pacs);
+}
+
 struct in_file_metadata
 {
     const archive_entry* entry;
@@ -1901,39 +2069,50 @@ static void in_data_block_write(unsigned short splitIndex,
         offTable, stream);
 }
 
+static void in_save_split(const nchar* splitPath,
+    unsigned short splitIndex, const in_type_metadata_list& typeMetadata,
+    u32 splitLimit, u32 dataAlignment, bina::endian_flag endianFlag,
+    const in_dep_metadata_list& deps, packed_file_info* pfi)
+{
+    // Open the split file for writing.
+    file_stream splitFile(splitPath, file::mode::write);
+
+    // Start writing split header.
+    header::start_write(ver_201, endianFlag, splitFile);
+
+    // Write split data block.
+    in_data_block_write(splitIndex, typeMetadata,
+        splitLimit, dataAlignment, endianFlag,
+        deps, pfi, splitFile);
+
+    // Finish writing split header.
+    header::finish_write(0, 1, endianFlag, splitFile);
+
+    // Close file.
+    splitFile.close();
+}
+
 static void in_save_splits(const nchar* filePath,
     unsigned short splitCount, const in_type_metadata_list& typeMetadata,
     u32 splitLimit, u32 dataAlignment, bina::endian_flag endianFlag,
-    in_dep_metadata_list& deps, packed_file_info* pfi)
+    in_dep_metadata_list& deps, packed_file_info* pfi, thread_pool* pool)
 {
-    // Reserve space in advance for dependency metadata.
+    // Reserve space in advance for split paths and dependency metadata.
+    std::vector<nstring> splitPaths;
+    splitPaths.reserve(splitCount);
     deps.reserve(splitCount);
 
     // Setup initial split path buffer.
     nstring splitPathBuf(filePath);
     splitPathBuf += HL_NTEXT(".00");
 
-    // Write splits.
+    // Generate split paths and dependency metadata.
     const nchar* splitName = path::get_name(splitPathBuf);
     path::split_iterator2<> splitIt = path::split_iterator2<>(splitPathBuf);
 
     for (unsigned short splitIndex = 0; splitIndex < splitCount; ++splitIndex)
     {
-        // Open the next split file for writing.
-        file_stream splitFile(*splitIt, file::mode::write);
-
-        // Start writing split header.
-        header::start_write(ver_201, endianFlag, splitFile);
-
-        // Write split data block.
-        in_data_block_write(splitIndex, typeMetadata,
-            splitLimit, dataAlignment, endianFlag,
-            deps, pfi, splitFile);
-
-        // Finish writing split header.
-        header::finish_write(0, 1, endianFlag, splitFile);
-
-        // Generate dependency metadata.
+        splitPaths.emplace_back(splitPathBuf);
         deps.emplace_back(text::conv<text::native_to_utf8>(splitName));
 
         // Increase the number in the split extension.
@@ -1943,12 +2122,44 @@ static void in_save_splits(const nchar* filePath,
             throw out_of_range_exception();
         }
     }
+
+    // Write splits one-by-one if we weren't given a thread pool.
+    if (!pool)
+    {
+        for (unsigned short splitIndex = 0; splitIndex < splitCount; ++splitIndex)
+        {
+            in_save_split(splitPaths[splitIndex].c_str(), splitIndex,
+                typeMetadata, splitLimit, dataAlignment, endianFlag,
+                deps, pfi);
+        }
+
+        return;
+    }
+
+    // Otherwise, write splits in parallel. Each split is written straight to its
+    // own file, so at most one split per thread is being generated at a time.
+    std::vector<packed_file_info> splitPfis((pfi) ? splitCount : 0);
+    pool->parallel_for(splitCount, [&](std::size_t splitIndex)
+    {
+        in_save_split(splitPaths[splitIndex].c_str(),
+            static_cast<unsigned short>(splitIndex), typeMetadata,
+            splitLimit, dataAlignment, endianFlag, deps,
+            (pfi) ? &splitPfis[splitIndex] : nullptr);
+    });
+
+    // Merge packed file info in order if necessary.
+    for (auto& splitPfi : splitPfis)
+    {
+        pfi->insert(pfi->end(),
+            std::make_move_iterator(splitPfi.begin()),
+            std::make_move_iterator(splitPfi.end()));
+    }
 }
 
 void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     const supported_ext* exts, const std::size_t extCount,
     const nchar* filePath, u32 splitLimit,
-    u32 dataAlignment, packed_file_info* pfi)
+    u32 dataAlignment, packed_file_info* pfi, thread_pool* pool)
 {
     // Verify that dataAlignment is a multiple of 4.
     if ((dataAlignment % 4) != 0)
@@ -2083,7 +2294,7 @@ void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
 
         // Save splits.
         in_save_splits(filePath, splitCount, typeMetadata,
-            splitLimit, dataAlignment, endianFlag, deps, pfi);
+            splitLimit, dataAlignment, endianFlag, deps, pfi, pool);
     }
 
     // Open root file and start writing header.
@@ -2101,6 +2312,9 @@ void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     // Finish writing root header.
     header::finish_write(0, (fileMetadata.empty()) ?
         0 : 1, endianFlag, rootFile);
+
+    // Close file.
+    rootFile.close();
 }
 } // v2
 
@@ -2175,7 +2389,7 @@ void header::fix()
 
 static void in_parse(const file_node* fileNodes,
     const file_node* curFileNode, bool skipProxies,
-    char* pathBuf, archive_entry_list& hlArc)
+    bool noAlloc, char* pathBuf, archive_entry_list& hlArc)
 {
     if (curFileNode->hasData)
     {
@@ -2203,8 +2417,16 @@ static void in_parse(const file_node* fileNodes,
             // Add streaming files.
             if (dataEntry.is_proxy_entry())
             {
-                hlArc.emplace_back(archive_entry::make_streaming_file_utf8(
-                    fileName, dataEntry.dataSize));
+                hlArc.add_streaming_file_utf8(
+                    fileName, dataEntry.dataSize);
+            }
+
+            // Add regular files which point directly to the entry's data.
+            // NOTE: This is only done when parsing non-const data, so this is safe.
+            else if (noAlloc)
+            {
+                hlArc.add_file_no_alloc_utf8(fileName, dataEntry.dataSize,
+                    const_cast<void*>(dataEntry.data.get()));
             }
 
             // Add regular files.
@@ -2227,17 +2449,18 @@ static void in_parse(const file_node* fileNodes,
     for (u16 i = 0; i < curFileNode->childCount; ++i)
     {
         in_parse(fileNodes, &fileNodes[childIndices[i]],
-            skipProxies, pathBuf, hlArc);
+            skipProxies, noAlloc, pathBuf, hlArc);
     }
 }
 
-void header::parse(archive_entry_list& hlArc, bool skipProxies) const
+static void in_parse(const header& pac, archive_entry_list& hlArc,
+    bool skipProxies, bool noAlloc)
 {
     // NOTE: PACxV3 names are hard-limited to 255, not including null terminator.
     char pathBuf[256];
 
     // Parse archive entries.
-    const type_tree& typeTree = types();
+    const type_tree& typeTree = pac.types();
     for (u32 i = 0; i < typeTree.dataNodeCount; ++i)
     {
         // Get pointers.
@@ -2246,10 +2469,21 @@ void header::parse(archive_entry_list& hlArc, bool skipProxies) const
         const file_node* fileNodes = fileTree.nodes.get();
 
         // Parse archive entries.
-        in_parse(fileNodes, fileNodes, skipProxies, pathBuf, hlArc);
+        in_parse(fileNodes, fileNodes, skipProxies,
+            noAlloc, pathBuf, hlArc);
     }
 }
 
+void header::parse(archive_entry_list& hlArc, bool skipProxies) const
+{
+    in_parse(*this, hlArc, skipProxies, false);
+}
+
+void header::parse_no_alloc(archive_entry_list& hlArc, bool skipProxies)
+{
+    in_parse(*this, hlArc, skipProxies, true);
+}
+
 static u16 in_get_flags(compress_type compressType) noexcept
 {
     switch (compressType)
@@ -2402,14 +2636,12 @@ void read(blob& pac, archive_entry_list* hlArc,
     }
 }
 
-static void in_load(blob& pac, const nchar* filePath,
-    archive_entry_list* hlArc, std::vector<blob>* pacs)
+template<typename load_dep_func_t>
+static void in_load_deps(const void* pac, const nchar* filePath,
+    load_dep_func_t loadDep)
 {
-    // Read data and parse it as necessary.
-    read(pac, hlArc, pacs);
-
     // Get header pointer, and return early if there are no dependencies.
-    const header* headerPtr = pac.data<header>();
+    const header* headerPtr = static_cast<const header*>(pac);
     if (!headerPtr->depCount) return;
     
     // Load dependencies.
@@ -2429,13 +2661,26 @@ static void in_load(blob& pac, const nchar* filePath,
 #endif
 
         // Load dependency.
-        load_single(pathBuf, hlArc, pacs);
+        loadDep(pathBuf);
 
         // Remove dependency file name from path buffer.
         pathBuf.erase(dirLen);
     }
 }
 
+static void in_load(blob& pac, const nchar* filePath,
+    archive_entry_list* hlArc, std::vector<blob>* pacs)
+{
+    // Read data and parse it as necessary.
+    read(pac, hlArc, pacs);
+
+    // Load dependencies.
+    in_load_deps(pac.data(), filePath, [hlArc, pacs](const nstring& depPath)
+    {
+        load_single(depPath, hlArc, pacs);
+    });
+}
+
 void load(const nchar* filePath, archive_entry_list* hlArc,
     std::vector<blob>* pacs)
 {
@@ -2446,6 +2691,52 @@ void load(const nchar* filePath, archive_entry_list* hlArc,
     in_load(pac, filePath, hlArc, pacs);
 }
 
+static void in_read_mapped(mapped_file& pac, archive_entry_list& hlArc,
+    std::vector<mapped_file>& pacs)
+{
+    // Fix and parse data without copying it.
+    fix(pac.data());
+    parse_no_alloc(pac.data(), hlArc);
+
+    // Keep the mapping alive for as long as the caller needs the entries.
+    pacs.push_back(std::move(pac));
+}
+
+void load_mapped_single(const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs)
+{
+    // Map file into memory.
+    mapped_file pac(filePath);
+
+    // Read data and parse it.
+    in_read_mapped(pac, hlArc, pacs);
+}
+
+static void in_load_mapped(mapped_file& pac, const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs)
+{
+    // Read data and parse it.
+    // NOTE: The pac's data is still valid after being moved into pacs.
+    void* pacData = pac.data();
+    in_read_mapped(pac, hlArc, pacs);
+
+    // Load dependencies.
+    in_load_deps(pacData, filePath, [&hlArc, &pacs](const nstring& depPath)
+    {
+        load_mapped_single(depPath, hlArc, pacs);
+    });
+}
+
+void load_mapped(const nchar* filePath,
+    archive_entry_list& hlArc, std::vector<mapped_file>& pacs)
+{
+    // Map file into memory.
+    mapped_file pac(filePath);
+
+    // Finish loading data and parsing it.
+    in_load_mapped(pac, filePath, hlArc, pacs);
+}
+
 static std::default_random_engine uid_gen_engine = std::default_random_engine(std::random_device()());
 
 u32 generate_uid()
@@ -2458,6 +2749,11 @@ u32 generate_uid()
         dist(uid_gen_engine));
 }
 
+void seed_uid_generator(u32 seed)
+{
+    uid_gen_engine.seed(seed);
+}
+
 /*
     @brief Case-insensitive strncmp which prioritizes
     alphanumeric characters over underscores.
@@ -3440,8 +3736,8 @@ static void in_data_entry_fill_in(const in_file_metadata& file,
 
 static void in_file_data_write(const in_radix_node<const in_file_metadata>& fileNode,
     std::size_t& dataEntryPos, unsigned short splitIndex, bina::ver version,
-    bina::endian_flag endianFlag, u32 dataAlignment,
-    packed_file_info* pfi, off_table& offTable, stream& stream)
+    bina::endian_flag endianFlag, u32 dataAlignment, packed_file_info* pfi,
+    bool isMeasuring, off_table& offTable, stream& stream)
 {
     if (fileNode.data)
     {
@@ -3458,8 +3754,18 @@ static void in_file_data_write(const in_radix_node<const in_file_metadata>& file
             const auto& file = *fileNode.data.get();
             if (file.entry->is_reference_file())
             {
-                tmpDataBuf = file::load(file.entry->path());
-                data = tmpDataBuf.get();
+                // NOTE: If we're only measuring this pac, don't bother loading the
+                // file. Nothing written while measuring is kept, so the only effect
+                // is that the bina_file flag goes unset in the discarded output.
+                if (isMeasuring)
+                {
+                    data = nullptr;
+                }
+                else
+                {
+                    tmpDataBuf = file::load(file.entry->path());
+                    data = tmpDataBuf.get();
+                }
             }
 
             // If this is a regular file, get a pointer to its data.
@@ -3471,8 +3777,8 @@ static void in_file_data_write(const in_radix_node<const in_file_metadata>& file
             // Mark whether this data is BINA data or not.
             // TODO: Do these games actually support BINAV1?
             data_flags flags = data_flags::regular_file;
-            if (bina::has_v2_header(data, file.entry->size()) ||
-                bina::has_v1_header(data, file.entry->size()))
+            if (data && (bina::has_v2_header(data, file.entry->size()) ||
+                bina::has_v1_header(data, file.entry->size())))
             {
                 flags |= data_flags::bina_file;
             }
@@ -3507,45 +3813,45 @@ static void in_file_data_write(const in_radix_node<const in_file_metadata>& file
     for (const auto& child : fileNode.children)
     {
         in_file_data_write(*child.get(), dataEntryPos, splitIndex,
-            version, endianFlag, dataAlignment, pfi, offTable, stream);
+            version, endianFlag, dataAlignment, pfi, isMeasuring, offTable, stream);
     }
 }
 
 static void in_file_data_write(const in_radix_tree<const in_file_metadata>& fileTree,
     std::size_t& dataEntryPos, unsigned short splitIndex, bina::ver version,
-    bina::endian_flag endianFlag, u32 dataAlignment,
-    packed_file_info* pfi, off_table& offTable, stream& stream)
+    bina::endian_flag endianFlag, u32 dataAlignment, packed_file_info* pfi,
+    bool isMeasuring, off_table& offTable, stream& stream)
 {
     in_file_data_write(fileTree.rootNode, dataEntryPos, splitIndex,
-        version, endianFlag, dataAlignment, pfi, offTable, stream);
+        version, endianFlag, dataAlignment, pfi, isMeasuring, offTable, stream);
 }
 
 static void in_file_data_write(const in_radix_node<in_type_tree_metadata>& typeNode,
     std::size_t& dataEntryPos, unsigned short splitIndex, bina::ver version,
-    bina::endian_flag endianFlag, u32 dataAlignment,
-    packed_file_info* pfi, off_table& offTable, stream& stream)
+    bina::endian_flag endianFlag, u32 dataAlignment, packed_file_info* pfi,
+    bool isMeasuring, off_table& offTable, stream& stream)
 {
     if (typeNode.data)
     {
         in_file_data_write(typeNode.data->fileTree, dataEntryPos, splitIndex,
-            version, endianFlag, dataAlignment, pfi, offTable, stream);
+            version, endianFlag, dataAlignment, pfi, isMeasuring, offTable, stream);
     }
 
     // Recurse through child nodes.
     for (const auto& child : typeNode.children)
     {
         in_file_data_write(*child.get(), dataEntryPos, splitIndex,
-            version, endianFlag, dataAlignment, pfi, offTable, stream);
+            version, endianFlag, dataAlignment, pfi, isMeasuring, offTable, stream);
     }
 }
 
 static void in_file_data_write(const in_radix_tree<in_type_tree_metadata>& typeTree,
     std::size_t& dataEntryPos, unsigned short splitIndex, bina::ver version,
-    bina::endian_flag endianFlag, u32 dataAlignment,
-    packed_file_info* pfi, off_table& offTable, stream& stream)
+    bina::endian_flag endianFlag, u32 dataAlignment, packed_file_info* pfi,
+    bool isMeasuring, off_table& offTable, stream& stream)
 {
     in_file_data_write(typeTree.rootNode, dataEntryPos, splitIndex,
-        version, endianFlag, dataAlignment, pfi, offTable, stream);
+        version, endianFlag, dataAlignment, pfi, isMeasuring, offTable, stream);
 }
 
 template<typename dep_list_t>
@@ -3554,7 +3860,7 @@ std::size_t in_write(const bina::ver version, unsigned short splitIndex,
     u32 splitLimit, u32 dataAlignment, bool hasUnknownFlag,
     compress_type compressType, u32 maxChunkSize,
     bina::endian_flag endianFlag, dep_list_t& deps,
-    packed_file_info* pfi, stream& stream)
+    packed_file_info* pfi, bool isMeasuring, stream& stream)
 {
     str_table strTable;
     off_table offTable;
@@ -3649,7 +3955,7 @@ std::size_t in_write(const bina::ver version, unsigned short splitIndex,
     curOffPos = dataEntriesPos;
 
     in_file_data_write(typeTree, curOffPos, splitIndex, version,
-        endianFlag, dataAlignment, pfi, offTable, stream);
+        endianFlag, dataAlignment, pfi, isMeasuring, offTable, stream);
 
     // Finish writing PACx data.
     header::finish_write(0, treesPos, depTablePos, dataEntriesPos,
@@ -3659,33 +3965,45 @@ std::size_t in_write(const bina::ver version, unsigned short splitIndex,
     return depTablePos;
 }
 
+static void in_save_split(const nchar* splitPath,
+    unsigned short splitIndex, u32 uid,
+    const in_type_metadata_list& typeMetadata,
+    u32 splitLimit, u32 dataAlignment, bina::endian_flag endianFlag,
+    in_dep_metadata_list& deps, packed_file_info* pfi)
+{
+    // Open the split file for writing.
+    file_stream splitFile(splitPath, file::mode::write);
+
+    // Write split.
+    in_write(ver_301, splitIndex, uid, typeMetadata,
+        splitLimit, dataAlignment, false, compress_type::none,
+        0, endianFlag, deps, pfi, false, splitFile);
+
+    // Close file.
+    splitFile.close();
+}
+
 static void in_save_splits(const nchar* filePath, u32 uid,
     unsigned short splitCount, const in_type_metadata_list& typeMetadata,
     u32 splitLimit, u32 dataAlignment, bina::endian_flag endianFlag,
-    in_dep_metadata_list& deps, packed_file_info* pfi)
+    in_dep_metadata_list& deps, packed_file_info* pfi, thread_pool* pool)
 {
-    // Reserve space in advance for dependency metadata.
+    // Reserve space in advance for split paths and dependency metadata.
+    std::vector<nstring> splitPaths;
+    splitPaths.reserve(splitCount);
     deps.reserve(splitCount);
 
     // Setup initial split path buffer.
     nstring splitPathBuf(filePath);
     splitPathBuf += HL_NTEXT(".000");
 
-    // Write splits.
+    // Generate split paths and dependency metadata.
     const nchar* splitName = path::get_name(splitPathBuf);
     path::split_iterator3<> splitIt = path::split_iterator3<>(splitPathBuf);
 
     for (unsigned short splitIndex = 0; splitIndex < splitCount; ++splitIndex)
     {
-        // Open the next split file for writing.
-        file_stream splitFile(*splitIt, file::mode::write);
-
-        // Write split.
-        in_write(ver_301, splitIndex, uid, typeMetadata,
-            splitLimit, dataAlignment, false, compress_type::none,
-            0, endianFlag, deps, pfi, splitFile);
-
-        // Generate dependency metadata.
+        splitPaths.emplace_back(splitPathBuf);
         deps.emplace_back(text::conv<text::native_to_utf8>(splitName));
 
         // Increase the number in the split extension.
@@ -3695,6 +4013,38 @@ static void in_save_splits(const nchar* filePath, u32 uid,
             throw out_of_range_exception();
         }
     }
+
+    // Write splits one-by-one if we weren't given a thread pool.
+    if (!pool)
+    {
+        for (unsigned short splitIndex = 0; splitIndex < splitCount; ++splitIndex)
+        {
+            in_save_split(splitPaths[splitIndex].c_str(), splitIndex,
+                uid, typeMetadata, splitLimit, dataAlignment,
+                endianFlag, deps, pfi);
+        }
+
+        return;
+    }
+
+    // Otherwise, write splits in parallel. Each split is written straight to its
+    // own file, so at most one split per thread is being generated at a time.
+    std::vector<packed_file_info> splitPfis((pfi) ? splitCount : 0);
+    pool->parallel_for(splitCount, [&](std::size_t splitIndex)
+    {
+        in_save_split(splitPaths[splitIndex].c_str(),
+            static_cast<unsigned short>(splitIndex), uid, typeMetadata,
+            splitLimit, dataAlignment, endianFlag, deps,
+            (pfi) ? &splitPfis[splitIndex] : nullptr);
+    });
+
+    // Merge packed file info in order if necessary.
+    for (auto& splitPfi : splitPfis)
+    {
+        pfi->insert(pfi->end(),
+            std::make_move_iterator(splitPfi.begin()),
+            std::make_move_iterator(splitPfi.end()));
+    }
 }
 
 static bool in_generate_metadata(const archive_entry_list& arc,
@@ -3805,7 +4155,7 @@ static bool in_generate_metadata(const archive_entry_list& arc,
 void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     const supported_ext* exts, const std::size_t extCount,
     const nchar* filePath, u32 splitLimit, u32 dataAlignment,
-    packed_file_info* pfi)
+    packed_file_info* pfi, thread_pool* pool)
 {
     // Verify that dataAlignment is a multiple of 4.
     if ((dataAlignment % 4) != 0)
@@ -3843,14 +4193,17 @@ void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
 
         // Save splits.
         in_save_splits(filePath, uid, splitCount, typeMetadata,
-            splitLimit, dataAlignment, endianFlag, deps, pfi);
+            splitLimit, dataAlignment, endianFlag, deps, pfi, pool);
     }
 
     // Save root.
     file_stream rootFile(filePath, file::mode::write);
     in_write(ver_301, USHRT_MAX, uid, typeMetadata,
         splitLimit, dataAlignment, false, compress_type::none,
-        0, endianFlag, deps, pfi, rootFile);
+        0, endianFlag, deps, pfi, false, rootFile);
+
+    // Close file.
+    rootFile.close();
 }
 } // v3
 
@@ -3859,17 +4212,18 @@ namespace v4
 struct in_dep_metadata
 {
     std::string name;
-    std::unique_ptr<u8[]> compressedData;
     std::size_t compressedSize = 0;
     std::size_t uncompressedSize = 0;
+    std::size_t chunksPos = 0;
     std::vector<chunk> chunks;
+    bool compressed = false;
 
     in_dep_metadata() = default;
     in_dep_metadata(const std::string& name) : name(name) {}
 
     bool is_compressed() const noexcept
     {
-        return (compressedSize != uncompressedSize);
+        return compressed;
     }
 
     void lz4_write_placeholder_chunks(u32 maxChunkSize, stream& stream) const
@@ -3919,10 +4273,10 @@ struct in_dep_metadata
         stream.write_arr(chunks.size(), chunks.data());
     }
 
-    void lz4_write_chunks(u32 maxChunkSize, stream& stream) const
+    void lz4_write_chunks(u32 maxChunkSize, stream& stream)
     {
         // Write placeholder chunks.
-        const std::size_t chunksPos = stream.tell();
+        chunksPos = stream.tell();
         lz4_write_placeholder_chunks(maxChunkSize, stream);
 
         // Jump to chunks position.
@@ -3936,23 +4290,35 @@ struct in_dep_metadata
         stream.jump_to(endPos);
     }
 
-    void set_data_compress(compress_type compressType,
-        u32 maxChunkSize, std::size_t uncompressedSize,
-        const void* uncompressedData)
+    void set_size(compress_type compressType, u32 maxChunkSize,
+        std::size_t uncompressedSize, bool compress)
     {
         this->uncompressedSize = uncompressedSize;
+        compressed = compress;
+        chunks.clear();
+
+        // Uncompressed data is stored as-is, in a single chunk.
+        if (!compress)
+        {
+            compressedSize = uncompressedSize;
+            chunks.emplace_back(
+                static_cast<u32>(uncompressedSize),
+                static_cast<u32>(uncompressedSize));
+
+            return;
+        }
 
+        // The compressed size isn't known until the data is written, but the
+        // amount of chunks is, so placeholder chunks can be generated for now.
+        compressedSize = 0;
         switch (compressType)
         {
         case compress_type::lz4:
-            compressedData = compress_lz4(maxChunkSize,
-                uncompressedSize, uncompressedData,
-                compressedSize, chunks);
+            chunks.resize((uncompressedSize + (maxChunkSize - 1)) /
+                maxChunkSize, chunk(0, 0));
             break;
 
         case compress_type::deflate:
-            compressedData = compress_deflate(uncompressedSize,
-                uncompressedData, compressedSize);
             break;
 
         default:
@@ -3960,16 +4326,34 @@ struct in_dep_metadata
         }
     }
 
-    void set_data_no_compress(std::size_t uncompressedSize, void* uncompressedData)
+    void write_data(compress_type compressType, u32 maxChunkSize,
+        const void* uncompressedData, stream& stream,
+        thread_pool* pool = nullptr)
     {
-        this->compressedSize = uncompressedSize;
-        this->uncompressedSize = uncompressedSize;
+        // Write uncompressed data as-is.
+        if (!is_compressed())
+        {
+            stream.write_all(uncompressedSize, uncompressedData);
+            return;
+        }
 
-        compressedData.reset(static_cast<u8*>(uncompressedData));
+        // Compress data straight into the stream.
+        switch (compressType)
+        {
+        case compress_type::lz4:
+            chunks.clear();
+            compressedSize = compress_to_stream_lz4(maxChunkSize,
+                uncompressedSize, uncompressedData, stream, chunks, pool);
+            break;
 
-        chunks.emplace_back(
-            static_cast<u32>(uncompressedSize),
-            static_cast<u32>(uncompressedSize));
+        case compress_type::deflate:
+            compressedSize = compress_to_stream_deflate(
+                uncompressedSize, uncompressedData, stream);
+            break;
+
+        default:
+            throw std::runtime_error("PACx does not support the given compression type");
+        }
     }
 };
 
@@ -3991,7 +4375,7 @@ struct in_dep_metadata_list : public std::vector<in_dep_metadata>
     }
 
     void lz4_write(u32 maxChunkSize, bina::endian_flag endianFlag,
-        str_table& strTable, off_table& offTable, stream& stream) const
+        str_table& strTable, off_table& offTable, stream& stream)
     {
         // Generate dependency table.
         const std::size_t depTablePos = stream.tell();
@@ -4041,7 +4425,7 @@ struct in_dep_metadata_list : public std::vector<in_dep_metadata>
         }
 
         // Write chunks and fill-in dependency entries.
-        for (const auto& dep : *this)
+        for (auto& dep : *this)
         {
             // Add name to string table.
             if (!dep.name.empty())
@@ -4125,7 +4509,7 @@ struct in_dep_metadata_list : public std::vector<in_dep_metadata>
 
     void write(compress_type compressType, u32 maxChunkSize,
         bina::endian_flag endianFlag, str_table& strTable,
-        off_table& offTable, stream& stream) const
+        off_table& offTable, stream& stream)
     {
         switch (compressType)
         {
@@ -4138,177 +4522,285 @@ struct in_dep_metadata_list : public std::vector<in_dep_metadata>
             break;
         }
     }
+};
 
-    void lz4_write_split_data(std::size_t rootDepTablePos,
-        bina::endian_flag endianFlag, stream& rootInternalFile,
-        stream& stream)
-    {
-        std::size_t curOffPos = (rootDepTablePos + sizeof(lz4_dep_table));
-        for (const auto& dep : *this)
-        {
-            // Get split position and endian-swap it if necessary.
-            u32 splitPos = static_cast<u32>(stream.tell());
-            if (bina::needs_swap(endianFlag))
-            {
-                hl::endian_swap(splitPos);
-            }
+static std::size_t in_measure_split(bina::ver version,
+    unsigned short splitIndex, u32 uid,
+    const v3::in_type_metadata_list& typeMetadata,
+    u32 splitLimit, u32 dataAlignment, u32 maxChunkSize,
+    compress_type compressType, bool hasUnknownFlag,
+    bina::endian_flag endianFlag, in_dep_metadata_list& deps)
+{
+    // Measure internal split data without actually storing it anywhere.
+    in_size_stream internalFile;
+    v3::in_write(version, splitIndex, uid, typeMetadata,
+        splitLimit, dataAlignment, hasUnknownFlag,
+        compressType, maxChunkSize, endianFlag, deps,
+        nullptr, true, internalFile);
 
-            // Jump to split data position within root internal data.
-            rootInternalFile.jump_to(curOffPos + offsetof(
-                lz4_dep_info, dataPos));
+    return internalFile.get_size();
+}
 
-            // Fix split data position within root internal data.
-            rootInternalFile.write_obj(splitPos);
+static void in_measure_splits(const nchar* pacName,
+    bina::ver version, u32 uid, unsigned short splitCount,
+    const v3::in_type_metadata_list& typeMetadata,
+    u32 splitLimit, u32 dataAlignment, u32 maxChunkSize,
+    compress_type compressType, bool hasUnknownFlag,
+    bina::endian_flag endianFlag, std::size_t* splitsSize,
+    in_dep_metadata_list& deps, thread_pool* pool)
+{
+    // Reserve space in advance for dependency metadata.
+    deps.reserve(splitCount);
 
-            // Increase current offset position.
-            curOffPos += sizeof(lz4_dep_info);
+    // Setup initial split name buffer.
+    std::string splitName = text::conv<text::native_to_utf8>(pacName);
+    splitName += ".000";
 
-            // Write split data.
-            stream.write_all(dep.compressedSize,
-                dep.compressedData.get());
+    // Generate dependency metadata.
+    auto splitIt = path::split_iterator3<char>(splitName);
+    for (unsigned short splitIndex = 0; splitIndex < splitCount; ++splitIndex)
+    {
+        deps.emplace_back((version.rev >= '5') ? std::string() : splitName);
 
-            // Pad file.
-            stream.pad(16);
+        // Increase the number in the split extension.
+        if (++splitIt == splitIt.end())
+        {
+            // Raise an error if we exceeded 999 splits.
+            throw out_of_range_exception();
         }
     }
 
-    void deflate_write_split_data(std::size_t rootDepTablePos,
-        bina::endian_flag endianFlag, stream& rootInternalFile,
-        stream& stream)
+    // Measure splits, in parallel if we were given a thread pool.
+    std::vector<std::size_t> splitUncompressedSizes(splitCount);
+    const auto measureSplit = [&](std::size_t splitIndex)
     {
-        std::size_t curOffPos = (rootDepTablePos + sizeof(deflate_dep_table));
-        for (const auto& dep : *this)
-        {
-            // Get split position and endian-swap it if necessary.
-            u32 splitPos = static_cast<u32>(stream.tell());
-            if (bina::needs_swap(endianFlag))
-            {
-                hl::endian_swap(splitPos);
-            }
-
-            // Jump to split data position within root internal data.
-            rootInternalFile.jump_to(curOffPos + offsetof(
-                deflate_dep_info, dataPos));
-
-            // Fix split data position within root internal data.
-            rootInternalFile.write_obj(splitPos);
-
-            // Increase current offset position.
-            curOffPos += sizeof(deflate_dep_info);
-
-            // Write split data.
-            stream.write_all(dep.compressedSize,
-                dep.compressedData.get());
+        splitUncompressedSizes[splitIndex] = in_measure_split(version,
+            static_cast<unsigned short>(splitIndex), uid, typeMetadata,
+            splitLimit, dataAlignment, maxChunkSize, compressType,
+            hasUnknownFlag, endianFlag, deps);
+    };
 
-            // Pad file.
-            stream.pad(16);
+    if (pool)
+    {
+        pool->parallel_for(splitCount, measureSplit);
+    }
+    else
+    {
+        for (std::size_t splitIndex = 0; splitIndex < splitCount; ++splitIndex)
+        {
+            measureSplit(splitIndex);
         }
     }
 
-    void write_split_data(compress_type compressType,
-        std::size_t rootDepTablePos, bina::endian_flag endianFlag,
-        stream& rootInternalFile, stream& stream)
+    // Set split sizes and placeholder chunks.
+    for (unsigned short splitIndex = 0; splitIndex < splitCount; ++splitIndex)
     {
-        switch (compressType)
+        // Determine whether this split will need to be compressed.
+        const std::size_t splitUncompressedSize = splitUncompressedSizes[splitIndex];
+        bool compress = false;
+
+        if (splitsSize)
         {
-        case compress_type::lz4:
-            lz4_write_split_data(rootDepTablePos,
-                endianFlag, rootInternalFile, stream);
-            break;
+            // Increase total uncompressed splits size.
+            *splitsSize += splitUncompressedSize;
 
-        case compress_type::deflate:
-            deflate_write_split_data(rootDepTablePos,
-                endianFlag, rootInternalFile, stream);
-            break;
+            // Compress data if the total size has exceeded maxChunkSize.
+            compress = (*splitsSize > maxChunkSize);
         }
+
+        deps[splitIndex].set_size(compressType, maxChunkSize,
+            splitUncompressedSize, compress);
     }
-};
+}
 
-static void in_generate_split_data(bina::ver version,
+static void in_generate_split(bina::ver version,
     unsigned short splitIndex, u32 uid,
     const v3::in_type_metadata_list& typeMetadata,
     u32 splitLimit, u32 dataAlignment, u32 maxChunkSize,
     compress_type compressType, bool hasUnknownFlag,
-    bina::endian_flag endianFlag, std::size_t* splitsSize,
-    in_dep_metadata_list& deps)
+    bina::endian_flag endianFlag, in_dep_metadata_list& deps,
+    mem_stream& internalFile)
 {
     // Write internal split data.
-    mem_stream internalFile;
+    internalFile.reopen(deps[splitIndex].uncompressedSize);
     v3::in_write(version, splitIndex, uid, typeMetadata,
         splitLimit, dataAlignment, hasUnknownFlag,
         compressType, maxChunkSize, endianFlag, deps,
-        nullptr, internalFile);
+        nullptr, false, internalFile);
 
-    // Compress PACx data if necessary.
-    const std::size_t splitUncompressedSize = internalFile.get_size();
-    if (splitsSize)
+    // Ensure the split is still the size we measured it to be.
+    if (internalFile.get_size() != deps[splitIndex].uncompressedSize)
     {
-        // Increase total uncompressed splits size.
-        *splitsSize += splitUncompressedSize;
+        throw std::runtime_error("PACx split size does not match its measured size");
+    }
+}
 
-        // Compress data if the total size has exceeded maxChunkSize.
-        if (*splitsSize > maxChunkSize)
-        {
-            deps[splitIndex].set_data_compress(compressType,
-                maxChunkSize, splitUncompressedSize,
-                internalFile.get_data_ptr());
+template<typename dep_info_t>
+static void in_fill_in_split(std::size_t depInfoPos,
+    std::size_t splitPos, const in_dep_metadata& dep,
+    compress_type compressType, bina::endian_flag endianFlag,
+    stream& rootInternalFile)
+{
+    // Get split values and endian-swap them if necessary.
+    u32 compressedSize = static_cast<u32>(dep.compressedSize);
+    u32 dataPos = static_cast<u32>(splitPos);
 
-            return;
-        }
+    if (bina::needs_swap(endianFlag))
+    {
+        hl::endian_swap(compressedSize);
+        hl::endian_swap(dataPos);
     }
 
-    // Otherwise, get copy of uncompressed PACx data.
-    deps[splitIndex].set_data_no_compress(
-        splitUncompressedSize, internalFile.release());
+    // Fill-in split values within root internal data.
+    rootInternalFile.jump_to(depInfoPos + offsetof(
+        dep_info_t, compressedSize));
+
+    rootInternalFile.write_obj(compressedSize);
+
+    rootInternalFile.jump_to(depInfoPos + offsetof(
+        dep_info_t, dataPos));
+
+    rootInternalFile.write_obj(dataPos);
+
+    // Fill-in "real" chunks within root internal data if necessary.
+    if (compressType == compress_type::lz4)
+    {
+        rootInternalFile.jump_to(dep.chunksPos);
+        dep.lz4_fill_in_chunks(rootInternalFile);
+    }
 }
 
-static void in_generate_splits(const nchar* pacName,
-    bina::ver version, u32 uid, unsigned short splitCount,
+template<typename dep_info_t, typename dep_table_t>
+static void in_write_split_data(bina::ver version, u32 uid,
     const v3::in_type_metadata_list& typeMetadata,
     u32 splitLimit, u32 dataAlignment, u32 maxChunkSize,
     compress_type compressType, bool hasUnknownFlag,
-    bina::endian_flag endianFlag, std::size_t* splitsSize,
-    in_dep_metadata_list& deps)
+    bina::endian_flag endianFlag, std::size_t rootDepTablePos,
+    in_dep_metadata_list& deps, stream& rootInternalFile,
+    stream& stream, thread_pool* pool)
 {
-    // Reserve space in advance for dependency metadata.
-    deps.reserve(splitCount);
+    std::size_t curOffPos = (rootDepTablePos + sizeof(dep_table_t));
 
-    // Setup initial split name buffer.
-    std::string splitName = text::conv<text::native_to_utf8>(pacName);
-    splitName += ".000";
+    // Write splits one-by-one if we weren't given a thread pool.
+    // NOTE: Only one split is ever held in memory at a time; each one
+    // is re-generated, written (compressing it as necessary), and freed.
+    if (!pool)
+    {
+        mem_stream internalFile;
+        for (std::size_t splitIndex = 0; splitIndex < deps.size(); ++splitIndex)
+        {
+            auto& dep = deps[splitIndex];
 
-    // Write splits.
-    auto splitIt = path::split_iterator3<char>(splitName);
-    for (unsigned short splitIndex = 0; splitIndex < splitCount; ++splitIndex)
+            // Generate internal split data.
+            in_generate_split(version, static_cast<unsigned short>(splitIndex),
+                uid, typeMetadata, splitLimit, dataAlignment, maxChunkSize,
+                compressType, hasUnknownFlag, endianFlag, deps, internalFile);
+
+            // Write split data, compressing it as necessary.
+            const std::size_t splitPos = stream.tell();
+            dep.write_data(compressType, maxChunkSize,
+                internalFile.get_data_ptr(), stream);
+
+            // Pad file.
+            stream.pad(16);
+
+            // Fill-in split values within root internal data.
+            in_fill_in_split<dep_info_t>(curOffPos, splitPos,
+                dep, compressType, endianFlag, rootInternalFile);
+
+            // Increase current offset position.
+            curOffPos += sizeof(dep_info_t);
+        }
+
+        return;
+    }
+
+    // Otherwise, generate and compress splits in parallel, in batches no larger
+    // than the pool's concurrency to avoid holding every split in memory at once.
+    const std::size_t batchSize = pool->concurrency();
+    std::vector<mem_stream> splitFiles(std::min<std::size_t>(
+        batchSize, deps.size()));
+
+    for (std::size_t batchStart = 0; batchStart < deps.size();
+        batchStart += batchSize)
     {
-        // Generate dependency metadata.
-        deps.emplace_back((version.rev >= '5') ? std::string() : splitName);
+        const std::size_t curBatchSize = std::min<std::size_t>(
+            batchSize, deps.size() - batchStart);
 
-        // Generate dependency pac data.
-        in_generate_split_data(version, splitIndex, uid,
-            typeMetadata, splitLimit, dataAlignment, maxChunkSize,
-            compressType, hasUnknownFlag, endianFlag, splitsSize, deps);
+        // Generate and compress split data.
+        pool->parallel_for(curBatchSize, [&](std::size_t i)
+        {
+            const std::size_t splitIndex = (batchStart + i);
+            mem_stream internalFile;
 
-        // Increase the number in the split extension.
-        if (++splitIt == splitIt.end())
+            in_generate_split(version, static_cast<unsigned short>(splitIndex),
+                uid, typeMetadata, splitLimit, dataAlignment, maxChunkSize,
+                compressType, hasUnknownFlag, endianFlag, deps, internalFile);
+
+            splitFiles[i].reopen();
+            deps[splitIndex].write_data(compressType, maxChunkSize,
+                internalFile.get_data_ptr(), splitFiles[i]);
+        });
+
+        // Write split data in order so the output is identical
+        // to what would've been written without a thread pool.
+        for (std::size_t i = 0; i < curBatchSize; ++i)
         {
-            // Raise an error if we exceeded 999 splits.
-            throw out_of_range_exception();
+            const std::size_t splitPos = stream.tell();
+            stream.write_all(splitFiles[i].get_size(),
+                splitFiles[i].get_data_ptr());
+
+            // Pad file.
+            stream.pad(16);
+
+            // Fill-in split values within root internal data.
+            in_fill_in_split<dep_info_t>(curOffPos, splitPos,
+                deps[batchStart + i], compressType, endianFlag,
+                rootInternalFile);
+
+            // Increase current offset position.
+            curOffPos += sizeof(dep_info_t);
         }
     }
 }
 
-void in_read_deps(const v4::header* header, const v3::header* rootHeader,
-    archive_entry_list* hlArc, std::vector<blob>* pacs)
+static void in_write_splits(bina::ver version, u32 uid,
+    const v3::in_type_metadata_list& typeMetadata,
+    u32 splitLimit, u32 dataAlignment, u32 maxChunkSize,
+    compress_type compressType, bool hasUnknownFlag,
+    bina::endian_flag endianFlag, std::size_t rootDepTablePos,
+    in_dep_metadata_list& deps, stream& rootInternalFile,
+    stream& stream, thread_pool* pool)
 {
-    if ((header->flagsV3 & static_cast<u16>(
-        v3::pac_flags::lz4_compressed)) != 0)
+    switch (compressType)
     {
-        // Get lz4-compressed dependency table.
-        const lz4_dep_table& deps = *reinterpret_cast<
-            const lz4_dep_table*>(rootHeader->dep_table());
+    case compress_type::lz4:
+        in_write_split_data<lz4_dep_info, lz4_dep_table>(version,
+            uid, typeMetadata, splitLimit, dataAlignment, maxChunkSize,
+            compressType, hasUnknownFlag, endianFlag, rootDepTablePos,
+            deps, rootInternalFile, stream, pool);
+        break;
+
+    case compress_type::deflate:
+        in_write_split_data<deflate_dep_info, deflate_dep_table>(version,
+            uid, typeMetadata, splitLimit, dataAlignment, maxChunkSize,
+            compressType, hasUnknownFlag, endianFlag, rootDepTablePos,
+            deps, rootInternalFile, stream, pool);
+        break;
+    }
+
+    // Jump back to end of root internal data.
+    rootInternalFile.jump_to(rootInternalFile.get_size());
+}
 
-        // Read splits.
+template<typename dep_table_t>
+static void in_read_deps(const v4::header* header,
+    const dep_table_t& deps, archive_entry_list* hlArc,
+    std::vector<blob>* pacs, thread_pool* pool)
+{
+    // Read splits one-by-one if we weren't given a thread pool.
+    if (!pool)
+    {
         for (const auto& depInfo : deps)
         {
             // Uncompress split data.
@@ -4317,33 +4809,67 @@ void in_read_deps(const v4::header* header, const v3::header* rootHeader,
             // Read split pac.
             v3::read(uncompressedSplit, hlArc, pacs);
         }
+
+        return;
     }
-    else
+
+    // Otherwise, uncompress splits in parallel, in batches no larger than
+    // the pool's concurrency to avoid holding every split in memory at once.
+    const std::size_t batchSize = pool->concurrency();
+    std::vector<std::unique_ptr<blob>> uncompressedSplits(
+        std::min<std::size_t>(batchSize, deps.count));
+
+    for (std::size_t batchStart = 0; batchStart < deps.count;
+        batchStart += batchSize)
     {
-        // Get deflate-compressed dependency table.
-        const deflate_dep_table& deps = *reinterpret_cast<
-            const deflate_dep_table*>(rootHeader->dep_table());
+        const std::size_t curBatchSize = std::min<std::size_t>(
+            batchSize, deps.count - batchStart);
 
-        // Read splits.
-        for (const auto& depInfo : deps)
+        // Uncompress split data.
+        pool->parallel_for(curBatchSize, [&](std::size_t i)
         {
-            // Uncompress split data.
-            blob uncompressedSplit = depInfo.decompress_dep(header);
+            uncompressedSplits[i] = std::make_unique<blob>(
+                deps[batchStart + i].decompress_dep(header, pool));
+        });
 
-            // Read split pac.
-            v3::read(uncompressedSplit, hlArc, pacs);
+        // Read split pacs in order so that entries are still
+        // added to the archive in the same order as before.
+        for (std::size_t i = 0; i < curBatchSize; ++i)
+        {
+            v3::read(*uncompressedSplits[i], hlArc, pacs);
+            uncompressedSplits[i].reset();
         }
     }
 }
 
-blob lz4_dep_info::decompress_dep(const void* pac) const
+void in_read_deps(const v4::header* header, const v3::header* rootHeader,
+    archive_entry_list* hlArc, std::vector<blob>* pacs, thread_pool* pool)
+{
+    if ((header->flagsV3 & static_cast<u16>(
+        v3::pac_flags::lz4_compressed)) != 0)
+    {
+        // Read lz4-compressed splits.
+        in_read_deps(header, *reinterpret_cast<const lz4_dep_table*>(
+            rootHeader->dep_table()), hlArc, pacs, pool);
+    }
+    else
+    {
+        // Read deflate-compressed splits.
+        in_read_deps(header, *reinterpret_cast<const deflate_dep_table*>(
+            rootHeader->dep_table()), hlArc, pacs, pool);
+    }
+}
+
+blob lz4_dep_info::decompress_dep(const void* pac, thread_pool* pool) const
 {
     return decompress_lz4_blob(chunkCount, chunks.get(),
-        compressedSize, ptradd(pac, dataPos), uncompressedSize);
+        compressedSize, ptradd(pac, dataPos), uncompressedSize, pool);
 }
 
-blob deflate_dep_info::decompress_dep(const void* pac) const
+blob deflate_dep_info::decompress_dep(const void* pac, thread_pool* pool) const
 {
+    // NOTE: Deflate splits are a single stream, so they can only
+    // be uncompressed in parallel with other splits, not by themselves.
     return decompress_deflate_blob(compressedSize,
         ptradd(pac, dataPos), uncompressedSize);
 }
@@ -4373,14 +4899,14 @@ void header::fix()
     }
 }
 
-blob header::decompress_root() const
+blob header::decompress_root(thread_pool* pool) const
 {
     // Decompress root pac and return it.
     if ((flagsV3 & static_cast<u16>(
         v3::pac_flags::lz4_compressed)) != 0)
     {
         return decompress_lz4_blob(root_chunks()->count, root_chunks()->chunks(),
-            rootCompressedSize, root.get(), rootUncompressedSize);
+            rootCompressedSize, root.get(), rootUncompressedSize, pool);
     }
     else if (rootCompressedSize == rootUncompressedSize)
     {
@@ -4477,13 +5003,13 @@ void header::finish_write(std::size_t headerPos,
 }
 
 void read(void* pac, archive_entry_list* hlArc,
-    std::vector<blob>* pacs, bool readSplits)
+    std::vector<blob>* pacs, bool readSplits, thread_pool* pool)
 {
     // Fix PACxV402 data.
     fix(pac);
 
     // Uncompress root data.
-    blob uncompressedRoot = decompress_root(pac);
+    blob uncompressedRoot = decompress_root(pac, pool);
 
     // Read root pac.
     v3::read(uncompressedRoot, hlArc, pacs);
@@ -4497,7 +5023,7 @@ void read(void* pac, archive_entry_list* hlArc,
 
         // Read dependencies.
         in_read_deps(static_cast<v4::header*>(pac),
-            rootHeader, hlArc, pacs);
+            rootHeader, hlArc, pacs, pool);
     }
 }
 
@@ -4505,7 +5031,8 @@ void write(const archive_entry_list& arc,
     const nchar* pacName, u32 maxChunkSize,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
-    stream& stream, u32 splitLimit, u32 dataAlignment, bool noCompress)
+    stream& stream, u32 splitLimit, u32 dataAlignment, bool noCompress,
+    thread_pool* pool)
 {
     // Verify that dataAlignment is a multiple of 4.
     if ((dataAlignment % 4) != 0)
@@ -4534,17 +5061,17 @@ void write(const archive_entry_list& arc,
     // Generate PACx unique identifier.
     const u32 uid = v3::generate_uid();
 
-    // Generate splits if necessary.
+    // Measure splits if necessary.
     in_dep_metadata_list deps;
     std::size_t totalSize = 0;
 
     if (splitCount)
     {
-        in_generate_splits(pacName, ver_402, uid,
+        in_measure_splits(pacName, ver_402, uid,
             splitCount, typeMetadata, splitLimit,
             dataAlignment, maxChunkSize, compressType,
             false, endianFlag, ((noCompress) ?
-                nullptr : &totalSize), deps);
+                nullptr : &totalSize), deps, pool);
     }
 
     // Generate internal root data.
@@ -4554,15 +5081,15 @@ void write(const archive_entry_list& arc,
     const std::size_t rootDepTablePos = v3::in_write(ver_402,
         USHRT_MAX, uid, typeMetadata, splitLimit, dataAlignment,
         true, compressType, maxChunkSize, endianFlag, deps,
-        nullptr, rootInternalFile);
+        nullptr, false, rootInternalFile);
 
-    const std::size_t rootUncompressedSize = rootInternalFile.get_size();
-    rootDepInfo.uncompressedSize = rootUncompressedSize;
+    const bool compressRoot = (!noCompress && totalSize > maxChunkSize);
+    rootDepInfo.set_size(compressType, maxChunkSize,
+        rootInternalFile.get_size(), compressRoot);
 
     // Start writing header.
     const std::size_t headerPos = stream.tell();
-    const bool hasCompressed = (deps.has_compressed_dep() ||
-        (!noCompress && totalSize > maxChunkSize));
+    const bool hasCompressed = (deps.has_compressed_dep() || compressRoot);
 
     const compress_type rootCompressType =
         (!hasCompressed && compressType != compress_type::none) ?
@@ -4589,30 +5116,22 @@ void write(const archive_entry_list& arc,
     // Pad file.
     stream.pad(16);
 
-    // Write splits and fix split positions within root internal data.
-    deps.write_split_data(compressType, rootDepTablePos,
-        endianFlag, rootInternalFile, stream);
-
-    // Compress root data if necessary.
-    if (!noCompress && totalSize > maxChunkSize)
-    {
-        rootDepInfo.set_data_compress(compressType,
-            maxChunkSize, rootUncompressedSize,
-            rootInternalFile.get_data_ptr());
-    }
+    // Write splits and fill-in split values within root internal data.
+    in_write_splits(ver_402, uid, typeMetadata, splitLimit,
+        dataAlignment, maxChunkSize, compressType, false,
+        endianFlag, rootDepTablePos, deps, rootInternalFile,
+        stream, pool);
 
-    // Otherwise, get pointer to uncompressed root data.
-    else
-    {
-        rootDepInfo.set_data_no_compress(
-            rootUncompressedSize,
-            rootInternalFile.release());
-    }
-
-    // Write root data.
+    // Write root data, compressing it as necessary.
     const std::size_t rootPos = stream.tell();
-    stream.write_all(rootDepInfo.compressedSize,
-        rootDepInfo.compressedData.get());
+    // NOTE: Splits are already compressed in parallel with each other,
+    // but the root is compressed on its own, so its LZ4 chunks are
+    // compressed in parallel instead. (Deflate data is still compressed as
+    // a single stream, since compressing it in blocks would change the output.)
+    rootDepInfo.write_data(compressType, maxChunkSize,
+        rootInternalFile.get_data_ptr(), stream, pool);
+
+    rootInternalFile.close();
 
     // Fill-in root chunks if necessary.
     if (rootCompressType == compress_type::lz4)
@@ -4643,7 +5162,8 @@ void save(archive_entry_list& arc, u32 maxChunkSize,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     const nchar* filePath, u32 splitLimit,
-    u32 dataAlignment, bool noCompress)
+    u32 dataAlignment, bool noCompress,
+    thread_pool* pool)
 {
     // Open file for writing.
     file_stream file(filePath, file::mode::write);
@@ -4651,7 +5171,10 @@ void save(archive_entry_list& arc, u32 maxChunkSize,
     // Write PACxV402 data to file.
     write(arc, path::get_name(filePath), maxChunkSize,
         compressType, endianFlag, extCount, exts, file,
-        splitLimit, dataAlignment, noCompress);
+        splitLimit, dataAlignment, noCompress, pool);
+
+    // Close file.
+    file.close();
 }
 } // v02
 
@@ -4786,7 +5309,7 @@ void header::fix()
     }
 }
 
-blob header::decompress_root() const
+blob header::decompress_root(thread_pool* pool) const
 {
     // Decompress root pac and return it.
     if ((flagsV3 & static_cast<u16>(
@@ -4796,7 +5319,7 @@ blob header::decompress_root() const
         {
             const chunk_table* chunkTable = metadata()->chunk_table();
             return decompress_lz4_blob(chunkTable->count, chunkTable->chunks(),
-                rootCompressedSize, root.get(), rootUncompressedSize);
+                rootCompressedSize, root.get(), rootUncompressedSize, pool);
         }
         else
         {
@@ -4898,7 +5421,7 @@ void header::finish_write(std::size_t headerPos,
 
 void read(void* pac, archive_entry_list* hlArc,
     std::vector<blob>* pacs, bool readSplits,
-    std::vector<std::string>* parentPaths)
+    std::vector<std::string>* parentPaths, thread_pool* pool)
 {
     // Fix PACxV403 data.
     fix(pac);
@@ -4915,7 +5438,7 @@ void read(void* pac, archive_entry_list* hlArc,
     }
 
     // Uncompress root data.
-    blob uncompressedRoot = decompress_root(pac);
+    blob uncompressedRoot = decompress_root(pac, pool);
 
     // Read root pac.
     v3::read(uncompressedRoot, hlArc, pacs);
@@ -4928,7 +5451,7 @@ void read(void* pac, archive_entry_list* hlArc,
         if (!rootHeader->depCount) return;
 
         // Read dependencies.
-        in_read_deps(headerPtr, rootHeader, hlArc, pacs);
+        in_read_deps(headerPtr, rootHeader, hlArc, pacs, pool);
     }
 }
 
@@ -4985,7 +5508,8 @@ void in_write(hl::bina::ver version, const archive_entry_list& arc,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     stream& stream, u32 splitLimit, u32 dataAlignment,
-    bool noCompress)
+    bool noCompress,
+    thread_pool* pool)
 {
     // Verify that dataAlignment is a multiple of 4.
     if ((dataAlignment % 4) != 0)
@@ -5014,17 +5538,17 @@ void in_write(hl::bina::ver version, const archive_entry_list& arc,
     // Generate PACx unique identifier.
     const u32 uid = v3::generate_uid();
 
-    // Generate splits if necessary.
+    // Measure splits if necessary.
     in_dep_metadata_list deps;
     std::size_t totalSize = 0;
 
     if (splitCount)
     {
-        in_generate_splits(pacName, (version.rev >= '5') ? version : ver_402, uid,
+        in_measure_splits(pacName, (version.rev >= '5') ? version : ver_402, uid,
             splitCount, typeMetadata, splitLimit,
             dataAlignment, maxChunkSize, compressType,
             false, endianFlag, ((noCompress) ?
-            nullptr : &totalSize), deps);
+            nullptr : &totalSize), deps, pool);
     }
 
     // Generate internal root data.
@@ -5034,10 +5558,10 @@ void in_write(hl::bina::ver version, const archive_entry_list& arc,
     const std::size_t rootDepTablePos = v3::in_write((version.rev >= '5') ? version : ver_402,
         USHRT_MAX, uid, typeMetadata, splitLimit, dataAlignment,
         true, compressType, maxChunkSize, endianFlag, deps,
-        nullptr, rootInternalFile);
+        nullptr, false, rootInternalFile);
 
-    const std::size_t rootUncompressedSize = rootInternalFile.get_size();
-    rootDepInfo.uncompressedSize = rootUncompressedSize;
+    rootDepInfo.set_size(compressType, maxChunkSize,
+        rootInternalFile.get_size(), !noCompress/* && totalSize > maxChunkSize*/);
 
     // Start writing header.
     const std::size_t headerPos = stream.tell();
@@ -5108,30 +5632,22 @@ void in_write(hl::bina::ver version, const archive_entry_list& arc,
     // Pad file.
     stream.pad(16);
 
-    // Write splits and fix split positions within root internal data.
-    deps.write_split_data(compressType, rootDepTablePos,
-        endianFlag, rootInternalFile, stream);
-
-    // Compress root data if necessary.
-    if (!noCompress/* && totalSize > maxChunkSize*/)
-    {
-        rootDepInfo.set_data_compress(compressType,
-            maxChunkSize, rootUncompressedSize,
-            rootInternalFile.get_data_ptr());
-    }
-
-    // Otherwise, get pointer to uncompressed root data.
-    else
-    {
-        rootDepInfo.set_data_no_compress(
-            rootUncompressedSize,
-            rootInternalFile.release());
-    }
+    // Write splits and fill-in split values within root internal data.
+    in_write_splits((version.rev >= '5') ? version : ver_402, uid,
+        typeMetadata, splitLimit, dataAlignment, maxChunkSize,
+        compressType, false, endianFlag, rootDepTablePos, deps,
+        rootInternalFile, stream, pool);
 
-    // Write root data.
+    // Write root data, compressing it as necessary.
     const std::size_t rootPos = stream.tell();
-    stream.write_all(rootDepInfo.compressedSize,
-        rootDepInfo.compressedData.get());
+    // NOTE: Splits are already compressed in parallel with each other,
+    // but the root is compressed on its own, so its LZ4 chunks are
+    // compressed in parallel instead. (Deflate data is still compressed as
+    // a single stream, since compressing it in blocks would change the output.)
+    rootDepInfo.write_data(compressType, maxChunkSize,
+        rootInternalFile.get_data_ptr(), stream, pool);
+
+    rootInternalFile.close();
 
     // Fill-in root chunks if necessary.
     if (compressType == compress_type::lz4)
@@ -5164,11 +5680,12 @@ void write(const archive_entry_list& arc,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     stream& stream, u32 splitLimit, u32 dataAlignment,
-    bool noCompress)
+    bool noCompress,
+    thread_pool* pool)
 {
     in_write(ver_403, arc, parentPaths, pacName, maxChunkSize,
         compressType, endianFlag, extCount, exts,
-        stream, splitLimit, dataAlignment, noCompress);
+        stream, splitLimit, dataAlignment, noCompress, pool);
 }
 
 void save(const archive_entry_list& arc,
@@ -5176,7 +5693,8 @@ void save(const archive_entry_list& arc,
     u32 maxChunkSize, compress_type compressType,
     bina::endian_flag endianFlag, const std::size_t extCount,
     const supported_ext* exts, const nchar* filePath,
-    u32 splitLimit, u32 dataAlignment, bool noCompress)
+    u32 splitLimit, u32 dataAlignment, bool noCompress,
+    thread_pool* pool)
 {
     // Open file for writing.
     file_stream file(filePath, file::mode::write);
@@ -5184,7 +5702,10 @@ void save(const archive_entry_list& arc,
     // Write PACxV403 data to file.
     write(arc, parentPaths, path::get_name(filePath), maxChunkSize,
         compressType, endianFlag, extCount, exts, file,
-        splitLimit, dataAlignment, noCompress);
+        splitLimit, dataAlignment, noCompress, pool);
+
+    // Close file.
+    file.close();
 }
 
 static std::vector<std::string> in_parse_dependencies_file(
@@ -5207,7 +5728,8 @@ void save(archive_entry_list& arc, u32 maxChunkSize,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     const nchar* filePath, u32 splitLimit, u32 dataAlignment,
-    bool noCompress)
+    bool noCompress,
+    thread_pool* pool)
 {
     // Find parent path list file, if any.
     archive_entry* parentsFile = nullptr;
@@ -5232,7 +5754,7 @@ void save(archive_entry_list& arc, u32 maxChunkSize,
         // Save PACxV403 data to file.
         save(arc, &parentPaths, maxChunkSize, compressType, endianFlag,
             extCount, exts, filePath, splitLimit, dataAlignment,
-            noCompress);
+            noCompress, pool);
 
         *parentsFile = std::move(tmp);
     }
@@ -5242,7 +5764,7 @@ void save(archive_entry_list& arc, u32 maxChunkSize,
     {
         save(arc, nullptr, maxChunkSize, compressType, endianFlag,
             extCount, exts, filePath, splitLimit, dataAlignment,
-            noCompress);
+            noCompress, pool);
     }
 }
 } // v03
@@ -5255,11 +5777,12 @@ void write(const archive_entry_list& arc,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     stream& stream, u32 splitLimit, u32 dataAlignment,
-    bool noCompress)
+    bool noCompress,
+    thread_pool* pool)
 {
     v03::in_write(ver_405, arc, parentPaths, pacName, maxChunkSize,
         compressType, endianFlag, extCount, exts,
-        stream, splitLimit, dataAlignment, noCompress);
+        stream, splitLimit, dataAlignment, noCompress, pool);
 }
 
 void save(const archive_entry_list& arc,
@@ -5267,7 +5790,8 @@ void save(const archive_entry_list& arc,
     u32 maxChunkSize, compress_type compressType,
     bina::endian_flag endianFlag, const std::size_t extCount,
     const supported_ext* exts, const nchar* filePath,
-    u32 splitLimit, u32 dataAlignment, bool noCompress)
+    u32 splitLimit, u32 dataAlignment, bool noCompress,
+    thread_pool* pool)
 {
     // Open file for writing.
     file_stream file(filePath, file::mode::write);
@@ -5275,14 +5799,18 @@ void save(const archive_entry_list& arc,
     // Write PACxV405 data to file.
     write(arc, parentPaths, path::get_name(filePath), maxChunkSize,
         compressType, endianFlag, extCount, exts, file,
-        splitLimit, dataAlignment, noCompress);
+        splitLimit, dataAlignment, noCompress, pool);
+
+    // Close file.
+    file.close();
 }
 
 void save(archive_entry_list& arc, u32 maxChunkSize,
     compress_type compressType, bina::endian_flag endianFlag,
     const std::size_t extCount, const supported_ext* exts,
     const nchar* filePath, u32 splitLimit, u32 dataAlignment,
-    bool noCompress)
+    bool noCompress,
+    thread_pool* pool)
 {
     // Find parent path list file, if any.
     archive_entry* parentsFile = nullptr;
@@ -5307,7 +5835,7 @@ void save(archive_entry_list& arc, u32 maxChunkSize,
         // Save PACxV403 data to file.
         save(arc, &parentPaths, maxChunkSize, compressType, endianFlag,
             extCount, exts, filePath, splitLimit, dataAlignment,
-            noCompress);
+            noCompress, pool);
 
         *parentsFile = std::move(tmp);
     }
@@ -5317,7 +5845,7 @@ void save(archive_entry_list& arc, u32 maxChunkSize,
     {
         save(arc, nullptr, maxChunkSize, compressType, endianFlag,
             extCount, exts, filePath, splitLimit, dataAlignment,
-            noCompress);
+            noCompress, pool);
     }
 }
 } // v05
@@ -5348,9 +5876,45 @@ void fix(void* pac)
     throw std::runtime_error("Unknown or unsupported PACx version");
 }
 
+static void in_decompress_no_alloc_lz4_parallel(u32 chunkCount,
+    const chunk* chunks, u32 srcSize, const void* src,
+    u32 dstSize, void* dst, thread_pool& pool)
+{
+    // Compute the position of every chunk within the source and destination
+    // buffers up-front so that each chunk can be decompressed independently.
+    std::unique_ptr<u64[]> chunkPositions(new u64[chunkCount * 2ULL]);
+    u64 curSrcPos = 0, curDstPos = 0;
+
+    for (u32 i = 0; i < chunkCount; ++i)
+    {
+        chunkPositions[i * 2ULL] = curSrcPos;
+        chunkPositions[(i * 2ULL) + 1] = curDstPos;
+
+        curSrcPos += chunks[i].compressedSize;
+        curDstPos += chunks[i].uncompressedSize;
+    }
+
+    // Ensure all chunks fit within the given buffers, since they're
+    // no longer implicitly bounds-checked by decompressing them in order.
+    if (curSrcPos > srcSize || curDstPos > dstSize)
+    {
+        throw invalid_data_exception();
+    }
+
+    // Decompress chunks in parallel.
+    pool.parallel_for(chunkCount, [&](std::size_t i)
+    {
+        lz4_decompress_no_alloc(chunks[i].compressedSize,
+            ptradd(src, chunkPositions[i * 2]),
+            chunks[i].uncompressedSize,
+            ptradd(dst, chunkPositions[(i * 2) + 1]));
+    });
+}
+
 void decompress_no_alloc_lz4(u32 chunkCount,
     const chunk* chunks, u32 srcSize,
-    const void* src, u32 dstSize, void* dst)
+    const void* src, u32 dstSize, void* dst,
+    thread_pool* pool)
 {
     // If the data is already uncompressed, just copy it.
     if (srcSize == dstSize)
@@ -5359,6 +5923,15 @@ void decompress_no_alloc_lz4(u32 chunkCount,
         return;
     }
 
+    // Decompress chunks in parallel if we were given a thread pool.
+    if (pool && chunkCount > 1)
+    {
+        in_decompress_no_alloc_lz4_parallel(chunkCount,
+            chunks, srcSize, src, dstSize, dst, *pool);
+
+        return;
+    }
+
     // Otherwise, decompress the data one chunk at a time.
     for (u32 i = 0; i < chunkCount; ++i)
     {
@@ -5374,22 +5947,24 @@ void decompress_no_alloc_lz4(u32 chunkCount,
 
 std::unique_ptr<u8[]> decompress_lz4(u32 chunkCount,
     const chunk* chunks, u32 srcSize,
-    const void* src, u32 dstSize)
+    const void* src, u32 dstSize,
+    thread_pool* pool)
 {
     std::unique_ptr<u8[]> dst(new u8[dstSize]);
     decompress_no_alloc_lz4(chunkCount, chunks,
-        srcSize, src, dstSize, dst.get());
+        srcSize, src, dstSize, dst.get(), pool);
 
     return dst;
 }
 
 blob decompress_lz4_blob(u32 chunkCount,
     const chunk* chunks, u32 srcSize,
-    const void* src, u32 dstSize)
+    const void* src, u32 dstSize,
+    thread_pool* pool)
 {
     blob dst(dstSize);
     decompress_no_alloc_lz4(chunkCount, chunks,
-        srcSize, src, dstSize, dst);
+        srcSize, src, dstSize, dst, pool);
 
     return dst;
 }
@@ -5404,8 +5979,9 @@ void decompress_no_alloc_deflate(u32 srcSize,
         return;
     }
 
-    // Otherwise, decompress it.
-    deflate_decompress_no_alloc(srcSize, src, dstSize, dst);
+    // Otherwise, decompress it, re-using this thread's zlib stream.
+    deflate_decompress_context::get_thread_local().decompress_no_alloc(
+        srcSize, src, dstSize, dst);
 }
 
 std::unique_ptr<u8[]> decompress_deflate(u32 srcSize,
@@ -5428,6 +6004,7 @@ std::size_t compress_no_alloc_lz4(u32 maxChunkSize,
     std::size_t srcSize, const void* src, std::size_t dstBufSize,
     void* dst, std::vector<chunk>& chunks)
 {
+    lz4_compress_context& context = lz4_compress_context::get_thread_local();
     const void* srcEnd = ptradd(src, srcSize);
     std::size_t totalCompressedSize = 0;
 
@@ -5437,7 +6014,7 @@ std::size_t compress_no_alloc_lz4(u32 maxChunkSize,
         const std::size_t curChunkSrcSize = std::min
             <std::size_t>(srcSize, maxChunkSize);
 
-        const std::size_t curChunkDstSize = lz4_compress_no_alloc(
+        const std::size_t curChunkDstSize = context.compress_no_alloc(
             curChunkSrcSize, src, dstBufSize, dst);
 
         // Add new chunk to chunks list.
@@ -5508,10 +6085,68 @@ blob compress_blob_lz4(u32 maxChunkSize,
     return dst;
 }
 
+std::size_t compress_to_stream_lz4(u32 maxChunkSize,
+    std::size_t srcSize, const void* src, stream& stream,
+    std::vector<chunk>& chunks, thread_pool* pool)
+{
+    // Compress one chunk at a time, or one chunk per thread if we were given a pool.
+    const std::size_t batchChunkCount = (pool) ? pool->concurrency() : 1;
+    const std::size_t batchMaxSize = (maxChunkSize) ?
+        (static_cast<std::size_t>(maxChunkSize) * batchChunkCount) : srcSize;
+
+    // Allocate a buffer large enough to hold a single batch of compressed chunks.
+    const std::size_t bufSize = compress_blocks_bound(compress_type::lz4,
+        std::min<std::size_t>(srcSize, batchMaxSize), maxChunkSize);
+
+    std::unique_ptr<u8[]> buf(new u8[bufSize]);
+    std::vector<std::size_t> batchChunkSizes;
+    std::size_t totalCompressedSize = 0;
+
+    while (srcSize > 0)
+    {
+        // Compress batch of chunks.
+        const std::size_t curBatchSrcSize = std::min
+            <std::size_t>(srcSize, batchMaxSize);
+
+        batchChunkSizes.clear();
+        const std::size_t curBatchDstSize = lz4_compress_blocks_no_alloc(
+            curBatchSrcSize, src, maxChunkSize, bufSize, buf.get(),
+            &batchChunkSizes, compress_level_default, pool);
+
+        // Write compressed chunks to stream.
+        stream.write_all(curBatchDstSize, buf.get());
+
+        // Add new chunks to chunks list.
+        std::size_t curBatchRemainingSize = curBatchSrcSize;
+        for (const std::size_t curChunkDstSize : batchChunkSizes)
+        {
+            const std::size_t curChunkSrcSize = (maxChunkSize) ?
+                std::min<std::size_t>(curBatchRemainingSize, maxChunkSize) :
+                curBatchRemainingSize;
+
+            chunks.emplace_back(
+                static_cast<u32>(curChunkDstSize),
+                static_cast<u32>(curChunkSrcSize));
+
+            curBatchRemainingSize -= curChunkSrcSize;
+        }
+
+        // Increase source pointer and total compressed size.
+        src = ptradd(src, curBatchSrcSize);
+        totalCompressedSize += curBatchDstSize;
+
+        // Decrease source size.
+        srcSize -= curBatchSrcSize;
+    }
+
+    return totalCompressedSize;
+}
+
 std::size_t compress_no_alloc_deflate(std::size_t srcSize,
     const void* src, std::size_t dstBufSize, void* dst)
 {
-    return deflate_compress_no_alloc(srcSize, src, dstBufSize, dst);
+    return deflate_compress_context::get_thread_local().compress_no_alloc(
+        srcSize, src, dstBufSize, dst);
 }
 
 std::unique_ptr<u8[]> compress_deflate(std::size_t srcSize,
@@ -5525,7 +6160,20 @@ blob compress_blob_deflate(std::size_t srcSize, const void* src)
     return hl::compress_blob(compress_type::deflate, srcSize, src);
 }
 
-blob decompress_root(const void* pac)
+std::size_t compress_to_stream_deflate(std::size_t srcSize,
+    const void* src, stream& stream)
+{
+    // NOTE: Deflate data is a single stream rather than a series of
+    // independent chunks, so it all has to be compressed up-front.
+    std::size_t dstSize;
+    std::unique_ptr<u8[]> dst = compress_deflate(srcSize, src, dstSize);
+
+    // Write compressed data to stream.
+    stream.write_all(dstSize, dst.get());
+    return dstSize;
+}
+
+blob decompress_root(const void* pac, thread_pool* pool)
 {
     // Attempt to decompress root based on version number.
     const header* headerPtr = static_cast<const header*>(pac);
@@ -5538,14 +6186,14 @@ blob decompress_root(const void* pac)
                 const v02::header* headerV02 = static_cast<
                     const v02::header*>(pac);
 
-                return headerV02->decompress_root();
+                return headerV02->decompress_root(pool);
             }
             else if (headerPtr->version.rev == '3' || headerPtr->version.rev == '5')
             {
                 const v03::header* headerV03 = static_cast<
                     const v03::header*>(pac);
 
-                return headerV03->decompress_root();
+                return headerV03->decompress_root(pool);
             }
         }
     }
@@ -5555,7 +6203,7 @@ blob decompress_root(const void* pac)
 
 void read(void* pac, archive_entry_list* hlArc,
     std::vector<blob>* pacs, bool readSplits,
-    std::vector<std::string>* parentPaths)
+    std::vector<std::string>* parentPaths, thread_pool* pool)
 {
     // Attempt to decompress root based on version number.
     const header* headerPtr = static_cast<const header*>(pac);
@@ -5565,13 +6213,13 @@ void read(void* pac, archive_entry_list* hlArc,
         {
             if (headerPtr->version.rev == '2')
             {
-                v02::read(pac, hlArc, pacs, readSplits);
+                v02::read(pac, hlArc, pacs, readSplits, pool);
                 return;
             }
             else if (headerPtr->version.rev == '3' || headerPtr->version.rev == '5')
             {
                 v03::read(pac, hlArc, pacs,
-                    readSplits, parentPaths);
+                    readSplits, parentPaths, pool);
                 return;
             }
         }
@@ -5580,13 +6228,13 @@ void read(void* pac, archive_entry_list* hlArc,
     throw std::runtime_error("Unknown or unsupported PACx version");
 }
 
-static void in_load(blob& pac, const nchar* filePath,
+static void in_load(void* pac, const nchar* filePath,
     archive_entry_list* hlArc, std::vector<blob>* pacs,
-    bool readSplits = true)
+    bool readSplits = true, thread_pool* pool = nullptr)
 {
     // Read data and parse it as necessary.
     std::vector<std::string> parentPaths;
-    read(pac, hlArc, pacs, readSplits, &parentPaths);
+    read(pac, hlArc, pacs, readSplits, &parentPaths, pool);
 
     // Generate dependencies file and add it to archive if necessary.
     if (hlArc && !parentPaths.empty())
@@ -5598,24 +6246,24 @@ static void in_load(blob& pac, const nchar* filePath,
 void load(const nchar* filePath,
     std::vector<std::string>* parentPaths,
     archive_entry_list* hlArc, std::vector<blob>* pacs,
-    bool readSplits)
+    bool readSplits, thread_pool* pool)
 {
     // Load data into blob.
     blob pac(filePath);
 
     // Finish loading data and parsing as necessary.
-    read(pac, hlArc, pacs, readSplits, parentPaths);
+    read(pac, hlArc, pacs, readSplits, parentPaths, pool);
 }
 
 void load(const nchar* filePath,
     archive_entry_list* hlArc, std::vector<blob>* pacs,
-    bool readSplits)
+    bool readSplits, thread_pool* pool)
 {
     // Load data into blob.
     blob pac(filePath);
 
     // Finish loading data and parsing as necessary.
-    in_load(pac, filePath, hlArc, pacs, readSplits);
+    in_load(pac, filePath, hlArc, pacs, readSplits, pool);
 }
 } // v4
 
@@ -5637,7 +6285,7 @@ nstring get_root_path(const nchar* filePath)
 }
 
 void load(const nchar* filePath, archive_entry_list* hlArc,
-    std::vector<blob>* pacs)
+    std::vector<blob>* pacs, thread_pool* pool)
 {
     // Load data into blob.
     blob pac(filePath);
@@ -5654,7 +6302,35 @@ void load(const nchar* filePath, archive_entry_list* hlArc,
         break;
 
     case '4':
-        v4::in_load(pac, filePath, hlArc, pacs);
+        v4::in_load(pac, filePath, hlArc, pacs, true, pool);
+        break;
+
+    default:
+        throw unsupported_exception();
+    }
+}
+
+void load_mapped(const nchar* filePath, archive_entry_list& hlArc,
+    std::vector<mapped_file>& pacs, thread_pool* pool)
+{
+    // Map file into memory.
+    mapped_file pac(filePath);
+
+    // Load data and parse it.
+    switch (pac.data<bina::v2::raw_header>()->version._major)
+    {
+    case '2':
+        v2::in_load_mapped(pac, filePath, hlArc, pacs);
+        break;
+
+    case '3':
+        v3::in_load_mapped(pac, filePath, hlArc, pacs);
+        break;
+
+    case '4':
+        // NOTE: PACxV4 file data is always decompressed into new
+        // buffers, so there's nothing to point into; just load it normally.
+        v4::in_load(pac.data(), filePath, &hlArc, nullptr, true, pool);
         break;
 
     default:
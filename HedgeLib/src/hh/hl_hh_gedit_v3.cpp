@@ -2,8 +2,11 @@
 #include "hl_in_hh_gedit_field_writer.h"
 #include "hedgelib/hh/hl_hh_gedit.h"
 #include "hedgelib/io/hl_file.h"
+#include "hedgelib/hl_blob.h"
+#include "hedgelib/hl_thread_pool.h"
 #include <DirectXMath.h>
 #include <unordered_set>
+#include <cstring>
 
 namespace hl
 {
@@ -28,12 +31,17 @@ inline v3::raw_object_id in_as_obj_ref<v3::raw_object_id>(const std::string& gui
 
 namespace v3
 {
+using in_field_layout_database = internal::in_field_layout_database<
+    raw_object_id, off64, csl::move_array64>;
+
 using in_field_reader = internal::in_field_reader<
     raw_object_id, off64, csl::move_array64>;
 
 using in_field_writer = internal::in_field_writer<
     bina::v2::writer64, raw_object_id, off64, csl::move_array64>;
 
+using in_struct_layout = internal::in_struct_layout;
+
 using in_tag_info = internal::in_tag_info<bina::v2::writer64>;
 
 static const in_tag_info in_tag_info_range_spawning =
@@ -115,8 +123,9 @@ matrix4x4A raw_object::get_local_transform_matrix() const noexcept
     return get_local_transform().as_matrix();
 }
 
+template<typename world_t>
 static DirectX::XMMATRIX in_get_global_transform_matrix(
-    const raw_object& rawObj, const raw_world& rawWorld)
+    const raw_object& rawObj, const world_t& rawWorld)
 {
     // If the object has a parent, its transform is local to the parent.
     if (!rawObj.parentID.empty())
@@ -134,43 +143,53 @@ static DirectX::XMMATRIX in_get_global_transform_matrix(
     return in_get_matrix(rawObj.transformBase);
 }
 
-matrix4x4A raw_object::get_global_transform_matrix(const raw_world& world) const
+static matrix4x4A in_store_matrix(DirectX::FXMMATRIX matrix) noexcept
 {
     HL_STATIC_ASSERT_SIZE(DirectX::XMFLOAT4X4A, sizeof(matrix4x4A));
 
     matrix4x4A result;
     DirectX::XMStoreFloat4x4A(
         reinterpret_cast<DirectX::XMFLOAT4X4A*>(&result),
-        in_get_global_transform_matrix(*this, world));
+        matrix);
 
     return result;
 }
 
-void raw_object::add_to_hson(
+matrix4x4A raw_object::get_global_transform_matrix(const raw_world& world) const
+{
+    return in_store_matrix(in_get_global_transform_matrix(*this, world));
+}
+
+matrix4x4A raw_object::get_global_transform_matrix(
+    const raw_world_index& worldIndex) const
+{
+    return in_store_matrix(in_get_global_transform_matrix(*this, worldIndex));
+}
+
+static void in_add_to_hson(const raw_object& rawObj,
     ordered_map<guid, hson::object>& hsonObjects,
-    const set_object_type_database* objTypeDB,
-    bool tailEndAlignParentStructs) const
+    in_field_layout_database* fieldLayouts)
 {
     // Convert object to HSON.
     auto& hsonObj = hsonObjects.emplace(
-        id, hson::object()).first->second;
+        rawObj.id, hson::object()).first->second;
 
-    hsonObj.type = type.get();
+    hsonObj.type = rawObj.type.get();
 
-    if (name)
+    if (rawObj.name)
     {
-        hsonObj.name = name.get();
+        hsonObj.name = rawObj.name.get();
     }
 
-    hsonObj.parentID = parentID;
+    hsonObj.parentID = rawObj.parentID;
 
-    const auto& localTransform = get_local_transform();
+    const auto& localTransform = rawObj.get_local_transform();
     hsonObj.position = localTransform.pos;
     hsonObj.rotation = quat(localTransform.rot);
 
     // Convert tag data to HSON.
     hson::parameter hsonTags(hson::parameter_type::object);
-    for (const auto& rawTagOff : tags)
+    for (const auto& rawTagOff : rawObj.tags)
     {
         const auto& rawTag = *rawTagOff;
         const auto rawTagType = rawTag.type.get();
@@ -189,19 +208,37 @@ void raw_object::add_to_hson(
     }
 
     // Return if we don't have an object type database.
-    if (!objTypeDB) return;
+    if (!fieldLayouts) return;
 
     // Get object definition from object type database.
-    const auto objType = objTypeDB->get(type.get());
+    const auto& objTypeDB = fieldLayouts->obj_type_db();
+    const auto objType = objTypeDB.get(rawObj.type.get());
     if (!objType || objType->structType.empty()) return;
 
     // Get struct definition from object type database.
-    const auto objStructType = objTypeDB->structs.get(objType->structType);
+    const auto objStructType = objTypeDB.structs.get(objType->structType);
     if (!objStructType) return;
 
     // Convert parameter data to HSON.
-    in_field_reader fieldReader(paramData.get(), *objTypeDB, tailEndAlignParentStructs);
-    fieldReader.read_struct_fields(*objStructType, hsonObj.parameters);
+    in_field_reader fieldReader(rawObj.paramData.get(), *fieldLayouts);
+    fieldReader.read_struct_fields(fieldLayouts->get(*objStructType),
+        hsonObj.parameters);
+}
+
+void raw_object::add_to_hson(
+    ordered_map<guid, hson::object>& hsonObjects,
+    const set_object_type_database* objTypeDB,
+    bool tailEndAlignParentStructs) const
+{
+    if (objTypeDB)
+    {
+        in_field_layout_database fieldLayouts(*objTypeDB, tailEndAlignParentStructs);
+        in_add_to_hson(*this, hsonObjects, &fieldLayouts);
+    }
+    else
+    {
+        in_add_to_hson(*this, hsonObjects, nullptr);
+    }
 }
 
 const raw_object* raw_world::get_object(const raw_object_id& id) const
@@ -217,6 +254,127 @@ const raw_object* raw_world::get_object(const raw_object_id& id) const
     return nullptr;
 }
 
+std::size_t raw_world_index::index_of(const raw_object_id& id) const noexcept
+{
+    const auto it = m_objIndices.find(id);
+    return (it != m_objIndices.end()) ? it->second : npos;
+}
+
+const raw_object* raw_world_index::get_object(const raw_object_id& id) const noexcept
+{
+    const auto objIndex = index_of(id);
+    return (objIndex != npos) ?
+        m_world->objects.data()[objIndex].get() : nullptr;
+}
+
+void raw_world_index::get_global_transform_matrices(
+    std::vector<matrix4x4A>& matrices) const
+{
+    enum class in_resolve_state : u8
+    {
+        unresolved = 0,
+        resolving,
+        resolved
+    };
+
+    const auto objects = m_world->objects.data();
+    const std::size_t objCount = static_cast<std::size_t>(m_world->objects.size());
+
+    // Look up the index of every object's parent up-front.
+    std::unique_ptr<std::size_t[]> parentIndices(new std::size_t[objCount]);
+    for (std::size_t i = 0; i < objCount; ++i)
+    {
+        const auto rawObj = objects[i].get();
+        parentIndices[i] = (rawObj && !rawObj->parentID.empty()) ?
+            index_of(rawObj->parentID) : npos;
+    }
+
+    // Resolve the global transform of every object.
+    std::unique_ptr<in_resolve_state[]> states(new in_resolve_state[objCount]());
+    std::vector<std::size_t> chain;
+
+    matrices.resize(objCount);
+
+    for (std::size_t i = 0; i < objCount; ++i)
+    {
+        if (states[i] == in_resolve_state::resolved) continue;
+
+        // Walk up the parent chain until we reach an object which has
+        // already been resolved, or which has no (valid) parent.
+        std::size_t curIndex = i;
+        while (true)
+        {
+            chain.push_back(curIndex);
+            states[curIndex] = in_resolve_state::resolving;
+
+            const auto parentIndex = parentIndices[curIndex];
+            if (parentIndex == npos ||
+                states[parentIndex] != in_resolve_state::unresolved)
+            {
+                break;
+            }
+
+            curIndex = parentIndex;
+        }
+
+        // Resolve the chain from the top down, so that each object's
+        // parent has always been resolved before the object itself.
+        while (!chain.empty())
+        {
+            curIndex = chain.back();
+            chain.pop_back();
+
+            const auto rawObj = objects[curIndex].get();
+            const auto parentIndex = parentIndices[curIndex];
+
+            if (!rawObj)
+            {
+                matrices[curIndex] = in_store_matrix(DirectX::XMMatrixIdentity());
+            }
+
+            // If the object has a resolved parent, its transform is local to the parent.
+            // NOTE: The parent could only still be resolving here if the chain loops.
+            else if (parentIndex != npos &&
+                states[parentIndex] == in_resolve_state::resolved)
+            {
+                matrices[curIndex] = in_store_matrix(DirectX::XMMatrixMultiply(
+                    in_get_matrix(rawObj->transformOffset),
+                    DirectX::XMLoadFloat4x4A(reinterpret_cast<
+                        const DirectX::XMFLOAT4X4A*>(&matrices[parentIndex]))));
+            }
+
+            // Otherwise, its transform is global.
+            else
+            {
+                matrices[curIndex] = in_store_matrix(
+                    in_get_matrix(rawObj->transformBase));
+            }
+
+            states[curIndex] = in_resolve_state::resolved;
+        }
+    }
+}
+
+raw_world_index::raw_world_index(const raw_world& world) :
+    m_world(&world)
+{
+    // Index all of the objects within the world by their IDs.
+    const auto objects = world.objects.data();
+    const std::size_t objCount = static_cast<std::size_t>(world.objects.size());
+    m_objIndices.reserve(objCount);
+
+    for (std::size_t i = 0; i < objCount; ++i)
+    {
+        // Skip this object if its offset is null.
+        const auto rawObj = objects[i].get();
+        if (!rawObj) continue;
+
+        // NOTE: emplace won't replace existing objects, so if multiple objects
+        // share the same ID, the first one wins, just like raw_world::get_object.
+        m_objIndices.emplace(rawObj->id, i);
+    }
+}
+
 static void in_fix(raw_world& rawHeader)
 {
     // Endian-swap header.
@@ -270,6 +428,15 @@ void raw_world::add_to_hson(ordered_map<guid, hson::object>& hsonObjects,
     // Add all objects in the gedit world to the HSON.
     hsonObjects.reserve(hsonObjects.size() + objects.count);
 
+    // NOTE: We share field layouts between all objects, so each
+    // struct type only needs to be compiled into a layout once.
+    std::unique_ptr<in_field_layout_database> fieldLayouts;
+    if (objTypeDB)
+    {
+        fieldLayouts = std::make_unique<in_field_layout_database>(
+            *objTypeDB, tailEndAlignParentStructs);
+    }
+
     for (const auto& obj : objects)
     {
         // Skip object if its type is not in the database.
@@ -280,7 +447,7 @@ void raw_world::add_to_hson(ordered_map<guid, hson::object>& hsonObjects,
         }
 
         // Add object to HSON.
-        obj->add_to_hson(hsonObjects, objTypeDB, tailEndAlignParentStructs);
+        in_add_to_hson(*obj, hsonObjects, fieldLayouts.get());
     }
 }
 
@@ -337,9 +504,502 @@ static const radix_tree<hson::parameter>* in_get_tags(
     }
 }
 
+static void in_write_tag_data(const hson::object& obj,
+    const hson::project& project, radix_tree<hson::parameter>& tagsBuf,
+    bina::v2::writer64& writer, std::size_t& curOffPos)
+{
+    const auto curObjTags = in_get_tags(obj, project, tagsBuf);
+    if (!curObjTags) return;
+
+    const auto tagCount = in_get_supported_tag_count(*curObjTags);
+    if (!tagCount) return;
+
+    // Increase offset position.
+    curOffPos += (sizeof(off64<raw_tag>) * tagCount);
+    curOffPos = align(curOffPos, 16);
+
+    // Write tag data for supported tags.
+    for (const auto it : *curObjTags)
+    {
+        // Get info for the current tag.
+        const auto tagInfo = in_get_tag_info(it.first);
+        if (!tagInfo) continue;
+
+        // Pad stream and fix tag data offset.
+        writer.pad(tagInfo->align);
+        writer.fix_offset(curOffPos + offsetof(raw_tag, dataPtr));
+
+        // Write tag data.
+        tagInfo->writeData(it.second, writer);
+
+        // Increase offset position.
+        curOffPos += sizeof(raw_tag);
+    }
+}
+
+static u64 in_hash_combine(u64 hash, u64 value) noexcept
+{
+    return (hash ^ (value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2)));
+}
+
+static u64 in_hash_parameters(const radix_tree<hson::parameter>& params, u64 hash);
+
+static u64 in_hash_parameter(const hson::parameter& param, u64 hash)
+{
+    hash = in_hash_combine(hash, static_cast<u64>(param.type()));
+
+    switch (param.type())
+    {
+    case hson::parameter_type::boolean:
+        return in_hash_combine(hash, static_cast<u64>(param.value_bool()));
+
+    case hson::parameter_type::signed_integer:
+        return in_hash_combine(hash, static_cast<u64>(param.value_int()));
+
+    case hson::parameter_type::unsigned_integer:
+        return in_hash_combine(hash, static_cast<u64>(param.value_uint()));
+
+    case hson::parameter_type::floating:
+    {
+        const double val = param.value_floating();
+        u64 bits;
+
+        std::memcpy(&bits, &val, sizeof(bits));
+        return in_hash_combine(hash, bits);
+    }
+
+    case hson::parameter_type::string:
+        return in_hash_combine(hash, static_cast<u64>(robin_hood::hash_bytes(
+            param.value_string().data(), param.value_string().size())));
+
+    case hson::parameter_type::array:
+        hash = in_hash_combine(hash, static_cast<u64>(param.value_array().size()));
+        for (const auto& elem : param.value_array())
+        {
+            hash = in_hash_parameter(elem, hash);
+        }
+
+        return hash;
+
+    case hson::parameter_type::object:
+        return in_hash_parameters(param.value_object(), hash);
+
+    default:
+        return hash;
+    }
+}
+
+static u64 in_hash_parameters(const radix_tree<hson::parameter>& params, u64 hash)
+{
+    hash = in_hash_combine(hash, static_cast<u64>(params.size()));
+    for (const auto it : params)
+    {
+        hash = in_hash_combine(hash, static_cast<u64>(
+            robin_hood::hash_bytes(it.first, std::strlen(it.first))));
+
+        hash = in_hash_parameter(it.second, hash);
+    }
+
+    return hash;
+}
+
+static bool in_parameters_equal(const radix_tree<hson::parameter>& params1,
+    const radix_tree<hson::parameter>& params2);
+
+static bool in_parameter_equal(const hson::parameter& param1,
+    const hson::parameter& param2)
+{
+    if (param1.type() != param2.type())
+    {
+        return false;
+    }
+
+    switch (param1.type())
+    {
+    case hson::parameter_type::boolean:
+        return (param1.value_bool() == param2.value_bool());
+
+    case hson::parameter_type::signed_integer:
+        return (param1.value_int() == param2.value_int());
+
+    case hson::parameter_type::unsigned_integer:
+        return (param1.value_uint() == param2.value_uint());
+
+    case hson::parameter_type::floating:
+    {
+        // NOTE: We compare the values bit-for-bit (just like when hashing them),
+        // since e.g. 0.0 and -0.0 are equal, but aren't encoded the same way.
+        const double val1 = param1.value_floating();
+        const double val2 = param2.value_floating();
+        return (std::memcmp(&val1, &val2, sizeof(double)) == 0);
+    }
+
+    case hson::parameter_type::string:
+        return (param1.value_string() == param2.value_string());
+
+    case hson::parameter_type::array:
+    {
+        const auto& arr1 = param1.value_array();
+        const auto& arr2 = param2.value_array();
+
+        if (arr1.size() != arr2.size())
+        {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < arr1.size(); ++i)
+        {
+            if (!in_parameter_equal(arr1[i], arr2[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    case hson::parameter_type::object:
+        return in_parameters_equal(param1.value_object(), param2.value_object());
+
+    default:
+        return true;
+    }
+}
+
+static bool in_parameters_equal(const radix_tree<hson::parameter>& params1,
+    const radix_tree<hson::parameter>& params2)
+{
+    if (params1.size() != params2.size())
+    {
+        return false;
+    }
+
+    for (const auto it : params1)
+    {
+        const auto param2 = params2.get(it.first);
+        if (!param2 || !in_parameter_equal(it.second, *param2))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Implements the parallel and cached paths of write, which encode each
+ * object's parameters into a separate block in memory first, and then copy
+ * the blocks (along with their offsets and strings) into the real file.
+ */
+class in_world_writer
+{
+    using in_block = write_cache::in_block;
+    using in_entry = write_cache::in_entry;
+
+    /**
+     * @brief Records everything in_field_writer writes into a block in memory,
+     * as though the block were being written at position 0 of the file.
+     */
+    class in_block_writer
+    {
+        in_block* m_block;
+        bool m_doSwap;
+
+        template<typename T>
+        void in_write_raw(const T& obj)
+        {
+            const auto pos = m_block->data.size();
+            m_block->data.resize(pos + sizeof(T));
+            std::memcpy(&m_block->data[pos], &obj, sizeof(T));
+        }
+
+    public:
+        inline std::size_t tell() const noexcept
+        {
+            return m_block->data.size();
+        }
+
+        void pad(std::size_t stride)
+        {
+            if (stride < 2) return;
+
+            // Keep track of the largest alignment we've padded to, since this
+            // block can only be copied as-is to positions aligned to it.
+            m_block->alignment = std::max(m_block->alignment, stride);
+            m_block->data.resize(align(m_block->data.size(), stride));
+        }
+
+        inline void write_nulls(std::size_t amount)
+        {
+            m_block->data.resize(m_block->data.size() + amount);
+        }
+
+        template<typename T>
+        void write_obj(const T& obj)
+        {
+            if constexpr (sizeof(T) > 1)
+            {
+                if (m_doSwap)
+                {
+                    T tmp(obj);
+                    hl::endian_swap<true>(tmp);
+                    in_write_raw(tmp);
+                    return;
+                }
+            }
+
+            in_write_raw(obj);
+        }
+
+        template<typename T>
+        void write_obj(const T& obj, std::size_t alignment)
+        {
+            pad((alignment) ? alignment : alignof(T));
+            write_obj(obj);
+        }
+
+        template<typename T>
+        void swap_and_write_obj(T& obj)
+        {
+            if constexpr (sizeof(T) > 1)
+            {
+                if (m_doSwap)
+                {
+                    hl::endian_swap<true>(obj);
+                }
+            }
+
+            in_write_raw(obj);
+        }
+
+        template<typename T>
+        void swap_and_write_obj(T& obj, std::size_t alignment)
+        {
+            pad((alignment) ? alignment : alignof(T));
+            swap_and_write_obj(obj);
+        }
+
+        inline void add_string(std::string str, std::size_t offPos)
+        {
+            m_block->strings.emplace_back(std::move(str), offPos);
+        }
+
+        inline void fix_offset(std::size_t pos)
+        {
+            m_block->offsets.emplace_back(pos, tell());
+        }
+
+        in_block_writer(in_block& block, bina::endian_flag endianFlag) noexcept :
+            m_block(&block),
+            m_doSwap(needs_swap(endianFlag)) {}
+    };
+
+    using in_block_field_writer = internal::in_field_writer<
+        in_block_writer, raw_object_id, off64, csl::move_array64>;
+
+    static void in_copy_block(in_block& block, bina::v2::writer64& writer)
+    {
+        const auto blockPos = writer.tell();
+        const bool doSwap = needs_swap(writer.endian_flag());
+
+        // Fill in offsets now that we know where the block will actually go.
+        for (const auto& off : block.offsets)
+        {
+            u64 offVal = static_cast<u64>((blockPos + off.second) - writer.base_pos());
+            if (doSwap) endian_swap(offVal);
+
+            std::memcpy(&block.data[off.first], &offVal, sizeof(offVal));
+            writer.add_offset(blockPos + off.first);
+        }
+
+        // Write block data.
+        writer.write_all(block.data.size(), block.data.data());
+
+        // Add strings.
+        for (const auto& str : block.strings)
+        {
+            writer.add_string(str.str, blockPos + str.offPos);
+        }
+    }
+
+public:
+    static void write_parameters(const hson::project& project,
+        in_field_layout_database& fieldLayouts, bina::v2::writer64& writer,
+        std::size_t objsPos, write_cache* cache, thread_pool* pool)
+    {
+        // Get the objects we have sufficient type info for, and their parameter layouts.
+        // NOTE: This also compiles every layout we'll need up-front, so the layout
+        // database is only ever read from while encoding objects in parallel.
+        std::vector<const guid*> objIDs;
+        std::vector<const hson::object*> objs;
+        std::vector<const in_struct_layout*> objLayouts;
+        in_field_writer fieldWriter(writer, fieldLayouts);
+
+        objIDs.reserve(project.objects.size());
+        objs.reserve(project.objects.size());
+        objLayouts.reserve(project.objects.size());
+
+        for (auto it = project.objects.begin(); it != project.objects.end(); ++it)
+        {
+            const in_struct_layout* objLayout;
+            if (!fieldWriter.get_parameters_layout(it->second, project, objLayout))
+            {
+                continue;
+            }
+
+            objIDs.push_back(&it->first);
+            objs.push_back(&it->second);
+            objLayouts.push_back(objLayout);
+        }
+
+        // Clear the cache if it was last used with different settings.
+        if (cache && (cache->m_objTypeDB != &fieldLayouts.obj_type_db() ||
+            cache->m_endianFlag != writer.endian_flag() ||
+            cache->m_tailEndAlignParentStructs !=
+                fieldLayouts.tail_end_align_parent_structs()))
+        {
+            cache->clear();
+        }
+
+        // Encode the parameters of every object that doesn't have a cached block.
+        std::vector<in_entry> newEntries(objs.size());
+        std::vector<in_entry*> objEntries(objs.size());
+        const auto endianFlag = writer.endian_flag();
+
+        const auto encodeObj = [&](std::size_t i)
+        {
+            if (!objLayouts[i]) return;
+
+            // Get parameters.
+            const auto& obj = *objs[i];
+            radix_tree<hson::parameter> flatParams;
+            const auto& params = (obj.has_inherited_parameters(project)) ?
+                (flatParams = obj.get_flattened_parameters(project)) :
+                obj.parameters;
+
+            // Re-use the cached block for this object if it hasn't changed.
+            auto& newEntry = newEntries[i];
+            if (cache)
+            {
+                newEntry.fingerprint = in_hash_parameters(params, in_hash_combine(0,
+                    static_cast<u64>(reinterpret_cast<std::uintptr_t>(
+                        objLayouts[i]->def))));
+
+                newEntry.structDef = objLayouts[i]->def;
+
+                // NOTE: Different parameters can have the same fingerprint, so
+                // matching fingerprints only tell us the parameters are *probably*
+                // the same; we still have to compare them to make sure.
+                const auto entryIt = cache->m_entries.find(*objIDs[i]);
+                if (entryIt != cache->m_entries.end() &&
+                    entryIt->second.fingerprint == newEntry.fingerprint &&
+                    entryIt->second.structDef == newEntry.structDef &&
+                    in_parameters_equal(entryIt->second.parameters, params))
+                {
+                    objEntries[i] = &entryIt->second;
+                    return;
+                }
+            }
+
+            // Otherwise, encode a new block.
+            in_block_writer blockWriter(newEntry.block, endianFlag);
+            in_block_field_writer blockFieldWriter(blockWriter, fieldLayouts);
+
+            blockFieldWriter.write_parameters(*objLayouts[i], params);
+            objEntries[i] = &newEntry;
+
+            // Keep a copy of the parameters we encoded in the cache, so we
+            // can tell whether they've changed the next time we're called.
+            if (cache)
+            {
+                if (&params == &flatParams)
+                {
+                    newEntry.parameters = std::move(flatParams);
+                }
+                else
+                {
+                    newEntry.parameters = params;
+                }
+            }
+        };
+
+        if (pool)
+        {
+            pool->parallel_for(objs.size(), encodeObj);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < objs.size(); ++i)
+            {
+                encodeObj(i);
+            }
+        }
+
+        // Write parameters and tag data for each object.
+        radix_tree<hson::parameter> tagsBuf;
+        std::size_t curOffPos = objsPos;
+
+        for (std::size_t i = 0; i < objs.size(); ++i)
+        {
+            const auto& obj = *objs[i];
+            if (objLayouts[i])
+            {
+                // Align struct as necessary.
+                writer.pad(std::max<std::size_t>(objLayouts[i]->alignment, 16));
+
+                // Fix parameters offset.
+                writer.fix_offset(curOffPos + offsetof(raw_object, paramData));
+
+                // Copy the object's block into the file if it's suitably aligned.
+                auto& block = objEntries[i]->block;
+                if ((writer.tell() & (block.alignment - 1)) == 0)
+                {
+                    in_copy_block(block, writer);
+                }
+
+                // Otherwise, the block's padding would be different here,
+                // so we have to write the parameters directly instead.
+                else
+                {
+                    fieldWriter.write_parameters(*objLayouts[i],
+                        (obj.has_inherited_parameters(project)) ?
+                            obj.get_flattened_parameters(project) :
+                            obj.parameters);
+                }
+            }
+
+            // Update current offset position.
+            curOffPos += sizeof(raw_object);
+
+            // Write tag data as necessary.
+            in_write_tag_data(obj, project, tagsBuf, writer, curOffPos);
+        }
+
+        // Update the cache to contain exactly the objects we just wrote.
+        if (cache)
+        {
+            robin_hood::unordered_node_map<guid, in_entry> entries;
+            entries.reserve(objs.size());
+
+            for (std::size_t i = 0; i < objs.size(); ++i)
+            {
+                if (!objLayouts[i]) continue;
+                entries.emplace(*objIDs[i], std::move(*objEntries[i]));
+            }
+
+            cache->m_entries = std::move(entries);
+            cache->m_objTypeDB = &fieldLayouts.obj_type_db();
+            cache->m_endianFlag = endianFlag;
+            cache->m_tailEndAlignParentStructs =
+                fieldLayouts.tail_end_align_parent_structs();
+        }
+    }
+};
+
 void write(const hson::project& project,
     const set_object_type_database& objTypeDB,
-    bina::v2::writer64& writer, bool tailEndAlignParentStructs)
+    bina::v2::writer64& writer, bool tailEndAlignParentStructs,
+    write_cache* cache, thread_pool* pool)
 {
     // Start writing BINA data block.
     writer.start_data_block();
@@ -512,50 +1172,32 @@ void write(const hson::project& project,
     }
 
     // Write object parameters and tag data.
-    in_field_writer fieldWriter(writer, objTypeDB, tailEndAlignParentStructs);
-    curOffPos = objsPos;
-
-    for (auto it = project.objects.begin(); it != project.objects.end(); ++it)
+    in_field_layout_database fieldLayouts(objTypeDB, tailEndAlignParentStructs);
+    if (cache || pool)
     {
-        // Write parameters, and skip this object if it's not in the type database.
-        const auto& obj = it->second;
-        if (!fieldWriter.write_parameters(obj, project,
-            curOffPos + offsetof(raw_object, paramData)))
-        {
-            continue;
-        }
-
-        // Update current offset position.
-        curOffPos += sizeof(raw_object);
+        in_world_writer::write_parameters(project, fieldLayouts,
+            writer, objsPos, cache, pool);
+    }
+    else
+    {
+        in_field_writer fieldWriter(writer, fieldLayouts);
+        curOffPos = objsPos;
 
-        // Write tag data as necessary.
-        const auto curObjTags = in_get_tags(obj, project, tagsBuf);
-        if (curObjTags)
+        for (auto it = project.objects.begin(); it != project.objects.end(); ++it)
         {
-            const auto tagCount = in_get_supported_tag_count(*curObjTags);
-            if (!tagCount) continue;
-
-            // Increase offset position.
-            curOffPos += (sizeof(off64<raw_tag>) * tagCount);
-            curOffPos = align(curOffPos, 16);
-
-            // Write tag data for supported tags.
-            for (const auto it : *curObjTags)
+            // Write parameters, and skip this object if it's not in the type database.
+            const auto& obj = it->second;
+            if (!fieldWriter.write_parameters(obj, project,
+                curOffPos + offsetof(raw_object, paramData)))
             {
-                // Get info for the current tag.
-                const auto tagInfo = in_get_tag_info(it.first);
-                if (!tagInfo) continue;
-
-                // Pad stream and fix tag data offset.
-                writer.pad(tagInfo->align);
-                writer.fix_offset(curOffPos + offsetof(raw_tag, dataPtr));
+                continue;
+            }
 
-                // Write tag data.
-                tagInfo->writeData(it.second, writer);
+            // Update current offset position.
+            curOffPos += sizeof(raw_object);
 
-                // Increase offset position.
-                curOffPos += sizeof(raw_tag);
-            }
+            // Write tag data as necessary.
+            in_write_tag_data(obj, project, tagsBuf, writer, curOffPos);
         }
     }
 
@@ -566,22 +1208,103 @@ void write(const hson::project& project,
 void save(const hson::project& project,
     const set_object_type_database& objTypeDB,
     bina::endian_flag endianFlag, stream& stream,
-    bool tailEndAlignParentStructs)
+    bool tailEndAlignParentStructs, write_cache* cache,
+    thread_pool* pool)
 {
     bina::v2::writer64 writer(stream);
     writer.start(endianFlag);
-    write(project, objTypeDB, writer, tailEndAlignParentStructs);
+    write(project, objTypeDB, writer, tailEndAlignParentStructs, cache, pool);
     writer.finish();
 }
 
 void save(const hson::project& project,
     const set_object_type_database& objTypeDB,
     bina::endian_flag endianFlag, const nchar* filePath,
-    bool tailEndAlignParentStructs)
+    bool tailEndAlignParentStructs, write_cache* cache,
+    thread_pool* pool)
 {
     file_stream stream(filePath, file::mode::write);
-    save(project, objTypeDB, endianFlag,
-        stream, tailEndAlignParentStructs);
+    save(project, objTypeDB, endianFlag, stream,
+        tailEndAlignParentStructs, cache, pool);
+
+    // Close file.
+    stream.close();
+}
+
+void convert_to_hson(const nchar* inputFilePath,
+    const nchar* outputFilePath,
+    const set_object_type_database& objTypeDB,
+    bool tailEndAlignParentStructs)
+{
+    // Load and fix gedit data.
+    blob rawData(inputFilePath);
+    const auto rawWorld = bina::fix64<raw_world>(rawData);
+
+    // Add gedit objects to a new HSON project and save it.
+    hson::project hsonProject;
+    rawWorld->add_to_hson(hsonProject, &objTypeDB,
+        tailEndAlignParentStructs);
+
+    hsonProject.save(outputFilePath);
+}
+
+void convert_to_hson(const std::vector<nstring>& inputFilePaths,
+    const std::vector<nstring>& outputFilePaths,
+    const set_object_type_database& objTypeDB,
+    bool tailEndAlignParentStructs,
+    std::vector<std::exception_ptr>* errors,
+    thread_pool* pool)
+{
+    if (inputFilePaths.size() != outputFilePaths.size())
+    {
+        throw std::runtime_error(
+            "The number of input and output file paths must match");
+    }
+
+    // Convert each file, storing any errors at the file's index rather
+    // than letting them stop the batch, so that the same files are always
+    // converted regardless of which thread happens to fail first.
+    std::vector<std::exception_ptr> fileErrors(inputFilePaths.size());
+    const auto convertFile = [&](std::size_t i)
+    {
+        try
+        {
+            convert_to_hson(inputFilePaths[i].c_str(),
+                outputFilePaths[i].c_str(), objTypeDB,
+                tailEndAlignParentStructs);
+        }
+        catch (...)
+        {
+            fileErrors[i] = std::current_exception();
+        }
+    };
+
+    if (pool)
+    {
+        pool->parallel_for(inputFilePaths.size(), convertFile);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < inputFilePaths.size(); ++i)
+        {
+            convertFile(i);
+        }
+    }
+
+    // Report errors.
+    if (errors)
+    {
+        *errors = std::move(fileErrors);
+        return;
+    }
+
+    for (const auto& fileError : fileErrors)
+    {
+        if (fileError)
+        {
+            std::rethrow_exception(fileError);
+        }
+    }
 }
 } // v3
 } // gedit
@@ -102,8 +102,11 @@ hl::blob readonly_package_wrapper::load_blob(u32 index) const
     const raw_package_blob& rawBlob = m_package->blobs()[index];
     hl::blob blob(static_cast<size_t>(rawBlob.dataSize));
 
-    m_stream->seek(hl::seek_mode::beg, rawBlob.dataOffset);
-    m_stream->read(blob.size(), blob.data());
+    // NOTE: We use a positional read here so that multiple threads can
+    // load blobs from the same package at once without racing on the
+    // stream's position.
+    m_stream->read_all_at(static_cast<std::size_t>(rawBlob.dataOffset),
+        blob.size(), blob.data());
 
     return blob;
 }
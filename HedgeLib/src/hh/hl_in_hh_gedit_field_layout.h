@@ -0,0 +1,775 @@
+#ifndef HL_IN_HH_GEDIT_FIELD_LAYOUT_H_INCLUDED
+#define HL_IN_HH_GEDIT_FIELD_LAYOUT_H_INCLUDED
+
+#include "hl_in_hh_gedit.h"
+#include "hedgelib/sets/hl_set_obj_type.h"
+#include <robin_hood.h>
+#include <algorithm>
+
+namespace hl
+{
+namespace hh
+{
+namespace gedit
+{
+namespace internal
+{
+enum class in_field_kind : u8
+{
+    _bool,
+    float32,
+    float64,
+
+    int8,
+    int16,
+    int32,
+    int64,
+
+    uint8,
+    uint16,
+    uint32,
+    uint64,
+
+    _char,
+    string,
+    object_reference,
+    vector2,
+    vector3,
+    vector4,
+    quaternion,
+
+    _enum,
+    _struct
+};
+
+enum class in_field_container : u8
+{
+    none = 0,
+    dynamic_array,
+    fixed_array
+};
+
+/**
+ * @brief Determines the field kind of the given built-in type name.
+ *
+ * @param type The type name to check.
+ * @param kind The kind to store the result in, if the type is a built-in type.
+ * @return bool True if the given type is a supported built-in type, false otherwise.
+ */
+inline bool in_get_builtin_field_kind(std::string_view type, in_field_kind& kind) noexcept
+{
+    // NOTE: Conditions are sorted based on assumed frequency.
+
+    if (type == reflect::builtin_type_id_bool)                  kind = in_field_kind::_bool;
+    else if (type == reflect::builtin_type_id_float32)          kind = in_field_kind::float32;
+    else if (type == reflect::builtin_type_id_int32)            kind = in_field_kind::int32;
+    else if (type == reflect::builtin_type_id_uint32)           kind = in_field_kind::uint32;
+    else if (type == reflect::builtin_type_id_string)           kind = in_field_kind::string;
+    else if (type == reflect::builtin_type_id_vector3)          kind = in_field_kind::vector3;
+    else if (type == reflect::builtin_type_id_object_reference) kind = in_field_kind::object_reference;
+    else if (type == reflect::builtin_type_id_uint8)            kind = in_field_kind::uint8;
+    else if (type == reflect::builtin_type_id_int8)             kind = in_field_kind::int8;
+    else if (type == reflect::builtin_type_id_uint16)           kind = in_field_kind::uint16;
+    else if (type == reflect::builtin_type_id_int16)            kind = in_field_kind::int16;
+    else if (type == reflect::builtin_type_id_vector2)          kind = in_field_kind::vector2;
+    else if (type == reflect::builtin_type_id_vector4)          kind = in_field_kind::vector4;
+    else if (type == reflect::builtin_type_id_quaternion)       kind = in_field_kind::quaternion;
+    else if (type == reflect::builtin_type_id_float64)          kind = in_field_kind::float64;
+    else if (type == reflect::builtin_type_id_uint64)           kind = in_field_kind::uint64;
+    else if (type == reflect::builtin_type_id_int64)            kind = in_field_kind::int64;
+    else if (type == reflect::builtin_type_id_char)             kind = in_field_kind::_char;
+    else return false;
+
+    return true;
+}
+
+struct in_struct_layout;
+
+/**
+ * @brief A pre-resolved description of a single struct field.
+ *
+ * For arrays, the kind, enum/struct references, and element alignment
+ * describe the array's elements rather than the array itself.
+ */
+struct in_field_layout
+{
+    /** @brief The field definition this layout was compiled from. */
+    const reflect::field_definition* def;
+    /** @brief The definition of this field's enum type, if kind is _enum. */
+    const reflect::enum_definition* enumDef;
+    /** @brief The definition of this field's struct type, if kind is _struct. */
+    const reflect::struct_definition* structDef;
+    /**
+     * @brief The layout of this field's struct type, if kind is _struct.
+     *
+     * For dynamic arrays, this is resolved only once the outermost struct
+     * being compiled has finished compiling, so it may be nullptr until then.
+     */
+    const in_struct_layout* structLayout;
+    /**
+     * @brief The offset of this field relative to the start of its struct,
+     * valid whenever the struct starts at a multiple of its maxAlignment.
+     */
+    std::size_t offset;
+    /** @brief The custom alignment of this field, or 0 to use default alignment. */
+    std::size_t alignment;
+    /** @brief The default alignment of a single element of this field. */
+    std::size_t elementAlignment;
+    /** @brief The largest alignment applied anywhere within this field. */
+    std::size_t maxAlignment;
+    /** @brief The number of elements in this field if it is a fixed-sized array. */
+    std::size_t arrayCount;
+    in_field_container container;
+    in_field_kind kind;
+    /** @brief The integral type of this field's enum type, if kind is _enum. */
+    reflect::integral_type enumType;
+    /** @brief Whether this field contains dynamic arrays which have out-of-line data. */
+    bool hasDynamicArrays;
+};
+
+/**
+ * @brief A pre-resolved description of a struct and all of its fields.
+ */
+struct in_struct_layout
+{
+    /** @brief The struct definition this layout was compiled from. */
+    const reflect::struct_definition* def = nullptr;
+    /** @brief The layout of this struct's parent, or nullptr if it has no parent. */
+    const in_struct_layout* parent = nullptr;
+    std::vector<in_field_layout> fields;
+    /** @brief The "real" alignment of this struct. */
+    std::size_t alignment = 1;
+    /** @brief The largest alignment applied anywhere within this struct. */
+    std::size_t maxAlignment = 1;
+    /**
+     * @brief The size of this struct's fields (not including tail-end alignment),
+     * valid whenever the struct starts at a multiple of maxAlignment.
+     */
+    std::size_t size = 0;
+    /** @brief Whether this struct contains dynamic arrays which have out-of-line data. */
+    bool hasDynamicArrays = false;
+    /** @brief Whether this struct's parent is followed by tail-end alignment. */
+    bool parentTailEndAligned = false;
+    /** @brief Whether this struct's layout has been fully compiled yet. */
+    bool isCompiled = false;
+};
+
+/**
+ * @brief Compiles the struct definitions within a set object type database
+ * into flat, pre-resolved layouts, and caches them for re-use.
+ *
+ * Layouts are compiled lazily the first time they are requested, so this
+ * class is not thread-safe; use one instance per thread.
+ */
+template<typename RawObjectIDType,
+    template<typename> typename RawOffsetType,
+    template<typename> typename RawArrayType>
+class in_field_layout_database
+{
+    static inline constexpr const std::size_t* in_builtin_type_alignments =
+        internal::in_builtin_type_alignments<
+            RawObjectIDType, RawOffsetType, RawArrayType>;
+
+    const set_object_type_database* m_objTypeDB;
+    bool m_tailEndAlignParentStructs;
+    robin_hood::unordered_node_map<const reflect::struct_definition*,
+        in_struct_layout> m_structLayouts;
+    std::vector<in_field_layout*> m_pendingFields;
+    std::size_t m_compileDepth;
+
+    template<typename T>
+    static inline std::size_t in_jump_past_primitive(
+        std::size_t pos, std::size_t fieldAlignment) noexcept
+    {
+        pos = align(pos, (fieldAlignment) ? fieldAlignment : alignof(T));
+        return pos + sizeof(T);
+    }
+
+    static inline std::size_t in_jump_past_object(std::size_t pos,
+        std::size_t fieldAlignment, std::size_t size,
+        std::size_t defaultAlignment) noexcept
+    {
+        if (!fieldAlignment)
+        {
+            fieldAlignment = defaultAlignment;
+        }
+
+        pos = align(pos, fieldAlignment);
+        pos += size;
+        return align(pos, fieldAlignment);
+    }
+
+    template<typename T>
+    static inline std::size_t in_jump_past_object(
+        std::size_t pos, std::size_t fieldAlignment) noexcept
+    {
+        return in_jump_past_object(pos, fieldAlignment,
+            sizeof(T), alignof(T));
+    }
+
+    static std::size_t in_get_builtin_alignment(in_field_kind kind) noexcept
+    {
+        switch (kind)
+        {
+        case in_field_kind::_bool:
+            return in_builtin_type_alignments[reflect::builtin_type::_bool];
+
+        case in_field_kind::float32:
+            return in_builtin_type_alignments[reflect::builtin_type::float32];
+
+        case in_field_kind::float64:
+            return in_builtin_type_alignments[reflect::builtin_type::float64];
+
+        case in_field_kind::int8:
+            return in_builtin_type_alignments[reflect::builtin_type::int8];
+
+        case in_field_kind::int16:
+            return in_builtin_type_alignments[reflect::builtin_type::int16];
+
+        case in_field_kind::int32:
+            return in_builtin_type_alignments[reflect::builtin_type::int32];
+
+        case in_field_kind::int64:
+            return in_builtin_type_alignments[reflect::builtin_type::int64];
+
+        case in_field_kind::uint8:
+            return in_builtin_type_alignments[reflect::builtin_type::uint8];
+
+        case in_field_kind::uint16:
+            return in_builtin_type_alignments[reflect::builtin_type::uint16];
+
+        case in_field_kind::uint32:
+            return in_builtin_type_alignments[reflect::builtin_type::uint32];
+
+        case in_field_kind::uint64:
+            return in_builtin_type_alignments[reflect::builtin_type::uint64];
+
+        case in_field_kind::_char:
+            return in_builtin_type_alignments[reflect::builtin_type::_char];
+
+        case in_field_kind::string:
+            return in_builtin_type_alignments[reflect::builtin_type::string];
+
+        case in_field_kind::object_reference:
+            return in_builtin_type_alignments[reflect::builtin_type::object_reference];
+
+        case in_field_kind::vector2:
+            return in_builtin_type_alignments[reflect::builtin_type::vector2];
+
+        case in_field_kind::vector3:
+            return in_builtin_type_alignments[reflect::builtin_type::vector3];
+
+        case in_field_kind::vector4:
+            return in_builtin_type_alignments[reflect::builtin_type::vector4];
+
+        case in_field_kind::quaternion:
+            return in_builtin_type_alignments[reflect::builtin_type::quaternion];
+
+        default:
+            return 1;
+        }
+    }
+
+    /**
+     * @brief Computes the largest alignment applied while laying out
+     * a single element of the given field.
+     *
+     * @param fieldInfo The field whose element alignment should be computed.
+     * @param fieldAlignment The custom alignment of the element, or 0 to use default alignment.
+     * @return std::size_t The largest alignment applied while laying out the element.
+     */
+    static std::size_t in_get_element_max_alignment(
+        const in_field_layout& fieldInfo, std::size_t fieldAlignment) noexcept
+    {
+        // Account for any alignment done within structs.
+        if (fieldInfo.kind == in_field_kind::_struct)
+        {
+            return std::max<std::size_t>((fieldAlignment) ?
+                fieldAlignment : fieldInfo.structLayout->alignment,
+                fieldInfo.structLayout->maxAlignment);
+        }
+
+        // Otherwise, just use the element's alignment.
+        return (fieldAlignment) ? fieldAlignment : fieldInfo.elementAlignment;
+    }
+
+    void in_compile_field(in_field_layout& fieldInfo, const reflect::field_definition& fieldDef)
+    {
+        fieldInfo.def = &fieldDef;
+        fieldInfo.enumDef = nullptr;
+        fieldInfo.structDef = nullptr;
+        fieldInfo.structLayout = nullptr;
+        fieldInfo.offset = 0;
+        fieldInfo.alignment = fieldDef.alignment;
+        fieldInfo.arrayCount = 0;
+        fieldInfo.container = in_field_container::none;
+        fieldInfo.enumType = reflect::integral_type::int32;
+        fieldInfo.hasDynamicArrays = false;
+
+        // Determine container type.
+        std::string_view elemType(fieldDef.type());
+        if (fieldDef.is_array())
+        {
+            fieldInfo.arrayCount = fieldDef.array_count();
+            fieldInfo.container = (fieldInfo.arrayCount) ?
+                in_field_container::fixed_array :
+                in_field_container::dynamic_array;
+
+            fieldInfo.hasDynamicArrays = !fieldInfo.arrayCount;
+            elemType = fieldDef.subtype();
+        }
+
+        // Resolve built-in element types.
+        if (in_get_builtin_field_kind(elemType, fieldInfo.kind))
+        {
+            fieldInfo.elementAlignment = in_get_builtin_alignment(fieldInfo.kind);
+        }
+        else
+        {
+            // Resolve enum element types.
+            const auto enumDef = m_objTypeDB->enums.get(elemType.data());
+            if (enumDef)
+            {
+                fieldInfo.kind = in_field_kind::_enum;
+                fieldInfo.enumDef = enumDef;
+                fieldInfo.enumType = enumDef->type;
+                fieldInfo.elementAlignment = in_builtin_type_alignments[
+                    static_cast<reflect::builtin_type>(enumDef->type)];
+            }
+
+            // Resolve struct element types.
+            else
+            {
+                const auto structDef = m_objTypeDB->structs.get(elemType.data());
+                if (!structDef)
+                {
+                    throw std::runtime_error("Unknown or unsupported field type");
+                }
+
+                fieldInfo.kind = in_field_kind::_struct;
+                fieldInfo.structDef = structDef;
+
+                // NOTE: The elements of dynamic arrays are not stored inline, so
+                // they're allowed to (even indirectly) contain the struct that owns
+                // the array. We defer compiling their layouts until no struct is
+                // mid-compile; nothing about this field's own layout depends on them.
+                if (fieldInfo.container == in_field_container::dynamic_array)
+                {
+                    fieldInfo.elementAlignment = 1;
+                    m_pendingFields.push_back(&fieldInfo);
+                }
+                else
+                {
+                    const auto& structLayout = in_get(*structDef);
+                    if (!structLayout.isCompiled)
+                    {
+                        throw std::runtime_error("Struct type recursively contains itself");
+                    }
+
+                    fieldInfo.structLayout = &structLayout;
+                    fieldInfo.elementAlignment = structLayout.alignment;
+                    fieldInfo.hasDynamicArrays = structLayout.hasDynamicArrays;
+                }
+            }
+        }
+
+        // Compute the largest alignment applied while laying out this field.
+        switch (fieldInfo.container)
+        {
+        case in_field_container::dynamic_array:
+            fieldInfo.maxAlignment = (fieldInfo.alignment) ? fieldInfo.alignment :
+                in_builtin_type_alignments[reflect::builtin_type::array];
+            break;
+
+        case in_field_container::fixed_array:
+            fieldInfo.maxAlignment = (fieldInfo.alignment) ?
+                std::max<std::size_t>(fieldInfo.alignment,
+                    in_get_element_max_alignment(fieldInfo, 1)) :
+                in_get_element_max_alignment(fieldInfo, 0);
+            break;
+
+        default:
+            fieldInfo.maxAlignment = in_get_element_max_alignment(
+                fieldInfo, fieldInfo.alignment);
+            break;
+        }
+    }
+
+    void in_compile_struct(in_struct_layout& structLayout,
+        const reflect::struct_definition& structDef)
+    {
+        structLayout.def = &structDef;
+
+        // Compile parent struct layout.
+        if (!structDef.parent.empty())
+        {
+            const auto parentStructDef = m_objTypeDB->structs.get(structDef.parent);
+            if (!parentStructDef)
+            {
+                throw std::runtime_error("Could not find parent struct type in database");
+            }
+
+            const auto& parentLayout = in_get(*parentStructDef);
+            if (!parentLayout.isCompiled)
+            {
+                throw std::runtime_error("Struct type recursively contains itself");
+            }
+
+            structLayout.parent = &parentLayout;
+            structLayout.parentTailEndAligned = m_tailEndAlignParentStructs;
+            structLayout.alignment = parentLayout.alignment;
+            structLayout.maxAlignment = (m_tailEndAlignParentStructs) ?
+                std::max<std::size_t>(parentLayout.maxAlignment, parentLayout.alignment) :
+                parentLayout.maxAlignment;
+
+            structLayout.hasDynamicArrays = parentLayout.hasDynamicArrays;
+        }
+
+        // Compile field layouts.
+        structLayout.fields.resize(structDef.fields.size());
+        for (std::size_t i = 0; i < structDef.fields.size(); ++i)
+        {
+            auto& fieldInfo = structLayout.fields[i];
+            in_compile_field(fieldInfo, structDef.fields[i]);
+
+            // Account for field alignment.
+            const auto fieldRealAlignment = (fieldInfo.alignment) ?
+                fieldInfo.alignment :
+                (fieldInfo.container == in_field_container::dynamic_array) ?
+                in_builtin_type_alignments[reflect::builtin_type::array] :
+                fieldInfo.elementAlignment;
+
+            if (fieldRealAlignment > structLayout.alignment)
+            {
+                structLayout.alignment = fieldRealAlignment;
+            }
+
+            if (fieldInfo.maxAlignment > structLayout.maxAlignment)
+            {
+                structLayout.maxAlignment = fieldInfo.maxAlignment;
+            }
+
+            structLayout.hasDynamicArrays |= fieldInfo.hasDynamicArrays;
+        }
+
+        // If this struct has a custom alignment, use it instead.
+        if (structDef.alignment)
+        {
+            structLayout.alignment = structDef.alignment;
+        }
+
+        // Compute field offsets, starting from an offset of 0.
+        std::size_t pos = 0;
+        if (structLayout.parent)
+        {
+            pos = structLayout.parent->size;
+            if (structLayout.parentTailEndAligned)
+            {
+                pos = align(pos, structLayout.parent->alignment);
+            }
+        }
+
+        for (auto& fieldInfo : structLayout.fields)
+        {
+            fieldInfo.offset = in_get_field_offset(pos, fieldInfo);
+            pos = jump_past_field(pos, fieldInfo);
+        }
+
+        structLayout.size = pos;
+        structLayout.isCompiled = true;
+    }
+
+    void in_resolve_pending_fields()
+    {
+        // NOTE: Compiling these layouts can queue up more pending fields,
+        // which this loop will then pick up as well.
+        while (!m_pendingFields.empty())
+        {
+            auto& fieldInfo = *m_pendingFields.back();
+            m_pendingFields.pop_back();
+
+            const auto& structLayout = in_get(*fieldInfo.structDef);
+            fieldInfo.structLayout = &structLayout;
+            fieldInfo.elementAlignment = structLayout.alignment;
+        }
+    }
+
+    const in_struct_layout& in_get(const reflect::struct_definition& structDef)
+    {
+        // Return the existing layout for this struct if we already have one.
+        auto it = m_structLayouts.find(&structDef);
+        if (it != m_structLayouts.end())
+        {
+            return it->second;
+        }
+
+        // Otherwise, compile a new layout for this struct.
+        // NOTE: We add the layout to the map before compiling it, so
+        // any structs which refer back to it can find it.
+        auto& structLayout = m_structLayouts[&structDef];
+        ++m_compileDepth;
+
+        try
+        {
+            in_compile_struct(structLayout, structDef);
+
+            // Resolve the element layouts of any dynamic arrays once
+            // no other structs are still in the middle of compiling.
+            if (m_compileDepth == 1)
+            {
+                in_resolve_pending_fields();
+            }
+        }
+        catch (...)
+        {
+            // NOTE: Other layouts may already refer to this one, so
+            // we have to discard all of them to avoid dangling pointers.
+            m_structLayouts.clear();
+            m_pendingFields.clear();
+            --m_compileDepth;
+            throw;
+        }
+
+        --m_compileDepth;
+        return structLayout;
+    }
+
+    static std::size_t in_get_field_offset(std::size_t pos,
+        const in_field_layout& fieldInfo) noexcept
+    {
+        // Fields start wherever their first alignment puts them.
+        if (fieldInfo.alignment)
+        {
+            return align(pos, fieldInfo.alignment);
+        }
+
+        return align(pos, (fieldInfo.container == in_field_container::dynamic_array) ?
+            alignof(RawArrayType<void>) : fieldInfo.elementAlignment);
+    }
+
+    static constexpr std::size_t in_get_integral_size(reflect::integral_type type) noexcept
+    {
+        switch (type)
+        {
+        case reflect::integral_type::int8:
+        case reflect::integral_type::uint8:
+            return 1;
+
+        case reflect::integral_type::int16:
+        case reflect::integral_type::uint16:
+            return 2;
+
+        case reflect::integral_type::int32:
+        case reflect::integral_type::uint32:
+            return 4;
+
+        default:
+            return 8;
+        }
+    }
+
+public:
+    inline const set_object_type_database& obj_type_db() const noexcept
+    {
+        return *m_objTypeDB;
+    }
+
+    inline bool tail_end_align_parent_structs() const noexcept
+    {
+        return m_tailEndAlignParentStructs;
+    }
+
+    /**
+     * @brief Gets the layout of the given struct, compiling it if necessary.
+     *
+     * @param structDef The struct definition to get the layout of. Must be
+     * owned by the set object type database this layout database was created with.
+     * @return const in_struct_layout& The compiled layout of the given struct.
+     */
+    inline const in_struct_layout& get(const reflect::struct_definition& structDef)
+    {
+        return in_get(structDef);
+    }
+
+    /**
+     * @brief Determines whether the given position is suitably aligned to
+     * use the pre-computed field offsets and size of the given struct.
+     */
+    static inline bool has_static_layout(std::size_t pos,
+        const in_struct_layout& structLayout) noexcept
+    {
+        return ((pos & (structLayout.maxAlignment - 1)) == 0);
+    }
+
+    /**
+     * @brief Computes the position after a single element of the given field.
+     *
+     * @param pos The position before the element.
+     * @param fieldInfo The field whose element type should be used.
+     * @param fieldAlignment The custom alignment of the element, or 0 to use default alignment.
+     * @return std::size_t The position after the element.
+     */
+    static std::size_t jump_past_element(std::size_t pos,
+        const in_field_layout& fieldInfo, std::size_t fieldAlignment = 0) noexcept
+    {
+        switch (fieldInfo.kind)
+        {
+        case in_field_kind::_bool:
+        case in_field_kind::int8:
+        case in_field_kind::uint8:
+        case in_field_kind::_char:
+            return in_jump_past_primitive<u8>(pos, fieldAlignment);
+
+        case in_field_kind::int16:
+        case in_field_kind::uint16:
+            return in_jump_past_primitive<u16>(pos, fieldAlignment);
+
+        case in_field_kind::float32:
+            return in_jump_past_primitive<float>(pos, fieldAlignment);
+
+        case in_field_kind::int32:
+        case in_field_kind::uint32:
+            return in_jump_past_primitive<u32>(pos, fieldAlignment);
+
+        case in_field_kind::float64:
+            return in_jump_past_primitive<double>(pos, fieldAlignment);
+
+        case in_field_kind::int64:
+        case in_field_kind::uint64:
+            return in_jump_past_primitive<u64>(pos, fieldAlignment);
+
+        case in_field_kind::string:
+            return in_jump_past_object(pos, fieldAlignment,
+                sizeof(RawOffsetType<char>) * 2,
+                alignof(RawOffsetType<char>));
+
+        case in_field_kind::object_reference:
+            return in_jump_past_object<RawObjectIDType>(pos, fieldAlignment);
+
+        case in_field_kind::vector2:
+            return in_jump_past_object<vec2>(pos, fieldAlignment);
+
+        case in_field_kind::vector3:
+            return in_jump_past_object<vec3>(pos, fieldAlignment);
+
+        case in_field_kind::vector4:
+            return in_jump_past_object<vec4>(pos,
+                (fieldAlignment) ? fieldAlignment : 16);
+
+        case in_field_kind::quaternion:
+            return in_jump_past_object<quat>(pos,
+                (fieldAlignment) ? fieldAlignment : 16);
+
+        case in_field_kind::_enum:
+            pos = align(pos, (fieldAlignment) ?
+                fieldAlignment : fieldInfo.elementAlignment);
+
+            return pos + in_get_integral_size(fieldInfo.enumType);
+
+        case in_field_kind::_struct:
+        {
+            if (!fieldAlignment)
+            {
+                fieldAlignment = fieldInfo.structLayout->alignment;
+            }
+
+            pos = align(pos, fieldAlignment);
+            pos = jump_past_struct_fields(pos, *fieldInfo.structLayout);
+
+            // NOTE: We have to do tail-end alignment for structs.
+            return align(pos, fieldAlignment);
+        }
+
+        default:
+            return pos;
+        }
+    }
+
+    /**
+     * @brief Computes the position after the given field.
+     *
+     * @param pos The position before the field.
+     * @param fieldInfo The field to compute the position after.
+     * @return std::size_t The position after the field.
+     */
+    static std::size_t jump_past_field(std::size_t pos,
+        const in_field_layout& fieldInfo) noexcept
+    {
+        switch (fieldInfo.container)
+        {
+        case in_field_container::dynamic_array:
+            return in_jump_past_object(pos, fieldInfo.alignment,
+                sizeof(RawArrayType<void>), alignof(RawArrayType<void>));
+
+        case in_field_container::fixed_array:
+        {
+            std::size_t fieldAlignment;
+            if (fieldInfo.alignment)
+            {
+                pos = align(pos, fieldInfo.alignment);
+                fieldAlignment = 1; // Align of 1; disables alignment.
+            }
+            else
+            {
+                fieldAlignment = 0; // Align of 0; use default alignment.
+            }
+
+            for (std::size_t i = 0; i < fieldInfo.arrayCount; ++i)
+            {
+                pos = jump_past_element(pos, fieldInfo, fieldAlignment);
+            }
+
+            return pos;
+        }
+
+        default:
+            return jump_past_element(pos, fieldInfo, fieldInfo.alignment);
+        }
+    }
+
+    /**
+     * @brief Computes the position after the fields of the given struct
+     * (not including tail-end alignment).
+     *
+     * @param pos The position of the start of the struct.
+     * @param structLayout The struct to compute the position after.
+     * @return std::size_t The position after the struct's fields.
+     */
+    static std::size_t jump_past_struct_fields(std::size_t pos,
+        const in_struct_layout& structLayout) noexcept
+    {
+        // Use pre-computed struct size if possible.
+        if (has_static_layout(pos, structLayout))
+        {
+            return pos + structLayout.size;
+        }
+
+        // Otherwise, walk through each field.
+        if (structLayout.parent)
+        {
+            pos = jump_past_struct_fields(pos, *structLayout.parent);
+            if (structLayout.parentTailEndAligned)
+            {
+                pos = align(pos, structLayout.parent->alignment);
+            }
+        }
+
+        for (const auto& fieldInfo : structLayout.fields)
+        {
+            pos = jump_past_field(pos, fieldInfo);
+        }
+
+        return pos;
+    }
+
+    in_field_layout_database(const set_object_type_database& objTypeDB,
+        bool tailEndAlignParentStructs) noexcept :
+        m_objTypeDB(&objTypeDB),
+        m_tailEndAlignParentStructs(tailEndAlignParentStructs),
+        m_compileDepth(0) {}
+};
+} // internal
+} // gedit
+} // hh
+} // hl
+#endif
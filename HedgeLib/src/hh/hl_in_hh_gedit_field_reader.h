@@ -1,7 +1,7 @@
 #ifndef HL_IN_HH_GEDIT_FIELD_READER_H_INCLUDED
 #define HL_IN_HH_GEDIT_FIELD_READER_H_INCLUDED
 
-#include "hl_in_hh_gedit.h"
+#include "hl_in_hh_gedit_field_layout.h"
 #include "hedgelib/sets/hl_set_obj_type.h"
 #include "hedgelib/sets/hl_hson.h"
 
@@ -21,12 +21,28 @@ template<typename RawObjectIDType,
     template<typename> typename RawArrayType>
 class in_field_reader : public reflect::field_reader
 {
-    static inline constexpr const std::size_t* in_builtin_type_alignments =
-        internal::in_builtin_type_alignments<
-            RawObjectIDType, RawOffsetType, RawArrayType>;
+public:
+    using layout_database = in_field_layout_database<
+        RawObjectIDType, RawOffsetType, RawArrayType>;
 
-    const set_object_type_database* m_objTypeDB;
-    bool m_tailEndAlignParentStructs;
+private:
+    layout_database* m_layouts;
+
+    template<typename T>
+    hson::parameter in_read_int(std::size_t fieldAlignment)
+    {
+        hson::parameter hsonParam(hson::parameter_type::signed_integer);
+        hsonParam.value_int() = static_cast<std::intmax_t>(read<T>(fieldAlignment));
+        return hsonParam;
+    }
+
+    template<typename T>
+    hson::parameter in_read_uint(std::size_t fieldAlignment)
+    {
+        hson::parameter hsonParam(hson::parameter_type::unsigned_integer);
+        hsonParam.value_uint() = static_cast<std::uintmax_t>(read<T>(fieldAlignment));
+        return hsonParam;
+    }
 
     /**
      * @brief Reads a vector of the given type (i.e. vec2, vec3, vec4, quat).
@@ -58,42 +74,70 @@ class in_field_reader : public reflect::field_reader
     }
 
     /**
-     * @brief Reads one element of the given type.
+     * @brief Reads one element of the given field.
      * 
-     * @param fieldType The type of element to read.
+     * @param fieldInfo The field whose element type should be read.
      * @param fieldAlignment The custom alignment of this element, or 0 to use default alignment.
      * @return hson::parameter A HSON parameter representing the element.
      */
     hson::parameter in_read_element(
-        std::string_view fieldType, std::size_t fieldAlignment = 0)
+        const in_field_layout& fieldInfo, std::size_t fieldAlignment = 0)
     {
-        // NOTE: Conditions are sorted based on assumed frequency.
-
-        if (reflect::is_bool_type(fieldType))
+        switch (fieldInfo.kind)
+        {
+        case in_field_kind::_bool:
         {
             hson::parameter hsonParam(hson::parameter_type::boolean);
             hsonParam.value_bool() = read<u8>(fieldAlignment);
             return hsonParam;
         }
-        else if (reflect::is_floating_type(fieldType))
+
+        case in_field_kind::float32:
         {
             hson::parameter hsonParam(hson::parameter_type::floating);
-            hsonParam.value_floating() = read_floating(fieldType, fieldAlignment);
+            hsonParam.value_floating() = read<float>(fieldAlignment);
             return hsonParam;
         }
-        else if (reflect::is_int_type(fieldType))
+
+        case in_field_kind::float64:
         {
-            hson::parameter hsonParam(hson::parameter_type::signed_integer);
-            hsonParam.value_int() = read_int(fieldType, fieldAlignment);
+            hson::parameter hsonParam(hson::parameter_type::floating);
+            hsonParam.value_floating() = read<double>(fieldAlignment);
             return hsonParam;
         }
-        else if (reflect::is_uint_type(fieldType))
+
+        case in_field_kind::int8:
+            return in_read_int<s8>(fieldAlignment);
+
+        case in_field_kind::int16:
+            return in_read_int<s16>(fieldAlignment);
+
+        case in_field_kind::int32:
+            return in_read_int<s32>(fieldAlignment);
+
+        case in_field_kind::int64:
+            return in_read_int<s64>(fieldAlignment);
+
+        case in_field_kind::uint8:
+            return in_read_uint<u8>(fieldAlignment);
+
+        case in_field_kind::uint16:
+            return in_read_uint<u16>(fieldAlignment);
+
+        case in_field_kind::uint32:
+            return in_read_uint<u32>(fieldAlignment);
+
+        case in_field_kind::uint64:
+            return in_read_uint<u64>(fieldAlignment);
+
+        case in_field_kind::_char:
         {
-            hson::parameter hsonParam(hson::parameter_type::unsigned_integer);
-            hsonParam.value_uint() = read_uint(fieldType, fieldAlignment);
+            hson::parameter hsonParam(hson::parameter_type::string);
+            hsonParam.value_string() = static_cast<char>(read<u8>(fieldAlignment));
             return hsonParam;
         }
-        else if (reflect::is_string_type(fieldType))
+
+        case in_field_kind::string:
         {
             hson::parameter hsonParam(hson::parameter_type::string);
             align((fieldAlignment) ? fieldAlignment : alignof(RawOffsetType<char>));
@@ -117,11 +161,8 @@ class in_field_reader : public reflect::field_reader
 
             return hsonParam;
         }
-        else if (reflect::is_vec3_type(fieldType))
-        {
-            return in_read_vector<vec3>(fieldAlignment);
-        }
-        else if (reflect::is_object_reference_type(fieldType))
+
+        case in_field_kind::object_reference:
         {
             const auto rawObjRef = read<RawObjectIDType>(fieldAlignment);
             hson::parameter hsonParam(hson::parameter_type::string);
@@ -135,158 +176,145 @@ class in_field_reader : public reflect::field_reader
 
             return hsonParam;
         }
-        else if (reflect::is_vec2_type(fieldType))
-        {
+
+        case in_field_kind::vector2:
             return in_read_vector<vec2>(fieldAlignment);
-        }
-        else if (reflect::is_vec4_type(fieldType) || reflect::is_quat_type(fieldType))
-        {
+
+        case in_field_kind::vector3:
+            return in_read_vector<vec3>(fieldAlignment);
+
+        case in_field_kind::vector4:
+        case in_field_kind::quaternion:
             return in_read_vector<vec4>((fieldAlignment) ?
                 fieldAlignment : 16);
-        }
-        else if (reflect::is_char_type(fieldType))
-        {
-            hson::parameter hsonParam(hson::parameter_type::string);
-            hsonParam.value_string() = static_cast<char>(read<u8>(fieldAlignment));
-            return hsonParam;
-        }
-        else
+
+        case in_field_kind::_enum:
         {
-            // Read enum type.
-            const auto enumDef = m_objTypeDB->enums.get(fieldType.data());
-            if (enumDef)
+            const auto enumVal = read_integral(
+                fieldInfo.enumType, fieldAlignment);
+
+            // If the value we just read is present within the enum, store
+            // the name of that enum value within the HSON data.
+            const auto enumValName = fieldInfo.enumDef->get_name_of_value(enumVal);
+            if (enumValName)
             {
-                const auto enumVal = read_integral(
-                    enumDef->type, fieldAlignment);
-
-                // If the value we just read is present within the enum, store
-                // the name of that enum value within the HSON data.
-                const auto enumValName = enumDef->get_name_of_value(enumVal);
-                if (enumValName)
-                {
-                    hson::parameter hsonParam(hson::parameter_type::string);
-                    hsonParam.value_string() = enumValName;
-                    return hsonParam;
-                }
-
-                // Otherwise, fallback to storing the numerical value directly.
-                else if (enumDef->is_signed())
-                {
-                    hson::parameter hsonParam(hson::parameter_type::signed_integer);
-                    hsonParam.value_int() = static_cast<std::intmax_t>(enumVal);
-                    return hsonParam;
-                }
-                else
-                {
-                    hson::parameter hsonParam(hson::parameter_type::unsigned_integer);
-                    hsonParam.value_uint() = enumVal;
-                    return hsonParam;
-                }
+                hson::parameter hsonParam(hson::parameter_type::string);
+                hsonParam.value_string() = enumValName;
+                return hsonParam;
             }
 
-            // Read struct type.
-            const auto structDef = m_objTypeDB->structs.get(fieldType.data());
-            if (structDef)
+            // Otherwise, fallback to storing the numerical value directly.
+            else if (reflect::is_signed_type(fieldInfo.enumType))
             {
-                hson::parameter hsonParam(hson::parameter_type::object);
-                if (!fieldAlignment)
-                {
-                    fieldAlignment = structDef->get_real_alignment(
-                        m_objTypeDB->enums, m_objTypeDB->structs,
-                        in_builtin_type_alignments);
-                }
-
-                align(fieldAlignment);
-                read_struct_fields(*structDef, hsonParam.value_object());
-
-                // NOTE: We have to do tail-end alignment for structs.
-                align(fieldAlignment);
+                hson::parameter hsonParam(hson::parameter_type::signed_integer);
+                hsonParam.value_int() = static_cast<std::intmax_t>(enumVal);
                 return hsonParam;
             }
+            else
+            {
+                hson::parameter hsonParam(hson::parameter_type::unsigned_integer);
+                hsonParam.value_uint() = enumVal;
+                return hsonParam;
+            }
+        }
+
+        case in_field_kind::_struct:
+        {
+            hson::parameter hsonParam(hson::parameter_type::object);
+            if (!fieldAlignment)
+            {
+                fieldAlignment = fieldInfo.structLayout->alignment;
+            }
+
+            align(fieldAlignment);
+            read_struct_fields(*fieldInfo.structLayout, hsonParam.value_object());
+
+            // NOTE: We have to do tail-end alignment for structs.
+            align(fieldAlignment);
+            return hsonParam;
+        }
 
+        default:
             throw std::runtime_error("Unknown or unsupported field type");
         }
     }
 
 public:
     /**
-     * @brief Reads a field using the given field info into a HSON parameter.
+     * @brief Reads a field using the given field layout into a HSON parameter.
      * 
-     * @param fieldInfo Information describing the field to read.
+     * @param fieldInfo The pre-compiled layout of the field to read.
      * @return hson::parameter A HSON parameter representing the field.
      */
-    hson::parameter read_field(const reflect::field_definition& fieldInfo)
+    hson::parameter read_field(const in_field_layout& fieldInfo)
     {
-        /* arrays */
-        if (fieldInfo.is_array())
+        switch (fieldInfo.container)
+        {
+        /* dynamic-sized array */
+        case in_field_container::dynamic_array:
         {
             hson::parameter hsonParam(hson::parameter_type::array);
+            align((fieldInfo.alignment) ?
+                fieldInfo.alignment : alignof(RawArrayType<void>));
+
+            // Read past array.
+            const auto& rawArr = *peek<RawArrayType<void>>();
+            jump_ahead(sizeof(RawArrayType<void>));
+
+            // Read array elements.
+            in_field_reader arrayFieldReader(rawArr.data(), *m_layouts);
+
+            auto& hsonParamValArr = hsonParam.value_array();
+            hsonParamValArr.reserve(rawArr.size());
 
-            /* dynamic-sized array */
-            if (!fieldInfo.array_count())
+            for (typename RawArrayType<void>::size_type i = 0; i < rawArr.size(); ++i)
             {
-                align((fieldInfo.alignment) ?
-                    fieldInfo.alignment : alignof(RawArrayType<void>));
-
-                // Read past array.
-                const auto& rawArr = *peek<RawArrayType<void>>();
-                jump_ahead(sizeof(RawArrayType<void>));
-
-                // Read array elements.
-                in_field_reader arrayFieldReader(rawArr.data(),
-                    *m_objTypeDB, m_tailEndAlignParentStructs);
-
-                auto& hsonParamValArr = hsonParam.value_array();
-                hsonParamValArr.reserve(rawArr.size());
-
-                for (typename RawArrayType<void>::size_type i = 0; i < rawArr.size(); ++i)
-                {
-                    hsonParamValArr.emplace_back(
-                        arrayFieldReader.in_read_element(fieldInfo.subtype()));
-                }
-
-                // Do tail-end alignment for dynamic arrays, since they are structs.
-                if (fieldInfo.alignment)
-                {
-                    align(fieldInfo.alignment);
-                }
+                hsonParamValArr.emplace_back(
+                    arrayFieldReader.in_read_element(fieldInfo));
             }
 
-            /* fixed-sized array */
+            // Do tail-end alignment for dynamic arrays, since they are structs.
+            if (fieldInfo.alignment)
+            {
+                align(fieldInfo.alignment);
+            }
+
+            return hsonParam;
+        }
+
+        /* fixed-sized array */
+        case in_field_container::fixed_array:
+        {
+            hson::parameter hsonParam(hson::parameter_type::array);
+
+            // Align stream if necessary for fixed array.
+            std::size_t fieldAlignment;
+            if (fieldInfo.alignment)
+            {
+                align(fieldInfo.alignment);
+                fieldAlignment = 1;
+            }
             else
             {
-                // Align stream if necessary for fixed array.
-                std::size_t fieldAlignment;
-                if (fieldInfo.alignment)
-                {
-                    align(fieldInfo.alignment);
-                    fieldAlignment = 1;
-                }
-                else
-                {
-                    fieldAlignment = 0;
-                }
-
-                // Read array elements.
-                auto& hsonParamValArr = hsonParam.value_array();
-                hsonParamValArr.reserve(fieldInfo.array_count());
-
-                for (std::size_t i = 0; i < fieldInfo.array_count(); ++i)
-                {
-                    hsonParamValArr.emplace_back(
-                        in_read_element(fieldInfo.subtype(),
-                        fieldAlignment));
-                }
+                fieldAlignment = 0;
+            }
+
+            // Read array elements.
+            auto& hsonParamValArr = hsonParam.value_array();
+            hsonParamValArr.reserve(fieldInfo.arrayCount);
+
+            for (std::size_t i = 0; i < fieldInfo.arrayCount; ++i)
+            {
+                hsonParamValArr.emplace_back(
+                    in_read_element(fieldInfo, fieldAlignment));
             }
 
             return hsonParam;
         }
 
         /* non-arrays */
-        else
-        {
-            return in_read_element(
-                fieldInfo.type(), fieldInfo.alignment);
+        default:
+            return in_read_element(fieldInfo, fieldInfo.alignment);
         }
     }
 
@@ -294,44 +322,47 @@ public:
      * @brief Reads all of the fields in the given struct into
      * the given HSON parameters radix tree.
      * 
-     * @param structDef Information describing the struct to read.
+     * @param structLayout The pre-compiled layout of the struct to read.
      * @param hsonParams The radix tree to store the resulting HSON parameters into.
      */
-    void read_struct_fields(const reflect::struct_definition& structDef,
+    void read_struct_fields(const in_struct_layout& structLayout,
         radix_tree<hson::parameter>& hsonParams)
     {
         // Recursively read struct parents.
-        if (!structDef.parent.empty())
+        if (structLayout.parent)
         {
-            const auto parentStructDef = m_objTypeDB->structs.get(structDef.parent);
-            if (!parentStructDef)
-            {
-                throw std::runtime_error("Could not find parent struct type in database");
-            }
+            read_struct_fields(*structLayout.parent, hsonParams);
 
-            read_struct_fields(*parentStructDef, hsonParams);
-
-            if (m_tailEndAlignParentStructs)
+            if (structLayout.parentTailEndAligned)
             {
-                align(parentStructDef->get_real_alignment(m_objTypeDB->enums,
-                    m_objTypeDB->structs, in_builtin_type_alignments));
+                align(structLayout.parent->alignment);
             }
         }
 
         // Read struct fields.
-        for (const auto& structFieldInfo : structDef.fields)
+        for (const auto& structFieldInfo : structLayout.fields)
         {
-            hsonParams.insert(structFieldInfo.name,
+            hsonParams.insert(structFieldInfo.def->name,
                 read_field(structFieldInfo));
         }
     }
 
-    in_field_reader(const void* rawData,
-        const set_object_type_database& objTypeDB,
-        bool tailEndAlignParentStructs) noexcept :
+    /**
+     * @brief Reads all of the fields in the given struct into
+     * the given HSON parameters radix tree.
+     * 
+     * @param structDef Information describing the struct to read.
+     * @param hsonParams The radix tree to store the resulting HSON parameters into.
+     */
+    inline void read_struct_fields(const reflect::struct_definition& structDef,
+        radix_tree<hson::parameter>& hsonParams)
+    {
+        read_struct_fields(m_layouts->get(structDef), hsonParams);
+    }
+
+    in_field_reader(const void* rawData, layout_database& layouts) noexcept :
         field_reader(rawData),
-        m_objTypeDB(&objTypeDB),
-        m_tailEndAlignParentStructs(tailEndAlignParentStructs) {}
+        m_layouts(&layouts) {}
 };
 } // internal
 } // gedit
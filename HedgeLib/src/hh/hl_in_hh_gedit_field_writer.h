@@ -1,7 +1,7 @@
 #ifndef HL_IN_HH_GEDIT_FIELD_WRITER_H_INCLUDED
 #define HL_IN_HH_GEDIT_FIELD_WRITER_H_INCLUDED
 
-#include "hl_in_hh_gedit.h"
+#include "hl_in_hh_gedit_field_layout.h"
 #include "hedgelib/sets/hl_set_obj_type.h"
 #include "hedgelib/sets/hl_hson.h"
 
@@ -21,13 +21,13 @@ template<typename WriterType, typename RawObjectIDType,
     template<typename> typename RawArrayType>
 class in_field_writer
 {
-    inline static constexpr const std::size_t* in_builtin_type_alignments =
-        internal::in_builtin_type_alignments<
-            RawObjectIDType, RawOffsetType, RawArrayType>;
+public:
+    using layout_database = in_field_layout_database<
+        RawObjectIDType, RawOffsetType, RawArrayType>;
 
+private:
     WriterType* m_writer;
-    const set_object_type_database* m_objTypeDB;
-    bool m_tailEndAlignParentStructs;
+    layout_database* m_layouts;
 
     /**
      * @brief Ensures that the given HSON parameter is of the given type.
@@ -193,54 +193,59 @@ class in_field_writer
     }
 
     void in_write_element(const hson::parameter& hsonParam,
-        const reflect::field_definition& defaultFieldInfo,
-        std::string_view fieldType, std::size_t fieldAlignment = 0)
+        const in_field_layout& fieldInfo, std::size_t fieldAlignment = 0)
     {
-        if (reflect::is_bool_type(fieldType))
+        switch (fieldInfo.kind)
         {
+        case in_field_kind::_bool:
             in_write_primitive<bool>(hsonParam, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_float32)
-        {
+            return;
+
+        case in_field_kind::float32:
             in_write_primitive<float>(hsonParam, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_float64)
-        {
+            return;
+
+        case in_field_kind::float64:
             in_write_primitive<double>(hsonParam, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_int8)
-        {
+            return;
+
+        case in_field_kind::int8:
             in_write_primitive<s8>(hsonParam, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_int16)
-        {
+            return;
+
+        case in_field_kind::int16:
             in_write_primitive<s16>(hsonParam, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_int32)
-        {
+            return;
+
+        case in_field_kind::int32:
             in_write_primitive<s32>(hsonParam, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_int64)
-        {
+            return;
+
+        case in_field_kind::int64:
             in_write_primitive<s64>(hsonParam, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_uint8)
-        {
+            return;
+
+        case in_field_kind::uint8:
             in_write_primitive<u8>(hsonParam, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_uint16)
-        {
+            return;
+
+        case in_field_kind::uint16:
             in_write_primitive<u16>(hsonParam, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_uint32)
-        {
+            return;
+
+        case in_field_kind::uint32:
             in_write_primitive<u32>(hsonParam, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_uint64)
-        {
+            return;
+
+        case in_field_kind::uint64:
             in_write_primitive<u64>(hsonParam, fieldAlignment);
-        }
-        else if (reflect::is_string_type(fieldType))
+            return;
+
+        case in_field_kind::_char:
+            in_write_primitive<char>(hsonParam, fieldAlignment);
+            return;
+
+        case in_field_kind::string:
         {
             in_validate_param_type(hsonParam, hson::parameter_type::string);
             m_writer->pad((fieldAlignment) ? fieldAlignment : alignof(RawOffsetType<char>));
@@ -260,13 +265,11 @@ class in_field_writer
             {
                 m_writer->pad(fieldAlignment);
             }
+
+            return;
         }
-        else if (reflect::is_vec3_type(fieldType))
-        {
-            in_write_vector<vec3>(hsonParam, fieldAlignment,
-                defaultFieldInfo.default_val_vec3());
-        }
-        else if (reflect::is_object_reference_type(fieldType))
+
+        case in_field_kind::object_reference:
         {
             in_validate_param_type(hsonParam, hson::parameter_type::string);
             RawObjectIDType rawObjRef = in_as_obj_ref<RawObjectIDType>(
@@ -280,59 +283,52 @@ class in_field_writer
             {
                 m_writer->pad(fieldAlignment);
             }
+
+            return;
         }
-        else if (reflect::is_vec2_type(fieldType))
-        {
+
+        case in_field_kind::vector2:
             in_write_vector<vec2>(hsonParam, fieldAlignment,
-                defaultFieldInfo.default_val_vec2());
-        }
-        else if (reflect::is_vec4_type(fieldType))
-        {
+                fieldInfo.def->default_val_vec2());
+            return;
+
+        case in_field_kind::vector3:
+            in_write_vector<vec3>(hsonParam, fieldAlignment,
+                fieldInfo.def->default_val_vec3());
+            return;
+
+        case in_field_kind::vector4:
             in_write_vector<vec4>(hsonParam,
                 (fieldAlignment) ? fieldAlignment : 16,
-                defaultFieldInfo.default_val_vec4());
-        }
-        else if (reflect::is_quat_type(fieldType))
-        {
+                fieldInfo.def->default_val_vec4());
+            return;
+
+        case in_field_kind::quaternion:
             in_write_vector<quat>(hsonParam,
                 (fieldAlignment) ? fieldAlignment : 16,
-                defaultFieldInfo.default_val_quat());
-        }
-        else if (reflect::is_char_type(fieldType))
-        {
-            in_write_primitive<char>(hsonParam, fieldAlignment);
-        }
-        else
-        {
-            // Write enum type.
-            const auto enumDef = m_objTypeDB->enums.get(fieldType.data());
-            if (enumDef)
-            {
-                in_write_enum(hsonParam, *enumDef, fieldAlignment);
-                return;
-            }
-
-            // Write struct type.
-            const auto structDef = m_objTypeDB->structs.get(fieldType.data());
-            if (structDef)
-            {
-                in_validate_param_type(hsonParam, hson::parameter_type::object);
+                fieldInfo.def->default_val_quat());
+            return;
 
-                if (!fieldAlignment)
-                {
-                    fieldAlignment = structDef->get_real_alignment(
-                        m_objTypeDB->enums, m_objTypeDB->structs,
-                        in_builtin_type_alignments);
-                }
+        case in_field_kind::_enum:
+            in_write_enum(hsonParam, *fieldInfo.enumDef, fieldAlignment);
+            return;
 
-                m_writer->pad(fieldAlignment);
-                write_struct_fields(*structDef, &hsonParam.value_object());
+        case in_field_kind::_struct:
+            in_validate_param_type(hsonParam, hson::parameter_type::object);
 
-                // NOTE: We have to do tail-end alignment for structs.
-                m_writer->pad(fieldAlignment);
-                return;
+            if (!fieldAlignment)
+            {
+                fieldAlignment = fieldInfo.structLayout->alignment;
             }
 
+            m_writer->pad(fieldAlignment);
+            write_struct_fields(*fieldInfo.structLayout, &hsonParam.value_object());
+
+            // NOTE: We have to do tail-end alignment for structs.
+            m_writer->pad(fieldAlignment);
+            return;
+
+        default:
             throw std::runtime_error("Unknown or unsupported field type");
         }
     }
@@ -404,66 +400,98 @@ class in_field_writer
         }
     }
 
-    void in_write_default_element(
-        const reflect::field_definition& defaultFieldInfo,
-        std::string_view fieldType, std::size_t fieldAlignment = 0)
+
+    void in_write_default_element(const in_field_layout& fieldInfo,
+        std::size_t fieldAlignment = 0)
     {
-        if (reflect::is_bool_type(fieldType))
+        const auto& defaultFieldInfo = *fieldInfo.def;
+        switch (fieldInfo.kind)
+        {
+        case in_field_kind::_bool:
         {
             const auto val = static_cast<u8>(defaultFieldInfo.default_val_bool());
             m_writer->write_obj(val, fieldAlignment);
+            return;
         }
-        else if (fieldType == reflect::builtin_type_id_float32)
+
+        case in_field_kind::float32:
         {
             auto val = static_cast<float>(defaultFieldInfo.default_val_floating());
             m_writer->swap_and_write_obj(val, fieldAlignment);
+            return;
         }
-        else if (fieldType == reflect::builtin_type_id_float64)
+
+        case in_field_kind::float64:
         {
             auto val = defaultFieldInfo.default_val_floating();
             m_writer->swap_and_write_obj(val, fieldAlignment);
+            return;
         }
-        else if (fieldType == reflect::builtin_type_id_int8)
+
+        case in_field_kind::int8:
         {
             const auto val = static_cast<s8>(defaultFieldInfo.default_val_int());
             m_writer->write_obj(val, fieldAlignment);
+            return;
         }
-        else if (fieldType == reflect::builtin_type_id_int16)
+
+        case in_field_kind::int16:
         {
             auto val = static_cast<s16>(defaultFieldInfo.default_val_int());
             m_writer->swap_and_write_obj(val, fieldAlignment);
+            return;
         }
-        else if (fieldType == reflect::builtin_type_id_int32)
+
+        case in_field_kind::int32:
         {
             auto val = static_cast<s32>(defaultFieldInfo.default_val_int());
             m_writer->swap_and_write_obj(val, fieldAlignment);
+            return;
         }
-        else if (fieldType == reflect::builtin_type_id_int64)
+
+        case in_field_kind::int64:
         {
             auto val = static_cast<s64>(defaultFieldInfo.default_val_int());
             m_writer->swap_and_write_obj(val, fieldAlignment);
+            return;
         }
-        else if (fieldType == reflect::builtin_type_id_uint8)
+
+        case in_field_kind::uint8:
         {
             const auto val = static_cast<u8>(defaultFieldInfo.default_val_uint());
             m_writer->write_obj(val, fieldAlignment);
+            return;
         }
-        else if (fieldType == reflect::builtin_type_id_uint16)
+
+        case in_field_kind::uint16:
         {
             auto val = static_cast<u16>(defaultFieldInfo.default_val_uint());
             m_writer->swap_and_write_obj(val, fieldAlignment);
+            return;
         }
-        else if (fieldType == reflect::builtin_type_id_uint32)
+
+        case in_field_kind::uint32:
         {
             auto val = static_cast<u32>(defaultFieldInfo.default_val_uint());
             m_writer->swap_and_write_obj(val, fieldAlignment);
+            return;
         }
-        else if (fieldType == reflect::builtin_type_id_uint64)
+
+        case in_field_kind::uint64:
         {
             auto val = static_cast<u64>(defaultFieldInfo.default_val_uint());
             m_writer->swap_and_write_obj(val, fieldAlignment);
+            return;
+        }
+
+        case in_field_kind::_char:
+        {
+            const auto val = static_cast<u8>(defaultFieldInfo.default_val_char());
+            m_writer->write_obj(val, fieldAlignment);
+            return;
         }
-        else if (reflect::is_string_type(fieldType))
+
+        case in_field_kind::string:
         {
             m_writer->pad((fieldAlignment) ? fieldAlignment : alignof(RawOffsetType<char>));
 
@@ -482,19 +510,11 @@ class in_field_writer
             {
                 m_writer->pad(fieldAlignment);
             }
-        }
-        else if (reflect::is_vec3_type(fieldType))
-        {
-            // Write default vector value.
-            m_writer->write_obj(defaultFieldInfo.default_val_vec3(), fieldAlignment);
 
-            // Do tail-end alignment for vectors, since they are structs.
-            if (fieldAlignment)
-            {
-                m_writer->pad(fieldAlignment);
-            }
+            return;
         }
-        else if (reflect::is_object_reference_type(fieldType))
+
+        case in_field_kind::object_reference:
         {
             RawObjectIDType rawObjRef(nullptr);
 
@@ -506,9 +526,11 @@ class in_field_writer
             {
                 m_writer->pad(fieldAlignment);
             }
+
+            return;
         }
-        else if (reflect::is_vec2_type(fieldType))
-        {
+
+        case in_field_kind::vector2:
             // Write default vector value.
             m_writer->write_obj(defaultFieldInfo.default_val_vec2(), fieldAlignment);
 
@@ -517,9 +539,22 @@ class in_field_writer
             {
                 m_writer->pad(fieldAlignment);
             }
-        }
-        else if (reflect::is_vec4_type(fieldType))
-        {
+
+            return;
+
+        case in_field_kind::vector3:
+            // Write default vector value.
+            m_writer->write_obj(defaultFieldInfo.default_val_vec3(), fieldAlignment);
+
+            // Do tail-end alignment for vectors, since they are structs.
+            if (fieldAlignment)
+            {
+                m_writer->pad(fieldAlignment);
+            }
+
+            return;
+
+        case in_field_kind::vector4:
             // Write default vector value.
             m_writer->write_obj(defaultFieldInfo.default_val_vec4(),
                 (fieldAlignment) ? fieldAlignment : 16);
@@ -529,9 +564,10 @@ class in_field_writer
             {
                 m_writer->pad(fieldAlignment);
             }
-        }
-        else if (reflect::is_quat_type(fieldType))
-        {
+
+            return;
+
+        case in_field_kind::quaternion:
             // Write default quaternion value.
             m_writer->write_obj(defaultFieldInfo.default_val_quat(),
                 (fieldAlignment) ? fieldAlignment : 16);
@@ -541,348 +577,186 @@ class in_field_writer
             {
                 m_writer->pad(fieldAlignment);
             }
-        }
-        else if (reflect::is_char_type(fieldType))
-        {
-            const auto val = static_cast<u8>(defaultFieldInfo.default_val_char());
-            m_writer->write_obj(val, fieldAlignment);
-        }
-        else
-        {
-            // Write enum type.
-            const auto enumDef = m_objTypeDB->enums.get(fieldType.data());
-            if (enumDef)
-            {
-                in_write_default_enum(defaultFieldInfo, *enumDef, fieldAlignment);
-                return;
-            }
 
-            // Write struct type.
-            const auto structDef = m_objTypeDB->structs.get(fieldType.data());
-            if (structDef)
-            {
-                if (!fieldAlignment)
-                {
-                    fieldAlignment = structDef->get_real_alignment(
-                        m_objTypeDB->enums, m_objTypeDB->structs,
-                        in_builtin_type_alignments);
-                }
+            return;
 
-                m_writer->pad(fieldAlignment);
-                write_struct_fields(*structDef);
+        case in_field_kind::_enum:
+            in_write_default_enum(defaultFieldInfo, *fieldInfo.enumDef, fieldAlignment);
+            return;
 
-                // NOTE: We have to do tail-end alignment for structs.
-                m_writer->pad(fieldAlignment);
-                return;
+        case in_field_kind::_struct:
+            if (!fieldAlignment)
+            {
+                fieldAlignment = fieldInfo.structLayout->alignment;
             }
 
+            m_writer->pad(fieldAlignment);
+            write_struct_fields(*fieldInfo.structLayout);
+
+            // NOTE: We have to do tail-end alignment for structs.
+            m_writer->pad(fieldAlignment);
+            return;
+
+        default:
             throw std::runtime_error("Unknown or unsupported field type");
         }
     }
 
-    template<typename T>
-    static std::size_t in_jump_past_primitive(
-        std::size_t pos, std::size_t fieldAlignment = 0) noexcept
+    std::size_t in_write_array_data_for_element(std::size_t pos,
+        const in_field_layout& fieldInfo, const hson::parameter* hsonParam = nullptr,
+        std::size_t fieldAlignment = 0)
     {
-        pos = align(pos, (fieldAlignment) ? fieldAlignment : alignof(T));
-        pos += sizeof(T);
-        return pos;
-    }
+        // NOTE: Only structs can contain dynamic arrays; we
+        // can just jump past any other types of elements.
+        if (fieldInfo.kind != in_field_kind::_struct ||
+            !fieldInfo.structLayout->hasDynamicArrays)
+        {
+            return layout_database::jump_past_element(
+                pos, fieldInfo, fieldAlignment);
+        }
 
-    static std::size_t in_jump_past_object(std::size_t pos,
-        std::size_t fieldAlignment, std::size_t size,
-        std::size_t defaultAlignment) noexcept
-    {
         if (!fieldAlignment)
         {
-            fieldAlignment = defaultAlignment;
+            fieldAlignment = fieldInfo.structLayout->alignment;
         }
 
         pos = align(pos, fieldAlignment);
-        pos += size;
-        pos = align(pos, fieldAlignment);
-        return pos;
-    }
+        pos = write_array_data(pos, *fieldInfo.structLayout, (hsonParam) ?
+            &hsonParam->value_object() : nullptr);
 
-    template<typename T>
-    static inline std::size_t in_jump_past_object(
-        std::size_t pos, std::size_t fieldAlignment) noexcept
-    {
-        return in_jump_past_object(pos, fieldAlignment,
-            sizeof(T), alignof(T));
+        // NOTE: We have to do tail-end alignment for structs.
+        return align(pos, fieldAlignment);
     }
 
-    std::size_t in_jump_past_enum(std::size_t pos,
-        reflect::integral_type type, std::size_t fieldAlignment = 0)
+    std::size_t in_write_array_data(std::size_t arrDataOffPos,
+        const in_field_layout& fieldInfo,
+        const hson::parameter* hsonParam)
     {
-        switch (type)
+        // Just jump past fields which don't contain any dynamic arrays.
+        if (!fieldInfo.hasDynamicArrays)
         {
-        case reflect::integral_type::int8:
-            return in_jump_past_primitive<s8>(pos, fieldAlignment);
-
-        case reflect::integral_type::int16:
-            return in_jump_past_primitive<s16>(pos, fieldAlignment);
-
-        case reflect::integral_type::int32:
-            return in_jump_past_primitive<s32>(pos, fieldAlignment);
-
-        case reflect::integral_type::int64:
-            return in_jump_past_primitive<s64>(pos, fieldAlignment);
-
-        case reflect::integral_type::uint8:
-            return in_jump_past_primitive<u8>(pos, fieldAlignment);
-
-        case reflect::integral_type::uint16:
-            return in_jump_past_primitive<u16>(pos, fieldAlignment);
-
-        case reflect::integral_type::uint32:
-            return in_jump_past_primitive<u32>(pos, fieldAlignment);
-
-        case reflect::integral_type::uint64:
-            return in_jump_past_primitive<u64>(pos, fieldAlignment);
-
-        default:
-            throw std::runtime_error("Invalid enum integral type");
+            return layout_database::jump_past_field(arrDataOffPos, fieldInfo);
         }
-    }
 
-    std::size_t in_write_array_data_for_element(std::size_t pos,
-        std::string_view fieldType, const hson::parameter* hsonParam = nullptr,
-        std::size_t fieldAlignment = 0)
-    {
-        if (reflect::is_bool_type(fieldType))
-        {
-            return in_jump_past_primitive<u8>(pos, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_float32)
-        {
-            return in_jump_past_primitive<float>(pos, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_float64)
-        {
-            return in_jump_past_primitive<double>(pos, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_int8)
-        {
-            return in_jump_past_primitive<s8>(pos, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_int16)
-        {
-            return in_jump_past_primitive<s16>(pos, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_int32)
-        {
-            return in_jump_past_primitive<s32>(pos, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_int64)
-        {
-            return in_jump_past_primitive<s64>(pos, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_uint8)
-        {
-            return in_jump_past_primitive<u8>(pos, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_uint16)
-        {
-            return in_jump_past_primitive<u16>(pos, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_uint32)
-        {
-            return in_jump_past_primitive<u32>(pos, fieldAlignment);
-        }
-        else if (fieldType == reflect::builtin_type_id_uint64)
-        {
-            return in_jump_past_primitive<u64>(pos, fieldAlignment);
-        }
-        else if (reflect::is_string_type(fieldType))
-        {
-            return in_jump_past_object(pos, fieldAlignment,
-                sizeof(RawOffsetType<char>) * 2,
-                alignof(RawOffsetType<char>));
-        }
-        else if (reflect::is_vec3_type(fieldType))
-        {
-            return in_jump_past_object<vec3>(pos, fieldAlignment);
-        }
-        else if (reflect::is_object_reference_type(fieldType))
-        {
-            return in_jump_past_object<RawObjectIDType>(pos, fieldAlignment);
-        }
-        else if (reflect::is_vec2_type(fieldType))
-        {
-            return in_jump_past_object<vec2>(pos, fieldAlignment);
-        }
-        else if (reflect::is_vec4_type(fieldType))
-        {
-            return in_jump_past_object<vec4>(pos,
-                (fieldAlignment) ? fieldAlignment : 16);
-        }
-        else if (reflect::is_quat_type(fieldType))
-        {
-            return in_jump_past_object<quat>(pos,
-                (fieldAlignment) ? fieldAlignment : 16);
-        }
-        else if (reflect::is_char_type(fieldType))
+        switch (fieldInfo.container)
         {
-            return in_jump_past_primitive<u8>(pos, fieldAlignment);
-        }
-        else
+        /* dynamic-sized array */
+        case in_field_container::dynamic_array:
         {
-            // Write enum type.
-            const auto enumDef = m_objTypeDB->enums.get(fieldType.data());
-            if (enumDef)
-            {
-                return in_jump_past_enum(pos, enumDef->type, fieldAlignment);
-            }
+            // Align as necessary for dynamic array.
+            arrDataOffPos = align(arrDataOffPos, (fieldInfo.alignment) ?
+                fieldInfo.alignment : alignof(RawArrayType<void>));
+
+            // Fix array data offset.
+            // NOTE: We fix the offset even if the array count is 0, like Sonic Team.
+            m_writer->pad(16); // TODO: Is this always correct?
+            m_writer->fix_offset(arrDataOffPos +
+                offsetof(RawArrayType<void>, dataPtr));
 
-            // Write struct type.
-            const auto structDef = m_objTypeDB->structs.get(fieldType.data());
-            if (structDef)
+            // Write dynamic array data if necessary.
+            if (hsonParam)
             {
-                if (!fieldAlignment)
+                in_validate_param_type(*hsonParam, hson::parameter_type::array);
+
+                const auto& hsonParamValArr = hsonParam->value_array();
+                for (std::size_t i = 0; i < hsonParamValArr.size(); ++i)
                 {
-                    fieldAlignment = structDef->get_real_alignment(
-                        m_objTypeDB->enums, m_objTypeDB->structs,
-                        in_builtin_type_alignments);
+                    in_write_element(hsonParamValArr[i], fieldInfo);
                 }
 
-                pos = align(pos, fieldAlignment);
-                pos = write_array_data(pos, *structDef, (hsonParam) ?
-                    &hsonParam->value_object() : nullptr);
+                // TODO: Do we have to pad the stream itself after writing array data?
+            }
+
+            // Account for dynamic array size.
+            arrDataOffPos += sizeof(RawArrayType<void>);
 
-                // NOTE: We have to do tail-end alignment for structs.
-                return align(pos, fieldAlignment);
+            // Do tail-end alignment for dynamic arrays, since they are structs.
+            if (fieldInfo.alignment)
+            {
+                arrDataOffPos = align(arrDataOffPos, fieldInfo.alignment);
             }
 
-            throw std::runtime_error("Unknown or unsupported field type");
+            return arrDataOffPos;
         }
-    }
 
-    std::size_t in_write_array_data(std::size_t arrDataOffPos,
-        const reflect::field_definition& fieldInfo,
-        const hson::parameter* hsonParam)
-    {
-        if (fieldInfo.is_array())
+        /* fixed-sized array */
+        case in_field_container::fixed_array:
         {
-            // If a HSON parameter is given, ensure it is an array.
-            if (hsonParam)
+            // Align if necessary for fixed array.
+            std::size_t fieldAlignment;
+            if (fieldInfo.alignment)
             {
-                in_validate_param_type(*hsonParam, hson::parameter_type::array);
+                arrDataOffPos = align(arrDataOffPos, fieldInfo.alignment);
+                fieldAlignment = 1; // Align of 1; disables alignment.
+            }
+            else
+            {
+                fieldAlignment = 0; // Align of 0; use default alignment.
             }
 
-            /* dynamic-sized array */
-            if (!fieldInfo.array_count())
+            // Account for all fixed array elements which are present.
+            std::size_t minCount;
+            if (hsonParam)
             {
-                // Align as necessary for dynamic array.
-                arrDataOffPos = align(arrDataOffPos, (fieldInfo.alignment) ?
-                    fieldInfo.alignment : alignof(RawArrayType<void>));
-
-                // Fix array data offset.
-                // NOTE: We fix the offset even if the array count is 0, like Sonic Team.
-                m_writer->pad(16); // TODO: Is this always correct?
-                m_writer->fix_offset(arrDataOffPos +
-                    offsetof(RawArrayType<void>, dataPtr));
-
-                // Write dynamic array data if necessary.
-                if (hsonParam)
-                {
-                    const auto& hsonParamValArr = hsonParam->value_array();
-                    for (std::size_t i = 0; i < hsonParamValArr.size(); ++i)
-                    {
-                        in_write_element(hsonParamValArr[i],
-                            fieldInfo, fieldInfo.subtype());
-                    }
-
-                    // TODO: Do we have to pad the stream itself after writing array data?
-                }
+                in_validate_param_type(*hsonParam, hson::parameter_type::array);
 
-                // Account for dynamic array size.
-                arrDataOffPos += sizeof(RawArrayType<void>);
+                const auto& hsonParamValArr = hsonParam->value_array();
+                minCount = std::min<std::size_t>(fieldInfo.arrayCount,
+                    hsonParamValArr.size());
 
-                // Do tail-end alignment for dynamic arrays, since they are structs.
-                if (fieldInfo.alignment)
+                for (std::size_t i = 0; i < minCount; ++i)
                 {
-                    arrDataOffPos = align(arrDataOffPos, fieldInfo.alignment);
+                    arrDataOffPos = in_write_array_data_for_element(
+                        arrDataOffPos, fieldInfo,
+                        &hsonParamValArr[i], fieldAlignment);
                 }
             }
-
-            /* fixed-sized array */
             else
             {
-                // Align if necessary for fixed array.
-                std::size_t fieldAlignment;
-                if (fieldInfo.alignment)
-                {
-                    arrDataOffPos = align(arrDataOffPos, fieldInfo.alignment);
-                    fieldAlignment = 1; // Align of 1; disables alignment.
-                }
-                else
-                {
-                    fieldAlignment = 0; // Align of 0; use default alignment.
-                }
-
-                // Account for all fixed array elements which are present.
-                std::size_t minCount;
-                if (hsonParam)
-                {
-                    const auto& hsonParamValArr = hsonParam->value_array();
-                    minCount = std::min<std::size_t>(fieldInfo.array_count(),
-                        hsonParam->value_array().size());
-
-                    for (std::size_t i = 0; i < minCount; ++i)
-                    {
-                        arrDataOffPos = in_write_array_data_for_element(
-                            arrDataOffPos, fieldInfo.subtype(),
-                            &hsonParamValArr[i], fieldAlignment);
-                    }
-                }
-                else
-                {
-                    minCount = 0;
-                }
+                minCount = 0;
+            }
 
-                // Account for any remaining array elements which are not present.
-                for (std::size_t i = minCount; i < fieldInfo.array_count(); ++i)
-                {
-                    arrDataOffPos = in_write_array_data_for_element(
-                        arrDataOffPos, fieldInfo.subtype(),
-                        nullptr, fieldAlignment);
-                }
+            // Account for any remaining array elements which are not present.
+            for (std::size_t i = minCount; i < fieldInfo.arrayCount; ++i)
+            {
+                arrDataOffPos = in_write_array_data_for_element(
+                    arrDataOffPos, fieldInfo,
+                    nullptr, fieldAlignment);
             }
 
             return arrDataOffPos;
         }
 
         /* non-arrays */
-        else
-        {
+        default:
             return in_write_array_data_for_element(
-                arrDataOffPos, fieldInfo.type(),
+                arrDataOffPos, fieldInfo,
                 hsonParam, fieldInfo.alignment);
         }
     }
 
-    void in_write_parameters(const reflect::struct_definition& objStructType,
-        std::size_t objStructAlignment, const radix_tree<hson::parameter>& hsonParams)
+    void in_write_parameters(const in_struct_layout& objStructLayout,
+        const radix_tree<hson::parameter>& hsonParams)
     {
         // Write struct fields.
         const auto arrDataOffPos = m_writer->tell();
-        write_struct_fields(objStructType, &hsonParams);
+        write_struct_fields(objStructLayout, &hsonParams);
 
         // Do tail-end alignment for structs.
-        m_writer->pad(objStructAlignment);
+        m_writer->pad(objStructLayout.alignment);
 
         // Write array data as necessary.
-        write_array_data(arrDataOffPos, objStructType, &hsonParams);
+        write_array_data(arrDataOffPos, objStructLayout, &hsonParams);
     }
 
 public:
-    void write_field(
-        const reflect::field_definition& fieldInfo,
+    void write_field(const in_field_layout& fieldInfo,
         const hson::parameter* hsonParam = nullptr)
     {
-        /* arrays */
-        if (fieldInfo.is_array())
+        switch (fieldInfo.container)
+        {
+        /* dynamic-sized array */
+        case in_field_container::dynamic_array:
         {
             // If a HSON parameter is given, ensure it is an array.
             if (hsonParam)
@@ -890,180 +764,237 @@ public:
                 in_validate_param_type(*hsonParam, hson::parameter_type::array);
             }
 
-            /* dynamic-sized array */
-            if (!fieldInfo.array_count())
-            {
-                // Pad stream as necessary for dynamic array.
-                m_writer->pad((fieldInfo.alignment) ?
-                    fieldInfo.alignment : alignof(RawArrayType<void>));
+            // Pad stream as necessary for dynamic array.
+            m_writer->pad((fieldInfo.alignment) ?
+                fieldInfo.alignment : alignof(RawArrayType<void>));
 
-                // Generate dynamic array.
-                RawArrayType<void> rawDynArray = {};
-                rawDynArray.count = static_cast<typename RawArrayType<void>::size_type>(
-                    (hsonParam) ? hsonParam->value_array().size() : 0);
+            // Generate dynamic array.
+            RawArrayType<void> rawDynArray = {};
+            rawDynArray.count = static_cast<typename RawArrayType<void>::size_type>(
+                (hsonParam) ? hsonParam->value_array().size() : 0);
 
-                rawDynArray.capacity = rawDynArray.count;
+            rawDynArray.capacity = rawDynArray.count;
 
-                // Write dynamic array.
-                m_writer->swap_and_write_obj(rawDynArray);
+            // Write dynamic array.
+            m_writer->swap_and_write_obj(rawDynArray);
 
-                // Do tail-end alignment for dynamic arrays, since they are structs.
-                if (fieldInfo.alignment)
-                {
-                    m_writer->pad(fieldInfo.alignment);
-                }
+            // Do tail-end alignment for dynamic arrays, since they are structs.
+            if (fieldInfo.alignment)
+            {
+                m_writer->pad(fieldInfo.alignment);
+            }
+
+            // NOTE: For dynamic arrays, we don't write the actual array data until later.
+            return;
+        }
 
-                // NOTE: For dynamic arrays, we don't write the actual array data until later.
+        /* fixed-sized array */
+        case in_field_container::fixed_array:
+        {
+            // If a HSON parameter is given, ensure it is an array.
+            if (hsonParam)
+            {
+                in_validate_param_type(*hsonParam, hson::parameter_type::array);
             }
 
-            /* fixed-sized array */
+            // Pad stream if necessary for fixed array.
+            std::size_t fieldAlignment;
+            if (fieldInfo.alignment)
+            {
+                m_writer->pad(fieldInfo.alignment);
+                fieldAlignment = 1; // Align of 1; disables alignment.
+            }
             else
             {
-                // Pad stream if necessary for fixed array.
-                std::size_t fieldAlignment;
-                if (fieldInfo.alignment)
-                {
-                    m_writer->pad(fieldInfo.alignment);
-                    fieldAlignment = 1; // Align of 1; disables alignment.
-                }
-                else
-                {
-                    fieldAlignment = 0; // Align of 0; use default alignment.
-                }
+                fieldAlignment = 0; // Align of 0; use default alignment.
+            }
 
-                // Write all fixed array elements which are present.
-                std::size_t minCount;
-                if (hsonParam)
-                {
-                    const auto& hsonParamValArr = hsonParam->value_array();
-                    minCount = std::min<std::size_t>(fieldInfo.array_count(),
-                        hsonParam->value_array().size());
-
-                    for (std::size_t i = 0; i < minCount; ++i)
-                    {
-                        in_write_element(hsonParamValArr[i], fieldInfo,
-                            fieldInfo.subtype(), fieldAlignment);
-                    }
-                }
-                else
-                {
-                    minCount = 0;
-                }
+            // Write all fixed array elements which are present.
+            std::size_t minCount;
+            if (hsonParam)
+            {
+                const auto& hsonParamValArr = hsonParam->value_array();
+                minCount = std::min<std::size_t>(fieldInfo.arrayCount,
+                    hsonParamValArr.size());
 
-                // Write default values for any remaining array elements which are not present.
-                for (std::size_t i = minCount; i < fieldInfo.array_count(); ++i)
+                for (std::size_t i = 0; i < minCount; ++i)
                 {
-                    in_write_default_element(fieldInfo,
-                        fieldInfo.subtype(), fieldAlignment);
+                    in_write_element(hsonParamValArr[i],
+                        fieldInfo, fieldAlignment);
                 }
             }
+            else
+            {
+                minCount = 0;
+            }
+
+            // Write default values for any remaining array elements which are not present.
+            for (std::size_t i = minCount; i < fieldInfo.arrayCount; ++i)
+            {
+                in_write_default_element(fieldInfo, fieldAlignment);
+            }
+
+            return;
         }
 
         /* non-arrays */
-        else if (hsonParam)
-        {
-            in_write_element(*hsonParam, fieldInfo,
-                fieldInfo.type(), fieldInfo.alignment);
-        }
-        else
-        {
-            in_write_default_element(fieldInfo,
-                fieldInfo.type(), fieldInfo.alignment);
+        default:
+            if (hsonParam)
+            {
+                in_write_element(*hsonParam, fieldInfo, fieldInfo.alignment);
+            }
+            else
+            {
+                in_write_default_element(fieldInfo, fieldInfo.alignment);
+            }
+
+            return;
         }
     }
 
-    void write_struct_fields(const reflect::struct_definition& structDef,
+    void write_struct_fields(const in_struct_layout& structLayout,
         const radix_tree<hson::parameter>* hsonParams = nullptr)
     {
         // Recursively write struct parents.
-        if (!structDef.parent.empty())
+        if (structLayout.parent)
         {
-            const auto parentStructDef = m_objTypeDB->structs.get(structDef.parent);
-            if (!parentStructDef)
-            {
-                throw std::runtime_error("Could not find parent struct type in database");
-            }
-
-            write_struct_fields(*parentStructDef, hsonParams);
+            write_struct_fields(*structLayout.parent, hsonParams);
 
-            if (m_tailEndAlignParentStructs)
+            if (structLayout.parentTailEndAligned)
             {
-                m_writer->pad(parentStructDef->get_real_alignment(m_objTypeDB->enums,
-                    m_objTypeDB->structs, in_builtin_type_alignments));
+                m_writer->pad(structLayout.parent->alignment);
             }
         }
 
         // Write struct fields.
-        for (const auto& structFieldInfo : structDef.fields)
+        for (const auto& structFieldInfo : structLayout.fields)
         {
             write_field(structFieldInfo, (hsonParams) ?
-                hsonParams->get(structFieldInfo.name) :
+                hsonParams->get(structFieldInfo.def->name) :
                 nullptr);
         }
     }
 
     std::size_t write_array_data(std::size_t arrDataOffPos,
-        const reflect::struct_definition& structDef,
+        const in_struct_layout& structLayout,
         const radix_tree<hson::parameter>* hsonParams = nullptr)
     {
-        // Recursively write array data for struct parents.
-        if (!structDef.parent.empty())
+        // Just jump past structs which don't contain any dynamic arrays.
+        if (!structLayout.hasDynamicArrays)
+        {
+            return layout_database::jump_past_struct_fields(
+                arrDataOffPos, structLayout);
+        }
+
+        // If possible, only visit the fields which contain dynamic
+        // arrays, using the offsets pre-computed for each field.
+        if (layout_database::has_static_layout(arrDataOffPos, structLayout))
         {
-            const auto parentStructDef = m_objTypeDB->structs.get(structDef.parent);
-            if (!parentStructDef)
+            if (structLayout.parent)
+            {
+                write_array_data(arrDataOffPos, *structLayout.parent, hsonParams);
+            }
+
+            for (const auto& structFieldInfo : structLayout.fields)
             {
-                throw std::runtime_error("Could not find parent struct type in database");
+                if (!structFieldInfo.hasDynamicArrays) continue;
+
+                in_write_array_data(arrDataOffPos + structFieldInfo.offset,
+                    structFieldInfo, (hsonParams) ?
+                    hsonParams->get(structFieldInfo.def->name) : nullptr);
             }
 
+            return (arrDataOffPos + structLayout.size);
+        }
+
+        // Otherwise, recursively write array data for struct parents.
+        if (structLayout.parent)
+        {
             arrDataOffPos = write_array_data(arrDataOffPos,
-                *parentStructDef, hsonParams);
+                *structLayout.parent, hsonParams);
 
-            if (m_tailEndAlignParentStructs)
+            if (structLayout.parentTailEndAligned)
             {
                 arrDataOffPos = align(arrDataOffPos,
-                    parentStructDef->get_real_alignment(m_objTypeDB->enums,
-                    m_objTypeDB->structs, in_builtin_type_alignments));
+                    structLayout.parent->alignment);
             }
         }
 
         // Write struct fields.
-        for (const auto& structFieldInfo : structDef.fields)
+        for (const auto& structFieldInfo : structLayout.fields)
         {
             arrDataOffPos = in_write_array_data(
                 arrDataOffPos, structFieldInfo, (hsonParams) ?
-                hsonParams->get(structFieldInfo.name) : nullptr);
+                hsonParams->get(structFieldInfo.def->name) : nullptr);
         }
 
         return arrDataOffPos;
     }
 
-    bool write_parameters(const hson::object& hsonObj,
-        const hson::project& hsonProject, std::size_t objParamDataOffPos)
+    /**
+     * @brief Gets the layout of the given HSON object's parameters struct.
+     *
+     * @param hsonObj The HSON object to get the parameters layout of.
+     * @param hsonProject The HSON project the object is a part of.
+     * @param objStructLayout Set to the layout of the object's parameters
+     * struct, or nullptr if the object's type doesn't have a parameters struct.
+     * @return bool false if the object's type is not in the type database.
+     */
+    bool get_parameters_layout(const hson::object& hsonObj,
+        const hson::project& hsonProject,
+        const in_struct_layout*& objStructLayout)
     {
+        const auto& objTypeDB = m_layouts->obj_type_db();
+        objStructLayout = nullptr;
+
         // Get inherited type from HSON object.
         const auto hsonObjInheritedType = hsonObj.get_inherited_type(hsonProject);
         if (!hsonObjInheritedType) return false;
 
         // Get object definition from object type database.
-        const auto objType = m_objTypeDB->get(*hsonObjInheritedType);
+        const auto objType = objTypeDB.get(*hsonObjInheritedType);
         if (!objType) return false;
 
-        // Get struct definition from object type database.
-        if (objType->structType.empty()) return true;
-        const auto& objStructType = m_objTypeDB->structs.at(objType->structType);
+        // Get struct layout from object type database.
+        if (!objType->structType.empty())
+        {
+            objStructLayout = &m_layouts->get(
+                objTypeDB.structs.at(objType->structType));
+        }
 
-        // Align struct as necessary.
-        const auto objStructAlignment = objStructType.get_real_alignment(
-            m_objTypeDB->enums, m_objTypeDB->structs,
-            in_builtin_type_alignments);
+        return true;
+    }
 
-        m_writer->pad(std::max<std::size_t>(objStructAlignment, 16));
+    /**
+     * @brief Writes the given parameters (and their array data) at the current
+     * position, which must already be aligned as required by the struct.
+     */
+    void write_parameters(const in_struct_layout& objStructLayout,
+        const radix_tree<hson::parameter>& hsonParams)
+    {
+        in_write_parameters(objStructLayout, hsonParams);
+    }
+
+    bool write_parameters(const hson::object& hsonObj,
+        const hson::project& hsonProject, std::size_t objParamDataOffPos)
+    {
+        // Get struct layout from object type database.
+        const in_struct_layout* objStructLayout;
+        if (!get_parameters_layout(hsonObj, hsonProject, objStructLayout))
+        {
+            return false;
+        }
+
+        if (!objStructLayout) return true;
+
+        // Align struct as necessary.
+        m_writer->pad(std::max<std::size_t>(objStructLayout->alignment, 16));
 
         // Fix parameters offset.
         m_writer->fix_offset(objParamDataOffPos);
 
         // Write parameters.
-        in_write_parameters(objStructType, objStructAlignment,
+        in_write_parameters(*objStructLayout,
             (hsonObj.has_inherited_parameters(hsonProject)) ?
                 hsonObj.get_flattened_parameters(hsonProject) :
                 hsonObj.parameters);
@@ -1071,12 +1002,9 @@ public:
         return true;
     }
 
-    in_field_writer(WriterType& writer,
-        const set_object_type_database& objTypeDB,
-        bool tailEndAlignParentStructs) noexcept :
+    in_field_writer(WriterType& writer, layout_database& layouts) noexcept :
         m_writer(&writer),
-        m_objTypeDB(&objTypeDB),
-        m_tailEndAlignParentStructs(tailEndAlignParentStructs) {}
+        m_layouts(&layouts) {}
 };
 } // internal
 } // gedit
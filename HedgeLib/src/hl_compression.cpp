@@ -1,8 +1,11 @@
 #include "hl_in_blob.h"
 #include "hedgelib/hl_compression.h"
+#include "hedgelib/hl_thread_pool.h"
 #include <lz4.h>
+#include <lz4hc.h>
 #define ZLIB_CONST
 #include <zlib.h>
+#include <algorithm>
 #include <cstring>
 
 namespace hl
@@ -22,31 +25,96 @@ void lz4_decompress_no_alloc(std::size_t srcSize,
     }
 }
 
-void deflate_decompress_no_alloc(std::size_t srcSize,
+void deflate_decompress_context::in_close() noexcept
+{
+    if (!m_stream) return;
+
+    z_stream* stream = static_cast<z_stream*>(m_stream);
+    inflateEnd(stream);
+    delete stream;
+
+    m_stream = nullptr;
+}
+
+void deflate_decompress_context::decompress_no_alloc(std::size_t srcSize,
     const void* src, std::size_t dstSize, void* dst)
 {
-    // Setup zlib stream.
-    z_stream stream = { 0 };
-    int r = inflateInit2(&stream, -MAX_WBITS);
-    if (r < Z_OK)
+    z_stream* stream = static_cast<z_stream*>(m_stream);
+    int r;
+
+    // Reset the existing zlib stream if we have one.
+    if (stream)
+    {
+        r = inflateReset(stream);
+        if (r < Z_OK)
+        {
+            throw std::runtime_error("Failed to reset deflate stream");
+        }
+    }
+
+    // Otherwise, setup a new zlib stream.
+    else
     {
-        throw std::runtime_error("Failed to initialize deflate stream");
+        std::unique_ptr<z_stream> newStream(new z_stream());
+        r = inflateInit2(newStream.get(), -MAX_WBITS);
+
+        if (r < Z_OK)
+        {
+            throw std::runtime_error("Failed to initialize deflate stream");
+        }
+
+        stream = newStream.release();
+        m_stream = stream;
     }
 
-    stream.next_in = static_cast<z_const Bytef*>(src);
-    stream.avail_in = static_cast<uInt>(srcSize);
-    stream.next_out = static_cast<Bytef*>(dst);
-    stream.avail_out = static_cast<uInt>(dstSize);
+    stream->next_in = static_cast<z_const Bytef*>(src);
+    stream->avail_in = static_cast<uInt>(srcSize);
+    stream->next_out = static_cast<Bytef*>(dst);
+    stream->avail_out = static_cast<uInt>(dstSize);
 
     // Decompress deflate data.
     // TODO: Should we use Z_SYNC_FLUSH?
-    r = inflate(&stream, Z_SYNC_FLUSH);
+    r = inflate(stream, Z_SYNC_FLUSH);
     if (r < Z_OK)
     {
         throw std::runtime_error("Failed to decompress deflate data");
     }
 }
 
+deflate_decompress_context& deflate_decompress_context::get_thread_local()
+{
+    thread_local deflate_decompress_context context;
+    return context;
+}
+
+deflate_decompress_context& deflate_decompress_context::operator=(
+    deflate_decompress_context&& other) noexcept
+{
+    if (&other != this)
+    {
+        in_close();
+
+        m_stream = other.m_stream;
+        other.m_stream = nullptr;
+    }
+
+    return *this;
+}
+
+deflate_decompress_context::deflate_decompress_context(
+    deflate_decompress_context&& other) noexcept :
+    m_stream(other.m_stream)
+{
+    other.m_stream = nullptr;
+}
+
+void deflate_decompress_no_alloc(std::size_t srcSize,
+    const void* src, std::size_t dstSize, void* dst)
+{
+    deflate_decompress_context::get_thread_local().decompress_no_alloc(
+        srcSize, src, dstSize, dst);
+}
+
 static void in_none_decompress_no_alloc(std::size_t srcSize,
     const void* src, std::size_t dstSize, void* dst)
 {
@@ -134,13 +202,39 @@ std::size_t compress_bound(compress_type type,
     }
 }
 
-std::size_t lz4_compress_no_alloc(std::size_t srcSize,
-    const void* src, std::size_t dstBufSize, void* dst)
+std::size_t lz4_compress_context::compress_no_alloc(std::size_t srcSize,
+    const void* src, std::size_t dstBufSize, void* dst, int level)
 {
-    // Compress data.
-    const int r = LZ4_compress_default(static_cast<const char*>(src),
-        static_cast<char*>(dst), static_cast<int>(srcSize),
-        static_cast<int>(dstBufSize));
+    int r;
+
+    // Compress data using LZ4 HC if a high enough level was requested.
+    if (level >= lz4_hc_level_min)
+    {
+        if (!m_stateHC)
+        {
+            m_stateHC = std::unique_ptr<u8[]>(
+                new u8[LZ4_sizeofStateHC()]);
+        }
+
+        r = LZ4_compress_HC_extStateHC(m_stateHC.get(),
+            static_cast<const char*>(src), static_cast<char*>(dst),
+            static_cast<int>(srcSize), static_cast<int>(dstBufSize),
+            std::min(level, lz4_hc_level_max));
+    }
+
+    // Otherwise, compress data using regular LZ4.
+    else
+    {
+        if (!m_state)
+        {
+            m_state = std::unique_ptr<u8[]>(
+                new u8[LZ4_sizeofState()]);
+        }
+
+        r = LZ4_compress_fast_extState(m_state.get(),
+            static_cast<const char*>(src), static_cast<char*>(dst),
+            static_cast<int>(srcSize), static_cast<int>(dstBufSize), 1);
+    }
 
     // Throw error if compression failed.
     if (r <= 0)
@@ -151,34 +245,124 @@ std::size_t lz4_compress_no_alloc(std::size_t srcSize,
     return static_cast<std::size_t>(r);
 }
 
-std::size_t deflate_compress_no_alloc(std::size_t srcSize,
-    const void* src, std::size_t dstBufSize, void* dst)
+lz4_compress_context& lz4_compress_context::get_thread_local()
 {
-    // Setup zlib stream.
-    z_stream stream = { 0 };
-    int r = deflateInit2(&stream, Z_DEFAULT_COMPRESSION,
-        Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    thread_local lz4_compress_context context;
+    return context;
+}
 
-    if (r < Z_OK)
+std::size_t lz4_compress_no_alloc(std::size_t srcSize,
+    const void* src, std::size_t dstBufSize, void* dst, int level)
+{
+    return lz4_compress_context::get_thread_local().compress_no_alloc(
+        srcSize, src, dstBufSize, dst, level);
+}
+
+void deflate_compress_context::in_close() noexcept
+{
+    if (!m_stream) return;
+
+    z_stream* stream = static_cast<z_stream*>(m_stream);
+    deflateEnd(stream);
+    delete stream;
+
+    m_stream = nullptr;
+}
+
+std::size_t deflate_compress_context::compress_no_alloc(std::size_t srcSize,
+    const void* src, std::size_t dstBufSize, void* dst,
+    int level, bool finish)
+{
+    z_stream* stream = static_cast<z_stream*>(m_stream);
+    level = std::min(level, deflate_level_max);
+    int r;
+
+    // Reset the existing zlib stream if we have one with the same level.
+    if (stream && m_level == level)
     {
-        throw std::runtime_error("Failed to initialize deflate stream");
+        r = deflateReset(stream);
+        if (r < Z_OK)
+        {
+            throw std::runtime_error("Failed to reset deflate stream");
+        }
     }
 
-    stream.next_in = static_cast<z_const Bytef*>(src);
-    stream.avail_in = static_cast<uInt>(srcSize);
-    stream.next_out = static_cast<Bytef*>(dst);
-    stream.avail_out = static_cast<uInt>(dstBufSize);
+    // Otherwise, setup a new zlib stream.
+    else
+    {
+        in_close();
 
-    // Decompress deflate data.
-    r = deflate(&stream, Z_FINISH);
-    if (r < Z_OK)
+        std::unique_ptr<z_stream> newStream(new z_stream());
+        r = deflateInit2(newStream.get(), level,
+            Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+
+        if (r < Z_OK)
+        {
+            throw std::runtime_error("Failed to initialize deflate stream");
+        }
+
+        stream = newStream.release();
+        m_stream = stream;
+        m_level = level;
+    }
+
+    stream->next_in = static_cast<z_const Bytef*>(src);
+    stream->avail_in = static_cast<uInt>(srcSize);
+    stream->next_out = static_cast<Bytef*>(dst);
+    stream->avail_out = static_cast<uInt>(dstBufSize);
+
+    // Compress deflate data.
+    // NOTE: If we're not finishing the stream, a full flush is used instead,
+    // which byte-aligns the output without marking it as the final block, so
+    // that another raw deflate stream can be directly appended to it.
+    r = deflate(stream, (finish) ? Z_FINISH : Z_FULL_FLUSH);
+
+    const bool isComplete = (finish) ? (r == Z_STREAM_END) :
+        (r >= Z_OK && stream->avail_in == 0 && stream->avail_out != 0);
+
+    if (!isComplete)
     {
-        throw std::runtime_error("Failed to decompress deflate data");
+        throw std::runtime_error("Failed to compress deflate data");
     }
 
-    const std::size_t dstSize = stream.total_out;
-    deflateEnd(&stream);
-    return dstSize;
+    return stream->total_out;
+}
+
+deflate_compress_context& deflate_compress_context::get_thread_local()
+{
+    thread_local deflate_compress_context context;
+    return context;
+}
+
+deflate_compress_context& deflate_compress_context::operator=(
+    deflate_compress_context&& other) noexcept
+{
+    if (&other != this)
+    {
+        in_close();
+
+        m_stream = other.m_stream;
+        m_level = other.m_level;
+
+        other.m_stream = nullptr;
+    }
+
+    return *this;
+}
+
+deflate_compress_context::deflate_compress_context(
+    deflate_compress_context&& other) noexcept :
+    m_stream(other.m_stream),
+    m_level(other.m_level)
+{
+    other.m_stream = nullptr;
+}
+
+std::size_t deflate_compress_no_alloc(std::size_t srcSize,
+    const void* src, std::size_t dstBufSize, void* dst, int level)
+{
+    return deflate_compress_context::get_thread_local().compress_no_alloc(
+        srcSize, src, dstBufSize, dst, level);
 
     /*uLongf dstSize = static_cast<uLongf>(dstBufSize);
     int r = ::compress(static_cast<Bytef*>(dst), &dstSize,
@@ -210,7 +394,7 @@ static std::size_t in_none_compress_no_alloc(std::size_t srcSize,
 
 std::size_t compress_no_alloc(compress_type type,
     std::size_t srcSize, const void* src,
-    std::size_t dstBufSize, void* dst)
+    std::size_t dstBufSize, void* dst, int level)
 {
     switch (type)
     {
@@ -218,10 +402,10 @@ std::size_t compress_no_alloc(compress_type type,
         return in_none_compress_no_alloc(srcSize, src, dstBufSize, dst);
 
     case compress_type::lz4:
-        return lz4_compress_no_alloc(srcSize, src, dstBufSize, dst);
+        return lz4_compress_no_alloc(srcSize, src, dstBufSize, dst, level);
 
     case compress_type::deflate:
-        return deflate_compress_no_alloc(srcSize, src, dstBufSize, dst);
+        return deflate_compress_no_alloc(srcSize, src, dstBufSize, dst, level);
 
     // TODO: Support all compress_type values!
 
@@ -231,19 +415,20 @@ std::size_t compress_no_alloc(compress_type type,
 }
 
 std::unique_ptr<u8[]> compress(compress_type type,
-    std::size_t srcSize, const void* src, std::size_t& dstSize)
+    std::size_t srcSize, const void* src, std::size_t& dstSize, int level)
 {
     // Allocate buffer big enough to hold compressed data.
     const std::size_t dstBufSize = compress_bound(type, srcSize);
     std::unique_ptr<u8[]> dst(new u8[dstBufSize]);
 
     // Compress data.
-    dstSize = compress_no_alloc(type, srcSize, src, dstBufSize, dst.get());
+    dstSize = compress_no_alloc(type, srcSize, src,
+        dstBufSize, dst.get(), level);
     return dst;
 }
 
 blob compress_blob(compress_type type,
-    std::size_t srcSize, const void* src)
+    std::size_t srcSize, const void* src, int level)
 {
     // Allocate blob big enough to hold compressed data.
     const std::size_t dstBufSize = compress_bound(type, srcSize);
@@ -251,7 +436,260 @@ blob compress_blob(compress_type type,
 
     // Compress data.
     const std::size_t dstSize = compress_no_alloc(
-        type, srcSize, src, dstBufSize, dst.data());
+        type, srcSize, src, dstBufSize, dst.data(), level);
+
+    in_blob_size_setter::set_size(dst, dstSize);
+    return dst;
+}
+
+static std::size_t in_deflate_compress_block_bound(
+    std::size_t blockSize) noexcept
+{
+    // NOTE: Non-final blocks are ended with a full flush, which appends an
+    // empty stored block (at most 5 bytes) that compressBound doesn't
+    // account for. We add a few extra bytes on top of that to be safe.
+    return (deflate_compress_bound(blockSize) + 8);
+}
+
+static std::size_t in_compress_block_bound(compress_type type,
+    std::size_t blockSize) noexcept
+{
+    switch (type)
+    {
+    case compress_type::deflate:
+        return in_deflate_compress_block_bound(blockSize);
+
+    default:
+        return compress_bound(type, blockSize);
+    }
+}
+
+std::size_t compress_block_count(compress_type type,
+    std::size_t srcSize, std::size_t blockSize) noexcept
+{
+    // NOTE: Deflate data always needs at least one (final) block, even
+    // when there's no data, whereas LZ4 data can just have no blocks.
+    if (srcSize == 0)
+    {
+        return (type == compress_type::deflate) ? 1 : 0;
+    }
+
+    // Compress everything as a single block if no block size was given.
+    if (blockSize == 0) return 1;
+
+    return ((srcSize + (blockSize - 1)) / blockSize);
+}
+
+std::size_t compress_blocks_bound(compress_type type,
+    std::size_t srcSize, std::size_t blockSize) noexcept
+{
+    // Compute block count and sizes.
+    const std::size_t blockCount = compress_block_count(
+        type, srcSize, blockSize);
+
+    if (blockCount == 0) return 0;
+    if (blockSize == 0 || blockSize > srcSize) blockSize = srcSize;
+
+    // Compute the bounds of all of the blocks.
+    // NOTE: The bounds of every block are computed as though they were full,
+    // as the block compression functions compress each block into its own
+    // full-sized slot before packing them all together.
+    return (in_compress_block_bound(type, blockSize) * blockCount);
+}
+
+template<typename compress_block_func_t>
+static std::size_t in_compress_blocks_no_alloc(compress_type type,
+    std::size_t srcSize, const void* src, std::size_t blockSize,
+    std::size_t dstBufSize, void* dst, std::vector<std::size_t>* blockSizes,
+    thread_pool* pool, const compress_block_func_t& compressBlock)
+{
+    // Compute block count and sizes.
+    const std::size_t blockCount = compress_block_count(
+        type, srcSize, blockSize);
+
+    if (blockCount == 0) return 0;
+    if (blockSize == 0 || blockSize > srcSize) blockSize = srcSize;
+
+    const std::size_t blockSrcSize = blockSize;
+    const auto getBlockSrcSize = [=](std::size_t blockIndex)
+    {
+        return (blockIndex == (blockCount - 1)) ?
+            (srcSize - (blockIndex * blockSrcSize)) : blockSrcSize;
+    };
+
+    // Compress blocks one after the other if we can't do so in parallel.
+    std::size_t totalDstSize = 0;
+    if (!pool || blockCount == 1)
+    {
+        for (std::size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex)
+        {
+            // Compress block.
+            const std::size_t curBlockDstSize = compressBlock(
+                getBlockSrcSize(blockIndex),
+                ptradd(src, blockIndex * blockSrcSize),
+                dstBufSize - totalDstSize, ptradd(dst, totalDstSize),
+                (blockIndex == (blockCount - 1)));
+
+            // Add block size to block sizes list if necessary.
+            if (blockSizes)
+            {
+                blockSizes->push_back(curBlockDstSize);
+            }
+
+            // Increase total compressed size.
+            totalDstSize += curBlockDstSize;
+        }
+
+        return totalDstSize;
+    }
+
+    // Compress each block into its own full-sized slot. If the destination
+    // buffer isn't big enough to hold every slot, we use a temporary buffer.
+    const std::size_t blockDstBufSize = in_compress_block_bound(
+        type, blockSrcSize);
+
+    const std::size_t slotsSize = (blockDstBufSize * blockCount);
+    std::unique_ptr<u8[]> tmpSlots;
+    u8* slots = static_cast<u8*>(dst);
+
+    if (dstBufSize < slotsSize)
+    {
+        tmpSlots = std::unique_ptr<u8[]>(new u8[slotsSize]);
+        slots = tmpSlots.get();
+    }
+
+    std::unique_ptr<std::size_t[]> blockDstSizes(new std::size_t[blockCount]);
+    pool->parallel_for(blockCount, [&](std::size_t blockIndex)
+    {
+        blockDstSizes[blockIndex] = compressBlock(
+            getBlockSrcSize(blockIndex),
+            ptradd(src, blockIndex * blockSrcSize),
+            blockDstBufSize, slots + (blockIndex * blockDstBufSize),
+            (blockIndex == (blockCount - 1)));
+    });
+
+    // Pack compressed blocks together.
+    for (std::size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex)
+    {
+        const std::size_t curBlockDstSize = blockDstSizes[blockIndex];
+        if (curBlockDstSize > (dstBufSize - totalDstSize))
+        {
+            throw std::out_of_range("Destination buffer is not large enough "
+                "to contain compressed data");
+        }
+
+        // NOTE: Slots never come before the position their block is being
+        // packed to, so it's safe to move them forwards within dst.
+        std::memmove(ptradd(dst, totalDstSize),
+            slots + (blockIndex * blockDstBufSize),
+            curBlockDstSize);
+
+        // Add block size to block sizes list if necessary.
+        if (blockSizes)
+        {
+            blockSizes->push_back(curBlockDstSize);
+        }
+
+        // Increase total compressed size.
+        totalDstSize += curBlockDstSize;
+    }
+
+    return totalDstSize;
+}
+
+std::size_t lz4_compress_blocks_no_alloc(std::size_t srcSize,
+    const void* src, std::size_t blockSize, std::size_t dstBufSize,
+    void* dst, std::vector<std::size_t>* blockSizes,
+    int level, thread_pool* pool)
+{
+    return in_compress_blocks_no_alloc(compress_type::lz4, srcSize, src,
+        blockSize, dstBufSize, dst, blockSizes, pool,
+        [level](std::size_t blockSrcSize, const void* blockSrc,
+            std::size_t blockDstBufSize, void* blockDst, bool)
+        {
+            return lz4_compress_no_alloc(blockSrcSize, blockSrc,
+                blockDstBufSize, blockDst, level);
+        });
+}
+
+std::size_t deflate_compress_blocks_no_alloc(std::size_t srcSize,
+    const void* src, std::size_t blockSize, std::size_t dstBufSize,
+    void* dst, std::vector<std::size_t>* blockSizes,
+    int level, thread_pool* pool)
+{
+    return in_compress_blocks_no_alloc(compress_type::deflate, srcSize, src,
+        blockSize, dstBufSize, dst, blockSizes, pool,
+        [level](std::size_t blockSrcSize, const void* blockSrc,
+            std::size_t blockDstBufSize, void* blockDst, bool isLastBlock)
+        {
+            return deflate_compress_context::get_thread_local().compress_no_alloc(
+                blockSrcSize, blockSrc, blockDstBufSize, blockDst,
+                level, isLastBlock);
+        });
+}
+
+std::size_t compress_blocks_no_alloc(compress_type type,
+    std::size_t srcSize, const void* src, std::size_t blockSize,
+    std::size_t dstBufSize, void* dst, std::vector<std::size_t>* blockSizes,
+    int level, thread_pool* pool)
+{
+    switch (type)
+    {
+    case compress_type::none:
+        return in_compress_blocks_no_alloc(type, srcSize, src, blockSize,
+            dstBufSize, dst, blockSizes, nullptr,
+            [](std::size_t blockSrcSize, const void* blockSrc,
+                std::size_t blockDstBufSize, void* blockDst, bool)
+            {
+                return in_none_compress_no_alloc(blockSrcSize,
+                    blockSrc, blockDstBufSize, blockDst);
+            });
+
+    case compress_type::lz4:
+        return lz4_compress_blocks_no_alloc(srcSize, src, blockSize,
+            dstBufSize, dst, blockSizes, level, pool);
+
+    case compress_type::deflate:
+        return deflate_compress_blocks_no_alloc(srcSize, src, blockSize,
+            dstBufSize, dst, blockSizes, level, pool);
+
+    // TODO: Support all compress_type values!
+
+    default:
+        throw std::runtime_error("Unknown or unsupported compression type");
+    }
+}
+
+std::unique_ptr<u8[]> compress_blocks(compress_type type,
+    std::size_t srcSize, const void* src, std::size_t blockSize,
+    std::size_t& dstSize, int level, thread_pool* pool)
+{
+    // Allocate buffer big enough to hold compressed data.
+    const std::size_t dstBufSize = compress_blocks_bound(
+        type, srcSize, blockSize);
+
+    std::unique_ptr<u8[]> dst(new u8[dstBufSize]);
+
+    // Compress data.
+    dstSize = compress_blocks_no_alloc(type, srcSize, src, blockSize,
+        dstBufSize, dst.get(), nullptr, level, pool);
+
+    return dst;
+}
+
+blob compress_blocks_blob(compress_type type,
+    std::size_t srcSize, const void* src, std::size_t blockSize,
+    int level, thread_pool* pool)
+{
+    // Allocate blob big enough to hold compressed data.
+    const std::size_t dstBufSize = compress_blocks_bound(
+        type, srcSize, blockSize);
+
+    blob dst(dstBufSize);
+
+    // Compress data.
+    const std::size_t dstSize = compress_blocks_no_alloc(type, srcSize,
+        src, blockSize, dstBufSize, dst.data(), nullptr, level, pool);
 
     in_blob_size_setter::set_size(dst, dstSize);
     return dst;
@@ -15,6 +15,18 @@
 #define HL_IN_HAS_SSE2
 #endif
 
+// SSSE3 Intrinsics
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define HL_IN_HAS_SSSE3
+#endif
+
+// AVX2 Intrinsics
+#ifdef __AVX2__
+#include <immintrin.h>
+#define HL_IN_HAS_AVX2
+#endif
+
 #endif
 
 // Standard library
@@ -17,4 +17,110 @@ std::out_of_range out_of_range_exception(const char* argName)
         "The following argument was out of the expected or supported range: " +
         std::string(argName));
 }
+
+#if defined(HL_IN_HAS_SSSE3)
+template<typename T>
+static __m128i in_get_swap_mask128() noexcept
+{
+    // Generate byte shuffle mask which reverses the bytes of each value.
+    alignas(16) u8 mask[16];
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        mask[i] = static_cast<u8>((i - (i % sizeof(T))) +
+            (sizeof(T) - 1 - (i % sizeof(T))));
+    }
+
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+}
+#elif defined(HL_IN_HAS_SSE2)
+template<typename T>
+static __m128i in_endian_swap_sse2(__m128i v) noexcept
+{
+    // Reverse the order of the 16-bit words within each value.
+    if constexpr (sizeof(T) == sizeof(u32))
+    {
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    }
+    else if constexpr (sizeof(T) == sizeof(u64))
+    {
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+
+    // Swap the bytes within each 16-bit word.
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+#endif
+
+template<typename T>
+static void in_endian_swap_arr(std::size_t count, T* arr) noexcept
+{
+#if defined(HL_IN_HAS_SSSE3) || defined(HL_IN_HAS_SSE2)
+    u8* curPtr = reinterpret_cast<u8*>(arr);
+    std::size_t size = (count * sizeof(T));
+
+#ifdef HL_IN_HAS_SSSE3
+    const __m128i mask128 = in_get_swap_mask128<T>();
+
+#ifdef HL_IN_HAS_AVX2
+    // Swap 32 bytes at a time.
+    const __m256i mask256 = _mm256_broadcastsi128_si256(mask128);
+    while (size >= 32)
+    {
+        const __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(curPtr));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(curPtr),
+            _mm256_shuffle_epi8(v, mask256));
+
+        curPtr += 32;
+        size -= 32;
+    }
+#endif
+#endif
+
+    // Swap 16 bytes at a time.
+    while (size >= 16)
+    {
+        const __m128i v = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(curPtr));
+
+#ifdef HL_IN_HAS_SSSE3
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(curPtr),
+            _mm_shuffle_epi8(v, mask128));
+#else
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(curPtr),
+            in_endian_swap_sse2<T>(v));
+#endif
+
+        curPtr += 16;
+        size -= 16;
+    }
+
+    // Swap any remaining values one at a time.
+    arr = reinterpret_cast<T*>(curPtr);
+    count = (size / sizeof(T));
+#endif
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        endian_swap(arr[i]);
+    }
+}
+
+void endian_swap_arr(std::size_t count, u16* arr) noexcept
+{
+    in_endian_swap_arr(count, arr);
+}
+
+void endian_swap_arr(std::size_t count, u32* arr) noexcept
+{
+    in_endian_swap_arr(count, arr);
+}
+
+void endian_swap_arr(std::size_t count, u64* arr) noexcept
+{
+    in_endian_swap_arr(count, arr);
+}
 } // hl
@@ -1,4 +1,5 @@
 #include "hedgelib/hl_radix_tree.h"
+#include "hedgelib/hl_memory.h"
 #include "hedgelib/hl_text.h"
 #include <cstring>
 #include <cassert>
@@ -7,16 +8,190 @@ namespace hl
 {
 namespace internal
 {
-struct in_radix_leaf_deleter
+/**
+ * @brief The pool a tree allocates all of its nodes from.
+ *
+ * Nodes are bump-allocated from slabs which double in size as the tree grows
+ * (or from the tree's arena, if it has one), so the whole tree can be freed
+ * at once just by freeing its slabs. Nodes which get replaced by larger ones
+ * are kept in per-type free lists, and are reused the next time a node of the
+ * same type is created.
+ */
+struct in_radix_pool
 {
-    inline void operator()(in_radix_leaf* leaf) const
+    struct in_slab_header
     {
-        ::operator delete(leaf);
+        in_slab_header* prev;
+    };
+
+    constexpr static std::size_t in_slab_header_size = align(
+        sizeof(in_slab_header), alignof(std::max_align_t));
+
+    constexpr static std::size_t in_min_slab_size = 512;
+    constexpr static std::size_t in_max_slab_size = 65536;
+
+    arena* arenaPtr;
+    in_slab_header* curSlab = nullptr;
+    u8* curPtr = nullptr;
+    u8* curEnd = nullptr;
+    std::size_t nextSlabSize = in_min_slab_size;
+    std::array<void*, 4> freeNodes = {};
+
+    inline static std::size_t in_get_free_list_index(in_radix_node_type type) noexcept
+    {
+        return (static_cast<u8>(type) >> 6);
+    }
+
+    [[nodiscard]] static in_slab_header* in_alloc_slab(std::size_t dataSize)
+    {
+        return static_cast<in_slab_header*>(hl::allocate(
+            in_slab_header_size + dataSize));
+    }
+
+    [[nodiscard]] void* in_allocate_slow(std::size_t size, std::size_t alignment)
+    {
+        // Give large allocations their own slab, and place it behind the
+        // current slab so the rest of the current slab can still be used.
+        const std::size_t paddedSize = (size + alignment);
+        if (paddedSize > (nextSlabSize / 4))
+        {
+            const auto slab = in_alloc_slab(paddedSize);
+            slab->prev = curSlab->prev;
+            curSlab->prev = slab;
+
+            return reinterpret_cast<void*>(align(reinterpret_cast<
+                std::uintptr_t>(slab) + in_slab_header_size, alignment));
+        }
+
+        // Otherwise, start a new (larger) slab and allocate from it.
+        const auto slab = in_alloc_slab(nextSlabSize);
+        slab->prev = curSlab;
+
+        curSlab = slab;
+        curPtr = ptradd<u8>(slab, in_slab_header_size);
+        curEnd = (curPtr + nextSlabSize);
+        nextSlabSize = std::min(nextSlabSize * 2, in_max_slab_size);
+
+        return allocate(size, alignment);
+    }
+
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment)
+    {
+        if (arenaPtr)
+        {
+            return arenaPtr->allocate(size, alignment);
+        }
+
+        // Bump-allocate from the current slab if there's enough room left.
+        const auto endAddr = reinterpret_cast<std::uintptr_t>(curEnd);
+        const auto alignedAddr = align(reinterpret_cast<
+            std::uintptr_t>(curPtr), alignment);
+
+        if (alignedAddr <= endAddr && size <= (endAddr - alignedAddr))
+        {
+            curPtr = reinterpret_cast<u8*>(alignedAddr + size);
+            return reinterpret_cast<void*>(alignedAddr);
+        }
+
+        // Otherwise, allocate a new slab.
+        return in_allocate_slow(size, alignment);
+    }
+
+    [[nodiscard]] void* allocate_node(in_radix_node_type type,
+        std::size_t size, std::size_t alignment)
+    {
+        // Reuse a previously-freed node of the same type if possible.
+        auto& freeNode = freeNodes[in_get_free_list_index(type)];
+        if (freeNode)
+        {
+            const auto node = freeNode;
+            freeNode = *static_cast<void**>(node);
+            return node;
+        }
+
+        return allocate(size, alignment);
+    }
+
+    void free(void* ptr) noexcept
+    {
+        // Leaves are never replaced, so there's no point in trying to reuse them.
+        const auto node = static_cast<in_radix_node*>(ptr);
+        if (node->is_leaf()) return;
+
+        // Add the node to the free list for its type.
+        auto& freeNode = freeNodes[in_get_free_list_index(node->type())];
+        *static_cast<void**>(ptr) = freeNode;
+        freeNode = ptr;
+    }
+
+    void release() noexcept
+    {
+        // NOTE: Memory allocated from an arena is freed by the arena itself.
+        if (arenaPtr) return;
+
+        // Free every slab, including the one this pool itself is stored within.
+        auto slab = curSlab;
+        while (slab)
+        {
+            const auto prevSlab = slab->prev;
+            hl::free(slab);
+            slab = prevSlab;
+        }
+    }
+
+    [[nodiscard]] static in_radix_pool* create(arena* arenaPtr)
+    {
+        // Store arena-backed pools within the arena itself.
+        if (arenaPtr)
+        {
+            return new (arenaPtr->allocate(sizeof(in_radix_pool),
+                alignof(in_radix_pool))) in_radix_pool(arenaPtr);
+        }
+
+        // Otherwise, store the pool at the beginning of its own first slab.
+        const auto slab = in_alloc_slab(in_min_slab_size);
+        slab->prev = nullptr;
+
+        const auto pool = new (ptradd(slab, in_slab_header_size))
+            in_radix_pool(nullptr);
+
+        pool->curSlab = slab;
+        pool->curPtr = ptradd<u8>(pool, sizeof(in_radix_pool));
+        pool->curEnd = ptradd<u8>(slab, in_slab_header_size + in_min_slab_size);
+        pool->nextSlabSize = (in_min_slab_size * 2);
+
+        return pool;
+    }
+
+    in_radix_pool(arena* arenaPtr) noexcept :
+        arenaPtr(arenaPtr) {}
+};
+
+constexpr in_radix_sort_func in_radix_default_sort_func =
+    text::compare<unsigned char>;
+
+template<typename T, typename... args_t>
+static T* in_radix_new_node(in_radix_pool& pool, args_t&&... args)
+{
+    return new (pool.allocate_node(T::node_type, sizeof(T), alignof(T)))
+        T(std::forward<args_t>(args)...);
+}
+
+struct in_radix_deleter
+{
+    in_radix_pool* pool = nullptr;
+
+    inline void operator()(void* ptr) const noexcept
+    {
+        pool->free(ptr);
     }
 };
 
 using in_radix_leaf_unique_ptr = std::unique_ptr<
-    in_radix_leaf, in_radix_leaf_deleter>;
+    in_radix_leaf, in_radix_deleter>;
+
+template<typename T>
+using in_radix_node_unique_ptr = std::unique_ptr<T, in_radix_deleter>;
 
 u8 in_radix_node::get_prefix_match_len(const char* key) const
 {
@@ -98,68 +273,6 @@ void* in_radix_node::get_child_ptr(u8 key) const
     return (childPtrPtr) ? *childPtrPtr : nullptr;
 }
 
-void in_radix_node::destroy() noexcept
-{
-    // Delete leaf nodes.
-    if (is_leaf())
-    {
-        ::operator delete(this);
-        return;
-    }
-
-    // Recursively delete child nodes.
-    switch (type())
-    {
-    case in_radix_node_type::node4:
-    {
-        const auto node4 = static_cast<in_radix_node4*>(this);
-        for (u8 i = 0; i < node4->small_node_child_count(); ++i)
-        {
-            static_cast<in_radix_node*>(node4->children[i])->destroy();
-        }
-
-        delete node4;
-        break;
-    }
-
-    case in_radix_node_type::node16:
-    {
-        const auto node16 = static_cast<in_radix_node16*>(this);
-        for (u8 i = 0; i < node16->small_node_child_count(); ++i)
-        {
-            static_cast<in_radix_node*>(node16->children[i])->destroy();
-        }
-
-        delete node16;
-        break;
-    }
-
-    case in_radix_node_type::node48:
-    {
-        const auto node48 = static_cast<in_radix_node48*>(this);
-        for (auto child : node48->children)
-        {
-            if (child) static_cast<in_radix_node*>(child)->destroy();
-        }
-
-        delete node48;
-        break;
-    }
-
-    case in_radix_node_type::node256:
-    {
-        const auto node256 = static_cast<in_radix_node256*>(this);
-        for (auto child : node256->children)
-        {
-            if (child) static_cast<in_radix_node*>(child)->destroy();
-        }
-
-        delete node256;
-        break;
-    }
-    }
-}
-
 in_radix_node::in_radix_node(in_radix_node_type type) noexcept :
     flags(static_cast<u8>(type)),
     prefix() {}
@@ -239,7 +352,7 @@ in_radix_node256::in_radix_node256(const in_radix_node48& node48) noexcept :
     }
 }
 
-in_radix_leaf* in_radix_leaf::create(std::size_t size,
+in_radix_leaf* in_radix_leaf::create(in_radix_pool& pool, std::size_t size,
     std::size_t index, const char* key)
 {
     // Get key length.
@@ -250,8 +363,8 @@ in_radix_leaf* in_radix_leaf::create(std::size_t size,
         "The given key was too long!");
 
     // Allocate leaf node memory.
-    const auto leaf = static_cast<in_radix_leaf*>(
-        ::operator new(size + keyLen + 1));
+    const auto leaf = static_cast<in_radix_leaf*>(pool.allocate(
+        size + keyLen + 1, __STDCPP_DEFAULT_NEW_ALIGNMENT__));
 
     // Set node type, key length, and leaf index.
     leaf->type = UINT8_MAX;
@@ -270,7 +383,7 @@ in_radix_tree::in_iterator in_radix_tree::in_add_leaf(in_radix_leaf& leaf)
     return in_get_leaf_it(leafNodeIndex);
 }
 
-static void in_add_child_node(void** nodePtrPtr,
+static void in_add_child_node(in_radix_pool& pool, void** nodePtrPtr,
     in_radix_sort_func sortFuncPtr, u8 key, void* child)
 {
     assert(!static_cast<in_radix_node*>(*nodePtrPtr)->is_leaf() &&
@@ -305,19 +418,20 @@ static void in_add_child_node(void** nodePtrPtr,
         else
         {
             // Create new node16 from existing node4.
-            auto node16 = std::unique_ptr<in_radix_node16>(
-                new in_radix_node16(*node4));
+            in_radix_node_unique_ptr<in_radix_node16> node16(
+                in_radix_new_node<in_radix_node16>(pool, *node4),
+                in_radix_deleter{ &pool });
 
             // Add child to the new node16.
             void* node16Ptr = node16.get();
-            in_add_child_node(&node16Ptr, sortFuncPtr, key, child);
+            in_add_child_node(pool, &node16Ptr, sortFuncPtr, key, child);
             node16.release();
 
             // Set the node pointer to the new node16.
             *nodePtrPtr = node16Ptr;
 
             // Delete the existing node4.
-            delete node4;
+            pool.free(node4);
         }
 
         break;
@@ -330,13 +444,28 @@ static void in_add_child_node(void** nodePtrPtr,
 
         if (childCount < node16->children.size())
         {
-            // TODO: Do an SSE2 comparison instead if possible.
-
             // Determine the index the child should be placed at using the correct sorting order.
             u8 i;
-            for (i = 0;
-                i < childCount && sortFuncPtr(key, node16->keys[i]) >= 0;
-                ++i) {}
+#ifdef HL_IN_HAS_SSE2
+            if (sortFuncPtr == in_radix_default_sort_func)
+            {
+                // The keys are sorted as unsigned bytes, so the index is just the number of
+                // keys less than or equal to the new key, which SSE2 can find in one go.
+                const auto keyVec = _mm_set1_epi8(static_cast<char>(key));
+                const auto bitmask = (static_cast<unsigned int>(_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(_mm_max_epu8(_mm_load_si128(
+                        reinterpret_cast<const __m128i*>(node16->keys.data())),
+                        keyVec), keyVec))) & ((1U << childCount) - 1));
+
+                i = static_cast<u8>(bit_ctz(~bitmask));
+            }
+            else
+#endif
+            {
+                for (i = 0;
+                    i < childCount && sortFuncPtr(key, node16->keys[i]) >= 0;
+                    ++i) {}
+            }
 
             // Shift key and child arrays 1 element to the right to make room for the child.
             std::move(node16->keys.begin() + i, node16->keys.end() - 1,
@@ -352,8 +481,9 @@ static void in_add_child_node(void** nodePtrPtr,
         else
         {
             // Create new node48 from existing node16.
-            auto node48 = std::unique_ptr<in_radix_node48>(
-                new in_radix_node48(*node16));
+            in_radix_node_unique_ptr<in_radix_node48> node48(
+                in_radix_new_node<in_radix_node48>(pool, *node16),
+                in_radix_deleter{ &pool });
 
             // Add child to the new node48.
             node48->set_child_unchecked(16, key, child);
@@ -363,7 +493,7 @@ static void in_add_child_node(void** nodePtrPtr,
             *nodePtrPtr = node48.release();
 
             // Delete the existing node16.
-            delete node16;
+            pool.free(node16);
         }
 
         break;
@@ -386,14 +516,15 @@ static void in_add_child_node(void** nodePtrPtr,
         else
         {
             // Create new node256 from existing node48.
-            auto node256 = std::unique_ptr<in_radix_node256>(
-                new in_radix_node256(*node48));
+            in_radix_node_unique_ptr<in_radix_node256> node256(
+                in_radix_new_node<in_radix_node256>(pool, *node48),
+                in_radix_deleter{ &pool });
 
             // Add child to the new node256.
             node256->children[key] = child;
 
             // Delete the existing node48.
-            delete node48;
+            pool.free(node48);
 
             // Set the node pointer to the new node256.
             *nodePtrPtr = node256.release();
@@ -411,13 +542,14 @@ static void in_add_child_node(void** nodePtrPtr,
     }
 }
 
-static std::unique_ptr<in_radix_node4> in_create_expanded_node(
-    in_radix_sort_func sortFuncPtr,
+static in_radix_node_unique_ptr<in_radix_node4> in_create_expanded_node(
+    in_radix_pool& pool, in_radix_sort_func sortFuncPtr,
     const char* key, const char* leafKey,
     in_radix_leaf& leaf, in_radix_leaf& newLeaf)
 {
     // Create new node4.
-    auto newNodePtr = std::unique_ptr<in_radix_node4>(new in_radix_node4());
+    in_radix_node_unique_ptr<in_radix_node4> newNodePtr(
+        in_radix_new_node<in_radix_node4>(pool), in_radix_deleter{ &pool });
 
     // Setup new node prefix.
     auto newPrefix = newNodePtr->prefix.begin();
@@ -452,7 +584,7 @@ static std::unique_ptr<in_radix_node4> in_create_expanded_node(
     {
         assert(*key);
 
-        auto childNodePtr = in_create_expanded_node(sortFuncPtr,
+        auto childNodePtr = in_create_expanded_node(pool, sortFuncPtr,
             key + 1, leafKey + 1, leaf, newLeaf);
 
         newNodePtr->set_child_unchecked(0, *key, childNodePtr.release());
@@ -465,6 +597,7 @@ static std::unique_ptr<in_radix_node4> in_create_expanded_node(
 std::pair<in_radix_tree::in_iterator, bool> in_radix_tree::in_insert(
     const char* key, std::size_t leafSize)
 {
+    auto& pool = in_get_pool();
     auto keySlice = key;
     void** nodePtrPtr = &m_rootNode;
 
@@ -488,10 +621,11 @@ std::pair<in_radix_tree::in_iterator, bool> in_radix_tree::in_insert(
 
             // Create a new leaf node.
             in_radix_leaf_unique_ptr newLeaf(in_radix_leaf::create(
-                leafSize, m_leafNodes.size(), key));
+                pool, leafSize, m_leafNodes.size(), key),
+                in_radix_deleter{ &pool });
 
             // Create a new expanded node.
-            auto newNodePtr = in_create_expanded_node(m_sortFuncPtr,
+            auto newNodePtr = in_create_expanded_node(pool, m_sortFuncPtr,
                 keySlice, leafKeySlice, leaf, *newLeaf);
 
             // Add new leaf to tree, update existing node pointer, and return new leaf iterator.
@@ -506,7 +640,9 @@ std::pair<in_radix_tree::in_iterator, bool> in_radix_tree::in_insert(
         if (prefixMatchLen != node.prefixLen)
         {
             // Create a new node4.
-            std::unique_ptr<in_radix_node4> newNodePtr(new in_radix_node4());
+            in_radix_node_unique_ptr<in_radix_node4> newNodePtr(
+                in_radix_new_node<in_radix_node4>(pool),
+                in_radix_deleter{ &pool });
 
             // Setup new node prefix.
             char* oldPrefix = node.prefix.data();
@@ -525,7 +661,8 @@ std::pair<in_radix_tree::in_iterator, bool> in_radix_tree::in_insert(
 
             // Create a new leaf node.
             in_radix_leaf_unique_ptr newLeaf(in_radix_leaf::create(
-                leafSize, m_leafNodes.size(), key));
+                pool, leafSize, m_leafNodes.size(), key),
+                in_radix_deleter{ &pool });
 
             // Add children to new node in the correct sorting order.
             const char newFirstCh = keySlice[0];
@@ -558,9 +695,11 @@ std::pair<in_radix_tree::in_iterator, bool> in_radix_tree::in_insert(
         if (!nextNodePtrPtr)
         {
             in_radix_leaf_unique_ptr newLeaf(in_radix_leaf::create(
-                leafSize, m_leafNodes.size(), key));
+                pool, leafSize, m_leafNodes.size(), key),
+                in_radix_deleter{ &pool });
 
-            in_add_child_node(nodePtrPtr, m_sortFuncPtr, *keySlice, newLeaf.get());
+            in_add_child_node(pool, nodePtrPtr, m_sortFuncPtr,
+                *keySlice, newLeaf.get());
             const auto newLeafIt = in_add_leaf(*newLeaf);
             newLeaf.release();
 
@@ -580,13 +719,189 @@ std::pair<in_radix_tree::in_iterator, bool> in_radix_tree::in_insert(
 
     // Add new leaf to tree, update existing node pointer, and return new leaf iterator.
     in_radix_leaf_unique_ptr newLeaf(in_radix_leaf::create(
-        leafSize, m_leafNodes.size(), key));
+        pool, leafSize, m_leafNodes.size(), key),
+        in_radix_deleter{ &pool });
 
     const auto newLeafIt = in_add_leaf(*newLeaf);
     *nodePtrPtr = newLeaf.release();
     return { newLeafIt, true };
 }
 
+static void in_set_sorted_child(void* nodePtr, u8 index, u8 key, void* child) noexcept
+{
+    switch (static_cast<in_radix_node*>(nodePtr)->type())
+    {
+    case in_radix_node_type::node4:
+    {
+        const auto node4 = static_cast<in_radix_node4*>(nodePtr);
+        node4->set_child_unchecked(index, key, child);
+        ++node4->flags;
+        break;
+    }
+
+    case in_radix_node_type::node16:
+    {
+        const auto node16 = static_cast<in_radix_node16*>(nodePtr);
+        node16->set_child_unchecked(index, key, child);
+        ++node16->flags;
+        break;
+    }
+
+    case in_radix_node_type::node48:
+    {
+        const auto node48 = static_cast<in_radix_node48*>(nodePtr);
+        node48->set_child_unchecked(index, key, child);
+        ++node48->flags;
+        break;
+    }
+
+    case in_radix_node_type::node256:
+    {
+        const auto node256 = static_cast<in_radix_node256*>(nodePtr);
+        node256->children[key] = child;
+        break;
+    }
+    }
+}
+
+static void* in_build_sorted_node(in_radix_pool& pool, std::vector<in_radix_leaf*>& leafNodes,
+    const char* const* keys, std::size_t keyCount, std::size_t depth, std::size_t leafSize)
+{
+    // If only one key remains, just create a leaf for it.
+    if (keyCount == 1)
+    {
+        const auto leaf = in_radix_leaf::create(pool,
+            leafSize, leafNodes.size(), keys[0]);
+
+        leafNodes.push_back(leaf);
+        return leaf;
+    }
+
+    // Determine how much of the remaining key slices are shared by all of the keys.
+    // (Since the keys are sorted, this is just what the first and last keys share.)
+    const char* firstKeySlice = (keys[0] + depth);
+    const char* lastKeySlice = (keys[keyCount - 1] + depth);
+    std::size_t prefixLen = 0;
+
+    while (firstKeySlice[prefixLen] == lastKeySlice[prefixLen])
+    {
+        ++prefixLen;
+    }
+
+    // Count how many distinct characters immediately follow the shared prefix.
+    // If the prefix is too long to fit within one node, chain a node with just
+    // a single child instead, just like in_create_expanded_node does.
+    std::size_t childCount = 1;
+    if (prefixLen > in_radix_max_prefix_len)
+    {
+        prefixLen = in_radix_max_prefix_len;
+    }
+    else
+    {
+        for (std::size_t i = 1; i < keyCount; ++i)
+        {
+            childCount += (keys[i][depth + prefixLen] !=
+                keys[i - 1][depth + prefixLen]);
+        }
+    }
+
+    // Create the smallest node that can fit all of the children.
+    in_radix_node* node;
+    if (childCount <= 4)
+    {
+        node = in_radix_new_node<in_radix_node4>(pool);
+    }
+    else if (childCount <= 16)
+    {
+        node = in_radix_new_node<in_radix_node16>(pool);
+    }
+    else if (childCount <= 48)
+    {
+        node = in_radix_new_node<in_radix_node48>(pool);
+    }
+    else
+    {
+        node = in_radix_new_node<in_radix_node256>(pool);
+    }
+
+    // Setup node prefix.
+    std::memcpy(node->prefix.data(), firstKeySlice, prefixLen);
+    node->prefixLen = static_cast<u8>(prefixLen);
+
+    // Recursively build child nodes, in order, from each range of keys which
+    // share the same character after the prefix.
+    const auto childDepth = (depth + prefixLen);
+    std::size_t childKeysBegin = 0;
+    u8 childIndex = 0;
+
+    for (std::size_t i = 1; i <= keyCount; ++i)
+    {
+        const auto childKey = static_cast<u8>(
+            keys[childKeysBegin][childDepth]);
+
+        if (i < keyCount && static_cast<u8>(keys[i][childDepth]) == childKey)
+        {
+            continue;
+        }
+
+        const auto child = in_build_sorted_node(pool, leafNodes,
+            keys + childKeysBegin, i - childKeysBegin,
+            childDepth + 1, leafSize);
+
+        in_set_sorted_child(node, childIndex++, childKey, child);
+        childKeysBegin = i;
+    }
+
+    return node;
+}
+
+static int in_compare_keys(in_radix_sort_func sortFuncPtr,
+    const char* key1, const char* key2)
+{
+    while (*key1 && *key1 == *key2)
+    {
+        ++key1;
+        ++key2;
+    }
+
+    return sortFuncPtr(*key1, *key2);
+}
+
+bool in_radix_tree::in_build_sorted(const char* const* keys,
+    std::size_t keyCount, std::size_t leafSize)
+{
+    assert(!m_rootNode && m_leafNodes.empty() &&
+        "Trees can only be bulk-built while empty!");
+
+    // Ensure the given keys are unique and sorted in the order used by this tree.
+    for (std::size_t i = 1; i < keyCount; ++i)
+    {
+        if (in_compare_keys(m_sortFuncPtr, keys[i - 1], keys[i]) >= 0)
+        {
+            return false;
+        }
+    }
+
+    if (keyCount == 0) return true;
+
+    // Build the tree from the top down, creating each
+    // leaf node in the same order as the given keys.
+    m_leafNodes.reserve(keyCount);
+
+    try
+    {
+        m_rootNode = in_build_sorted_node(in_get_pool(),
+            m_leafNodes, keys, keyCount, 0, leafSize);
+    }
+    catch (...)
+    {
+        m_leafNodes.clear();
+        throw;
+    }
+
+    return true;
+}
+
 const in_radix_leaf* in_radix_tree::in_find_leaf(
     const char* key, std::size_t leafSize) const
 {
@@ -622,12 +937,26 @@ const in_radix_leaf* in_radix_tree::in_find_leaf(
     return nullptr;
 }
 
+in_radix_pool& in_radix_tree::in_get_pool()
+{
+    if (!m_pool)
+    {
+        m_pool = in_radix_pool::create(m_arena);
+    }
+
+    return *m_pool;
+}
+
 void in_radix_tree::in_destroy() noexcept
 {
-    if (m_rootNode)
+    // Free every node in the tree at once by releasing the pool they were allocated from.
+    if (m_pool)
     {
-        static_cast<in_radix_node*>(m_rootNode)->destroy();
+        m_pool->release();
+        m_pool = nullptr;
     }
+
+    m_rootNode = nullptr;
 }
 
 in_radix_tree& in_radix_tree::operator=(in_radix_tree&& other) noexcept
@@ -639,22 +968,32 @@ in_radix_tree& in_radix_tree::operator=(in_radix_tree&& other) noexcept
         m_rootNode = other.m_rootNode;
         m_sortFuncPtr = other.m_sortFuncPtr;
         m_leafNodes = std::move(other.m_leafNodes);
+        m_arena = other.m_arena;
+        m_pool = other.m_pool;
         
         other.m_rootNode = nullptr;
+        other.m_pool = nullptr;
     }
     
     return *this;
 }
 
 in_radix_tree::in_radix_tree() noexcept :
-    m_sortFuncPtr(text::compare<unsigned char>) {}
+    m_sortFuncPtr(in_radix_default_sort_func) {}
+
+in_radix_tree::in_radix_tree(arena* arena) noexcept :
+    m_sortFuncPtr(in_radix_default_sort_func),
+    m_arena(arena) {}
 
 in_radix_tree::in_radix_tree(in_radix_tree&& other) noexcept :
     m_rootNode(other.m_rootNode),
     m_sortFuncPtr(other.m_sortFuncPtr),
-    m_leafNodes(std::move(other.m_leafNodes))
+    m_leafNodes(std::move(other.m_leafNodes)),
+    m_arena(other.m_arena),
+    m_pool(other.m_pool)
 {
     other.m_rootNode = nullptr;
+    other.m_pool = nullptr;
 }
 } // internal
 } // hl
@@ -1325,6 +1325,9 @@ void scene::export_fbx(const nchar* filePath, fbx_type type, fbx_version version
 {
     file_stream stream(filePath, file::mode::write);
     export_fbx(stream, type, version);
+
+    // Close file.
+    stream.close();
 }
 #endif
 } // hl
@@ -0,0 +1,217 @@
+#include "hedgelib/hl_thread_pool.h"
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace hl
+{
+struct in_parallel_for_state
+{
+    const std::function<void(std::size_t)>* func;
+    std::size_t count;
+    std::atomic<std::size_t> nextIndex;
+    std::atomic<bool> hasFailed;
+    std::size_t finishedCount = 0;
+    std::exception_ptr exception;
+    std::mutex mutex;
+    std::condition_variable finishedCondition;
+
+    void run() noexcept
+    {
+        std::size_t localFinishedCount = 0;
+        while (true)
+        {
+            // Claim the next index; return once all indices have been claimed.
+            const std::size_t i = nextIndex.fetch_add(1);
+            if (i >= count) break;
+
+            // Run the function, unless a previous call has already failed.
+            if (!hasFailed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    (*func)(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!exception)
+                    {
+                        exception = std::current_exception();
+                    }
+
+                    hasFailed = true;
+                }
+            }
+
+            ++localFinishedCount;
+        }
+
+        // Report the indices we finished, and wake the
+        // calling thread up if every index is now done.
+        if (localFinishedCount)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finishedCount += localFinishedCount;
+
+            if (finishedCount == count)
+            {
+                finishedCondition.notify_all();
+            }
+        }
+    }
+
+    in_parallel_for_state(const std::function<void(std::size_t)>& func,
+        std::size_t count) noexcept :
+        func(&func),
+        count(count),
+        nextIndex(0),
+        hasFailed(false) {}
+};
+
+void thread_pool::in_worker_main()
+{
+    while (true)
+    {
+        // Wait for a job to become available.
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_jobsMutex);
+            m_jobsCondition.wait(lock, [this]()
+            {
+                return (m_isStopping || !m_jobs.empty());
+            });
+
+            // Return if the pool is being destroyed and all jobs are done.
+            if (m_jobs.empty()) return;
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        // Run the job.
+        job();
+    }
+}
+
+void thread_pool::in_stop() noexcept
+{
+    // Tell all workers to stop once the job queue is empty.
+    {
+        std::lock_guard<std::mutex> lock(m_jobsMutex);
+        m_isStopping = true;
+    }
+
+    m_jobsCondition.notify_all();
+
+    // Wait for all workers to stop.
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+
+    m_workers.clear();
+}
+
+void thread_pool::in_push_jobs(std::size_t count,
+    const std::function<void()>& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_jobsMutex);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_jobs.push_back(job);
+        }
+    }
+
+    if (count == 1)
+    {
+        m_jobsCondition.notify_one();
+    }
+    else
+    {
+        m_jobsCondition.notify_all();
+    }
+}
+
+void thread_pool::parallel_for(std::size_t count,
+    const std::function<void(std::size_t)>& func)
+{
+    // Just run everything on this thread if there's no point in using workers.
+    if (count < 2 || m_workers.empty())
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            func(i);
+        }
+
+        return;
+    }
+
+    // Setup shared state. This is reference-counted, as worker jobs may start
+    // after every index has already been finished (E.G. if all workers were
+    // busy with an outer parallel_for call), and will still access the state.
+    const auto state = std::make_shared<in_parallel_for_state>(func, count);
+
+    // Push one job per worker which can actually do something useful.
+    in_push_jobs(std::min(m_workers.size(), count - 1), [state]()
+    {
+        state->run();
+    });
+
+    // Do work on this thread too, then wait for all other indices to finish.
+    state->run();
+
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finishedCondition.wait(lock, [&state]()
+        {
+            return (state->finishedCount == state->count);
+        });
+    }
+
+    // Re-throw the first exception which was thrown, if any.
+    if (state->exception)
+    {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+thread_pool& thread_pool::get_default()
+{
+    static thread_pool defaultPool;
+    return defaultPool;
+}
+
+static std::size_t in_get_default_worker_count() noexcept
+{
+    const unsigned int hwThreadCount = std::thread::hardware_concurrency();
+    return (hwThreadCount > 1) ? (hwThreadCount - 1) : 0;
+}
+
+thread_pool::thread_pool() :
+    thread_pool(in_get_default_worker_count()) {}
+
+thread_pool::thread_pool(std::size_t threadCount)
+{
+    m_workers.reserve(threadCount);
+    try
+    {
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            m_workers.emplace_back(&thread_pool::in_worker_main, this);
+        }
+    }
+    catch (...)
+    {
+        // Stop any workers we already started before re-throwing.
+        in_stop();
+        throw;
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    in_stop();
+}
+} // hl
@@ -1,4 +1,6 @@
 #include "hedgelib/io/hl_bina.h"
+#include <robin_hood.h>
+#include <string_view>
 #include <cstring>
 #include <cassert>
 
@@ -29,15 +31,15 @@ void pac_pack_meta::fix(void* rawData, endian_flag endianFlag)
         endian_swap();
     }
 
-    // Fix offsets.
-    for (hl::u32& relOffPos : offsets())
+    // Endian swap offset positions if necessary.
+    if (needs_swap(endianFlag))
     {
-        // Endian swap offset position if necessary.
-        if (needs_swap(endianFlag))
-        {
-            hl::endian_swap(relOffPos);
-        }
+        endian_swap_arr(offCount, off_table());
+    }
 
+    // Fix offsets.
+    for (const hl::u32 relOffPos : offsets())
+    {
         // Get pointer to current offset.
         off32<void>* curOff = ptradd<off32<void>>(rawData, relOffPos);
 
@@ -76,24 +78,59 @@ static void in_strings_write(std::size_t dataPos,
     endian_flag endianFlag, const str_table& strTable,
     off_table& offTable, stream& stream)
 {
-    std::unique_ptr<bool[]> isDuplicateEntry(new bool[strTable.size()]());
+    // Map each string entry to the first entry which uses the same string.
+    robin_hood::unordered_flat_map<std::string_view, std::size_t> uniqueStrIndices;
+    std::vector<std::size_t> uniqueStrEntryIndices;
+    std::unique_ptr<std::size_t[]> entryUniqueStrIndices(
+        new std::size_t[strTable.size()]);
+
+    uniqueStrIndices.reserve(strTable.size());
 
-    // Write strings and fix offsets in string entries.
     for (std::size_t i = 0; i < strTable.size(); ++i)
     {
-        // Skip the current string entry if it's a duplicate.
-        if (isDuplicateEntry[i]) continue;
+        const auto result = uniqueStrIndices.emplace(
+            strTable[i].str, uniqueStrEntryIndices.size());
+
+        if (result.second)
+        {
+            uniqueStrEntryIndices.push_back(i);
+        }
 
-        // Add offset position to offset table.
-        const str_table_entry& curEntry = strTable[i];
-        offTable.push_back(curEntry.offPos);
+        entryUniqueStrIndices[i] = result.first->second;
+    }
 
-        // Jump to offset position.
-        const std::size_t curStrPos = stream.tell();
-        stream.jump_to(curEntry.offPos);
+    // Add offset positions to offset table, grouped by unique string
+    // (in order of first use), just like older versions of HedgeLib did.
+    std::unique_ptr<std::size_t[]> uniqueStrOffTableIndices(
+        new std::size_t[uniqueStrEntryIndices.size() + 1]());
 
+    for (std::size_t i = 0; i < strTable.size(); ++i)
+    {
+        ++uniqueStrOffTableIndices[entryUniqueStrIndices[i] + 1];
+    }
+
+    uniqueStrOffTableIndices[0] = offTable.size();
+    for (std::size_t i = 1; i <= uniqueStrEntryIndices.size(); ++i)
+    {
+        uniqueStrOffTableIndices[i] += uniqueStrOffTableIndices[i - 1];
+    }
+
+    offTable.resize(offTable.size() + strTable.size());
+
+    for (std::size_t i = 0; i < strTable.size(); ++i)
+    {
+        offTable[uniqueStrOffTableIndices[entryUniqueStrIndices[i]]++] =
+            strTable[i].offPos;
+    }
+
+    // Write each unique string once, storing the offset which points to it.
+    std::unique_ptr<addr_t[]> uniqueStrOffs(
+        new addr_t[uniqueStrEntryIndices.size()]);
+
+    for (std::size_t i = 0; i < uniqueStrEntryIndices.size(); ++i)
+    {
         // Compute offset.
-        auto off = static_cast<addr_t>(curStrPos - dataPos);
+        auto off = static_cast<addr_t>(stream.tell() - dataPos);
 
         // Swap offset if necessary.
         if (needs_swap(endianFlag))
@@ -101,37 +138,41 @@ static void in_strings_write(std::size_t dataPos,
             hl::endian_swap(off);
         }
 
-        // Write fixed offset.
-        stream.write_obj(off);
+        uniqueStrOffs[i] = off;
 
-        // Mark duplicate string entries and fix duplicate offsets.
-        for (std::size_t i2 = (i + 1); i2 < strTable.size(); ++i2)
-        {
-            // If we've found a duplicate string entry...
-            const str_table_entry& dupEntry = strTable[i2];
-            if (curEntry.str == dupEntry.str)
-            {
-                // Add offset value to offset table.
-                offTable.push_back(dupEntry.offPos);
+        // Write string.
+        stream.write_str(strTable[uniqueStrEntryIndices[i]].str);
+    }
 
-                // Jump to offset position.
-                stream.jump_to(dupEntry.offPos);
+    // Sort offset fixups by position so they can all be written in one pass.
+    const std::size_t endPos = stream.tell();
+    std::vector<std::pair<std::size_t, addr_t>> offFixups;
 
-                // Write fixed offset.
-                stream.write_obj(off);
+    offFixups.reserve(strTable.size());
 
-                // Mark this string entry as a duplicate.
-                isDuplicateEntry[i2] = true;
-            }
-        }
+    for (std::size_t i = 0; i < strTable.size(); ++i)
+    {
+        offFixups.emplace_back(strTable[i].offPos,
+            uniqueStrOffs[entryUniqueStrIndices[i]]);
+    }
 
-        // Jump to string position.
-        stream.jump_to(curStrPos);
+    std::sort(offFixups.begin(), offFixups.end(),
+        [](const std::pair<std::size_t, addr_t>& a,
+            const std::pair<std::size_t, addr_t>& b)
+        {
+            return (a.first < b.first);
+        });
 
-        // Write string.
-        stream.write_str(curEntry.str);
+    // Write fixed offsets.
+    for (const auto& offFixup : offFixups)
+    {
+        stream.jump_to(offFixup.first);
+        stream.write_obj(offFixup.second);
     }
 
+    // Jump back to the end of the strings.
+    stream.jump_to(endPos);
+
     // Write padding.
     // NOTE: We pad to 4 even when writing 64-bit data, like Sonic Team.
     stream.pad(4);
@@ -254,6 +295,95 @@ off_table_handle::off_table_handle(const u8* offTable, u32 offTableSize) noexcep
     m_offTableBeg(offTable),
     m_offTableEnd(in_get_real_off_table_end(offTable, offTableSize)) {}
 
+void offsets_decode(off_table_handle offTable,
+    std::vector<u32>& offPositions)
+{
+    const u8* curOffTablePtr = offTable.begin().ptr();
+    const u8* offTableEnd = offTable.end().ptr();
+    u32 curOffPos = 0;
+
+    // Reserve space for the worst case (every offset being six bits long).
+    offPositions.clear();
+    offPositions.reserve(static_cast<std::size_t>(
+        offTableEnd - curOffTablePtr));
+
+    while (curOffTablePtr < offTableEnd)
+    {
+        // Decode runs of eight six-bit offsets at a time, as these
+        // make up the vast majority of entries in most offset tables.
+        while ((offTableEnd - curOffTablePtr) >= 8)
+        {
+            u64 entries;
+            std::memcpy(&entries, curOffTablePtr, sizeof(entries));
+
+            // Stop if any of these entries are not six bits long.
+            if ((entries & 0xC0C0C0C0C0C0C0C0ULL) != 0x4040404040404040ULL)
+            {
+                break;
+            }
+
+            for (std::size_t i = 0; i < 8; ++i)
+            {
+                curOffPos += (static_cast<u32>(curOffTablePtr[i] &
+                    static_cast<u8>(offset_flags::data_mask)) * sizeof(u32));
+
+                offPositions.push_back(curOffPos);
+            }
+
+            curOffTablePtr += 8;
+        }
+
+        if (curOffTablePtr >= offTableEnd) break;
+
+        // Decode the current offset, whatever its size.
+        u32 relOffPos;
+        switch (*curOffTablePtr & static_cast<u8>(offset_flags::size_mask))
+        {
+        case static_cast<u8>(offset_flags::size_six_bit):
+            relOffPos = in_grab_six_bits(curOffTablePtr);
+            break;
+
+        case static_cast<u8>(offset_flags::size_fourteen_bit):
+            if ((offTableEnd - curOffTablePtr) < 2) return;
+            relOffPos = in_grab_fourteen_bits(curOffTablePtr);
+            break;
+
+        case static_cast<u8>(offset_flags::size_thirty_bit):
+            if ((offTableEnd - curOffTablePtr) < 4) return;
+            relOffPos = in_grab_thirty_bits(curOffTablePtr);
+            break;
+
+        default:
+            // A size of 0 indicates that we've reached the end of the offset table.
+            return;
+        }
+
+        // Add absolute offset position to list.
+        curOffPos += (relOffPos * sizeof(u32));
+        offPositions.push_back(curOffPos);
+    }
+}
+
+template<template<typename> class off_t>
+static void in_offsets_fix(const std::vector<u32>& offPositions,
+    const endian_flag endianFlag, void* base)
+{
+    for (const u32 offPos : offPositions)
+    {
+        // Get pointer to current offset.
+        const auto curOffPtr = ptradd<off_t<void>>(base, offPos);
+
+        // Endian-swap offset if necessary.
+        if (needs_swap(endianFlag))
+        {
+            hl::endian_swap(*curOffPtr);
+        }
+
+        // Fix offset.
+        curOffPtr->fix(base);
+    }
+}
+
 template<template<typename> class off_t>
 static void in_offsets_fix(off_table_handle offTable,
     const endian_flag endianFlag, void* base)
@@ -281,23 +411,35 @@ void offsets_fix32(off_table_handle offTable,
     in_offsets_fix<off32>(offTable, endianFlag, base);
 }
 
+void offsets_fix32(const std::vector<u32>& offPositions,
+    const endian_flag endianFlag, void* base)
+{
+    in_offsets_fix<off32>(offPositions, endianFlag, base);
+}
+
 void offsets_fix64(off_table_handle offTable,
     const endian_flag endianFlag, void* base)
 {
     in_offsets_fix<off64>(offTable, endianFlag, base);
 }
 
+void offsets_fix64(const std::vector<u32>& offPositions,
+    const endian_flag endianFlag, void* base)
+{
+    in_offsets_fix<off64>(offPositions, endianFlag, base);
+}
+
 template<template<typename> class off_t>
-void in_offsets_copy(off_table_handle srcOffTable,
+void in_offsets_copy(const std::vector<u32>& srcOffPositions,
     const void* srcBase, void* dstBase)
 {
     const auto srcBaseAddr = reinterpret_cast<std::uintptr_t>(srcBase);
     const auto dstBaseAddr = reinterpret_cast<std::uintptr_t>(dstBase);
 
-    for (u32 relOffPos : srcOffTable)
+    for (const u32 offPos : srcOffPositions)
     {
         // Get pointer to current source offset.
-        const auto srcOffPtr = ptradd<off_t<void>>(srcBase, relOffPos);
+        const auto srcOffPtr = ptradd<off_t<void>>(srcBase, offPos);
 
         // Get the address of the value the offset points to.
         const auto offVal = reinterpret_cast<std::uintptr_t>(srcOffPtr->get());
@@ -306,13 +448,22 @@ void in_offsets_copy(off_table_handle srcOffTable,
         const auto offRelVal = (offVal - srcBaseAddr);
 
         // Get pointer to current destination offset.
-        const auto dstOffPtr = ptradd<off_t<void>>(dstBase, relOffPos);
+        const auto dstOffPtr = ptradd<off_t<void>>(dstBase, offPos);
 
         // Fix destination offset.
         *dstOffPtr = reinterpret_cast<void*>(dstBaseAddr + offRelVal);
     }
 }
 
+template<template<typename> class off_t>
+void in_offsets_copy(off_table_handle srcOffTable,
+    const void* srcBase, void* dstBase)
+{
+    std::vector<u32> srcOffPositions;
+    offsets_decode(srcOffTable, srcOffPositions);
+    in_offsets_copy<off_t>(srcOffPositions, srcBase, dstBase);
+}
+
 void offsets_copy32(off_table_handle srcOffTable,
     const void* srcBase, void* dstBase)
 {
@@ -324,6 +475,17 @@ void offsets_copy32(off_table_handle srcOffTable,
 #endif
 }
 
+void offsets_copy32(const std::vector<u32>& srcOffPositions,
+    const void* srcBase, void* dstBase)
+{
+    // NOTE: We only fix up the copied offsets if they are absolute.
+    // If the offsets are relative, nothing needs to be done.
+
+#if UINTPTR_MAX > UINT32_MAX
+    in_offsets_copy<off32>(srcOffPositions, srcBase, dstBase);
+#endif
+}
+
 void offsets_copy64(off_table_handle srcOffTable,
     const void* srcBase, void* dstBase)
 {
@@ -335,6 +497,17 @@ void offsets_copy64(off_table_handle srcOffTable,
 #endif
 }
 
+void offsets_copy64(const std::vector<u32>& srcOffPositions,
+    const void* srcBase, void* dstBase)
+{
+    // NOTE: We only fix up the copied offsets if they are absolute.
+    // If the offsets are relative, nothing needs to be done.
+
+#if UINTPTR_MAX > UINT64_MAX
+    in_offsets_copy<off64>(srcOffPositions, srcBase, dstBase);
+#endif
+}
+
 void offsets_write_no_sort(std::size_t dataPos,
     const off_table& offTable, stream& stream)
 {
@@ -1,11 +1,14 @@
 #include "hedgelib/io/hl_file.h"
 #include "hedgelib/hl_blob.h"
+#include <algorithm>
+#include <cstring>
 
 #ifdef _WIN32
 #include "../hl_in_win32.h"
 #elif defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
 #include "../hl_in_posix.h"
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h> 
 #include <unistd.h>
 #else
@@ -45,7 +48,12 @@ void save(const void* data, std::size_t dataSize, const nchar* filePath)
     file_stream file(filePath, mode::write);
 
     // Write all bytes in the buffer to the file.
-    file.write_all(dataSize, data);
+    // NOTE: We write directly to the file rather than through the stream's
+    // write buffer, since we already have all of the data in one place.
+    file.write_all_at(0, dataSize, data);
+
+    // Close file.
+    file.close();
 }
 
 void save(const blob& fileData, const nchar* filePath)
@@ -54,31 +62,52 @@ void save(const blob& fileData, const nchar* filePath)
 }
 } // file
 
-std::size_t file_stream::read(std::size_t size, void* buf)
-{
 #ifdef _WIN32
-    // Ensure size can fit within a DWORD before casting to one.
-    if (size > ULONG_MAX)
-    {
-        throw out_of_range_exception();
-    }
+static OVERLAPPED in_win32_file_get_overlapped(std::size_t pos) noexcept
+{
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(pos);
+    overlapped.OffsetHigh = static_cast<DWORD>(static_cast<u64>(pos) >> 32);
+    return overlapped;
+}
+#endif
 
-    // Read the given number of bytes from the file.
-    DWORD readBytes;
-    const auto succeeded = ReadFile(reinterpret_cast<HANDLE>(m_handle),
-        buf, static_cast<DWORD>(size), &readBytes, NULL);
+void file_stream::in_handle_jump_to(std::size_t pos)
+{
+#ifdef _WIN32
+    // NOTE: On Windows, all reads and writes explicitly specify the
+    // position to read from/write to, so we never need to move the
+    // OS' file pointer ourselves.
+    m_handlePos = pos;
+#else
+    // Return early if the file pointer is already at the given position.
+    if (m_handlePos == pos) return;
 
-    // Increase stream curPos.
-    m_curPos += readBytes;
+    // Jump to the given position.
+    const auto curPos = lseek(static_cast<int>(m_handle),
+        static_cast<off_t>(pos), SEEK_SET);
 
     // Throw an exception if we encountered an error.
-    if (!succeeded)
+    if (curPos == static_cast<off_t>(-1))
     {
-        throw in_win32_get_last_exception();
+        throw in_posix_get_last_exception();
     }
 
+    m_handlePos = pos;
+#endif
+}
+
+std::size_t file_stream::in_handle_read(std::size_t size, void* buf)
+{
+#ifdef _WIN32
+    // Read the given number of bytes from the file.
+    const auto readBytes = in_handle_read_at(m_handlePos, size, buf);
+
+    // Increase file pointer position.
+    m_handlePos += readBytes;
+
     // Return read byte count.
-    return static_cast<std::size_t>(readBytes);
+    return readBytes;
 #else
     // Ensure size can fit within a ssize_t before casting to one.
     if (size > SSIZE_MAX)
@@ -89,10 +118,10 @@ std::size_t file_stream::read(std::size_t size, void* buf)
     // Read the given number of bytes from the file.
     const auto readBytes = ::read(static_cast<int>(m_handle), buf, size);
 
-    // Increase stream curPos if the read succeeded.
+    // Increase file pointer position if the read succeeded.
     if (readBytes != -1)
     {
-        m_curPos += readBytes;
+        m_handlePos += readBytes;
     }
 
     // Otherwise, throw an exception.
@@ -106,31 +135,17 @@ std::size_t file_stream::read(std::size_t size, void* buf)
 #endif
 }
 
-std::size_t file_stream::write(std::size_t size, const void* buf)
+std::size_t file_stream::in_handle_write(std::size_t size, const void* buf)
 {
 #ifdef _WIN32
-    // Ensure size can fit within a DWORD before casting to one.
-    if (size > ULONG_MAX)
-    {
-        throw out_of_range_exception();
-    }
-
     // Write the given number of bytes to the file.
-    DWORD writtenBytes;
-    const auto succeeded = WriteFile(reinterpret_cast<HANDLE>(m_handle),
-        buf, static_cast<DWORD>(size), &writtenBytes, NULL);
+    const auto writtenBytes = in_handle_write_at(m_handlePos, size, buf);
 
-    // Increase stream curPos.
-    m_curPos += writtenBytes;
-
-    // Throw an exception if we encountered an error.
-    if (!succeeded)
-    {
-        throw in_win32_get_last_exception();
-    }
+    // Increase file pointer position.
+    m_handlePos += writtenBytes;
 
     // Return written byte count.
-    return static_cast<std::size_t>(writtenBytes);
+    return writtenBytes;
 #else
     // Ensure size can fit within a ssize_t before casting to one.
     if (size > SSIZE_MAX)
@@ -141,10 +156,10 @@ std::size_t file_stream::write(std::size_t size, const void* buf)
     // Write the given number of bytes to the file.
     const auto writtenBytes = ::write(static_cast<int>(m_handle), buf, size);
 
-    // Increase stream curPos if the write succeeded.
+    // Increase file pointer position if the write succeeded.
     if (writtenBytes != -1)
     {
-        m_curPos += writtenBytes;
+        m_handlePos += writtenBytes;
     }
 
     // Otherwise, throw an exception.
@@ -158,111 +173,356 @@ std::size_t file_stream::write(std::size_t size, const void* buf)
 #endif
 }
 
-#ifdef _WIN32
-static DWORD in_win32_file_get_move_method(const seek_mode mode)
+std::size_t file_stream::in_handle_read_at(std::size_t pos,
+    std::size_t size, void* buf) const
 {
-    switch (mode)
+#ifdef _WIN32
+    // Ensure size can fit within a DWORD before casting to one.
+    if (size > ULONG_MAX)
     {
-    default:
-    case seek_mode::beg:
-        return FILE_BEGIN;
+        throw out_of_range_exception();
+    }
 
-    case seek_mode::cur:
-        return FILE_CURRENT;
+    // Read the given number of bytes from the given position within the file.
+    DWORD readBytes;
+    auto overlapped = in_win32_file_get_overlapped(pos);
 
-    case seek_mode::end:
-        return FILE_END;
+    if (!ReadFile(reinterpret_cast<HANDLE>(m_handle), buf,
+        static_cast<DWORD>(size), &readBytes, &overlapped))
+    {
+        // Reading from the end of the file isn't an error; it just reads nothing.
+        if (GetLastError() == ERROR_HANDLE_EOF)
+        {
+            return 0;
+        }
+
+        throw in_win32_get_last_exception();
     }
-}
-#elif defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
-static int in_posix_file_get_seek_method(const seek_mode mode)
-{
-    switch (mode)
+
+    // Return read byte count.
+    return static_cast<std::size_t>(readBytes);
+#else
+    // Ensure size can fit within a ssize_t before casting to one.
+    if (size > SSIZE_MAX)
     {
-    default:
-    case seek_mode::beg:
-        return SEEK_SET;
+        throw out_of_range_exception();
+    }
 
-    case seek_mode::cur:
-        return SEEK_CUR;
+    // Read the given number of bytes from the given position within the file.
+    const auto readBytes = ::pread(static_cast<int>(m_handle),
+        buf, size, static_cast<off_t>(pos));
 
-    case seek_mode::end:
-        return SEEK_END;
+    // Throw an exception if we encountered an error.
+    if (readBytes == -1)
+    {
+        throw in_posix_get_last_exception();
     }
-}
+
+    // Return read byte count.
+    return static_cast<std::size_t>(readBytes);
 #endif
+}
 
-void file_stream::seek(seek_mode mode, long long offset)
+std::size_t file_stream::in_handle_write_at(std::size_t pos,
+    std::size_t size, const void* buf)
 {
 #ifdef _WIN32
-    // Seek using the given parameters.
-    LARGE_INTEGER loffset, lcurPos;
-    loffset.QuadPart = static_cast<LONGLONG>(offset);
-
-    const auto succeeded = SetFilePointerEx(reinterpret_cast<HANDLE>(m_handle),
-        loffset, &lcurPos, in_win32_file_get_move_method(mode));
+    // Ensure size can fit within a DWORD before casting to one.
+    if (size > ULONG_MAX)
+    {
+        throw out_of_range_exception();
+    }
 
-    // Set stream curPos.
-    m_curPos = static_cast<std::size_t>(lcurPos.QuadPart);
+    // Write the given number of bytes to the given position within the file.
+    DWORD writtenBytes;
+    auto overlapped = in_win32_file_get_overlapped(pos);
 
-    // Throw an exception if we encountered an error.
-    if (!succeeded)
+    if (!WriteFile(reinterpret_cast<HANDLE>(m_handle), buf,
+        static_cast<DWORD>(size), &writtenBytes, &overlapped))
     {
         throw in_win32_get_last_exception();
     }
+
+    // Return written byte count.
+    return static_cast<std::size_t>(writtenBytes);
 #else
-    // Seek using the given parameters.
-    const auto curPos = lseek(static_cast<int>(m_handle),
-        static_cast<off_t>(offset),
-        in_posix_file_get_seek_method(mode));
+    // Ensure size can fit within a ssize_t before casting to one.
+    if (size > SSIZE_MAX)
+    {
+        throw out_of_range_exception();
+    }
+
+    // Write the given number of bytes to the given position within the file.
+    const auto writtenBytes = ::pwrite(static_cast<int>(m_handle),
+        buf, size, static_cast<off_t>(pos));
 
     // Throw an exception if we encountered an error.
-    if (curPos == static_cast<off_t>(-1))
+    if (writtenBytes == -1)
     {
         throw in_posix_get_last_exception();
     }
 
-    // Set stream curPos.
-    m_curPos = static_cast<std::size_t>(curPos);
+    // Return written byte count.
+    return static_cast<std::size_t>(writtenBytes);
 #endif
 }
 
-void file_stream::jump_to(std::size_t pos)
+void file_stream::in_flush_write_buf()
 {
-#ifdef _WIN32
-    // Jump to the given position.
-    LARGE_INTEGER loffset, lcurPos;
-    loffset.QuadPart = static_cast<LONGLONG>(pos);
+    // Return early if there's nothing to write.
+    if (!m_writeBufLen) return;
 
-    const auto succeeded = SetFilePointerEx(reinterpret_cast<HANDLE>(m_handle),
-        loffset, &lcurPos, FILE_BEGIN);
+    // Mark the buffered data as written up-front, so that if writing
+    // it fails, we don't just keep trying to write it again.
+    const u8* data = m_writeBuf.get();
+    std::size_t size = m_writeBufLen;
+    m_writeBufLen = 0;
 
-    // Set stream curPos.
-    m_curPos = static_cast<std::size_t>(lcurPos.QuadPart);
+    // Write all of the buffered data to the file in as few writes as possible.
+    in_handle_jump_to(m_writeBufPos);
 
-    // Throw an exception if we encountered an error.
-    if (!succeeded)
+    while (size)
     {
-        throw in_win32_get_last_exception();
+        const auto writtenBytes = in_handle_write(size, data);
+        if (!writtenBytes)
+        {
+            throw unknown_exception();
+        }
+
+        data += writtenBytes;
+        size -= writtenBytes;
     }
-#else
-    // Jump to the given position.
-    const auto curPos = lseek(static_cast<int>(m_handle),
-        static_cast<off_t>(pos), SEEK_SET);
+}
 
-    // Throw an exception if we encountered an error.
-    if (curPos == static_cast<off_t>(-1))
+std::size_t file_stream::in_fill_read_buf()
+{
+    // Write any buffered data first so it can be read back.
+    in_flush_write_buf();
+
+    // Allocate the read buffer if necessary.
+    if (!m_readBuf)
     {
-        throw in_posix_get_last_exception();
+        m_readBuf = std::unique_ptr<u8[]>(new u8[in_read_buf_size]);
+    }
+
+    // Mark the read buffer as empty up-front, so that if
+    // reading fails, we don't keep any stale data around.
+    m_readBufPos = m_curPos;
+    m_readBufLen = 0;
+
+    // Read as much data as we can into the read buffer.
+    in_handle_jump_to(m_curPos);
+    m_readBufLen = in_handle_read(in_read_buf_size, m_readBuf.get());
+
+    return m_readBufLen;
+}
+
+bool file_stream::in_get_read_buf(const void*& data, std::size_t& size)
+{
+    // Fill the read buffer if the current position isn't within it.
+    if (m_curPos < m_readBufPos || m_curPos >= (m_readBufPos + m_readBufLen))
+    {
+        in_fill_read_buf();
+    }
+
+    data = (m_readBuf.get() + (m_curPos - m_readBufPos));
+    size = ((m_readBufPos + m_readBufLen) - m_curPos);
+    return true;
+}
+
+std::size_t file_stream::read(std::size_t size, void* buf)
+{
+    const auto bytes = static_cast<u8*>(buf);
+    std::size_t readBytes = 0;
+
+    // Copy as much of the requested data as we can from the read buffer.
+    if (m_curPos >= m_readBufPos && m_curPos < (m_readBufPos + m_readBufLen))
+    {
+        const auto bufOff = (m_curPos - m_readBufPos);
+        readBytes = std::min(size, m_readBufLen - bufOff);
+
+        std::memcpy(bytes, m_readBuf.get() + bufOff, readBytes);
+        m_curPos += readBytes;
+
+        if (readBytes == size) return readBytes;
+    }
+
+    // Read small amounts of data through the read buffer.
+    const auto remainingBytes = (size - readBytes);
+    if (remainingBytes < in_read_buf_size)
+    {
+        const auto count = std::min(remainingBytes, in_fill_read_buf());
+        std::memcpy(bytes + readBytes, m_readBuf.get(), count);
+
+        m_curPos += count;
+        return (readBytes + count);
+    }
+
+    // Write any buffered data first so it can be read back.
+    in_flush_write_buf();
+
+    // Read large amounts of data directly from the file.
+    in_handle_jump_to(m_curPos);
+
+    const auto directReadBytes = in_handle_read(remainingBytes, bytes + readBytes);
+    m_curPos += directReadBytes;
+
+    return (readBytes + directReadBytes);
+}
+
+std::size_t file_stream::write(std::size_t size, const void* buf)
+{
+    const auto bytes = static_cast<const u8*>(buf);
+    std::size_t writtenBytes = 0;
+
+    // Discard the read buffer, as it may no longer match the file's contents.
+    m_readBufLen = 0;
+
+    while (writtenBytes < size)
+    {
+        // If the current position isn't within (or directly after) the write buffer's
+        // data, or the write buffer is full, start a new write buffer at this position.
+        if (m_curPos < m_writeBufPos || m_curPos > (m_writeBufPos + m_writeBufLen) ||
+            (m_curPos - m_writeBufPos) == in_write_buf_size)
+        {
+            in_flush_write_buf();
+            m_writeBufPos = m_curPos;
+
+            // Write large amounts of data directly to the file, without buffering them.
+            const auto remainingBytes = (size - writtenBytes);
+            if (remainingBytes >= in_write_buf_size)
+            {
+                in_handle_jump_to(m_curPos);
+
+                const auto directWrittenBytes = in_handle_write(
+                    remainingBytes, bytes + writtenBytes);
+
+                m_curPos += directWrittenBytes;
+                return (writtenBytes + directWrittenBytes);
+            }
+        }
+
+        // Allocate the write buffer if necessary.
+        if (!m_writeBuf)
+        {
+            m_writeBuf = std::unique_ptr<u8[]>(new u8[in_write_buf_size]);
+        }
+
+        // Copy as much of the data as we can into the write buffer.
+        const auto bufOff = (m_curPos - m_writeBufPos);
+        const auto count = std::min(size - writtenBytes,
+            in_write_buf_size - bufOff);
+
+        std::memcpy(m_writeBuf.get() + bufOff, bytes + writtenBytes, count);
+
+        m_writeBufLen = std::max(m_writeBufLen, bufOff + count);
+        m_curPos += count;
+        writtenBytes += count;
+    }
+
+    return writtenBytes;
+}
+
+std::size_t file_stream::read_at(std::size_t pos, std::size_t size, void* buf)
+{
+    // Read the data from the file itself.
+    // NOTE: This doesn't use or modify any of the stream's state, so that
+    // multiple threads can safely read from the same stream at once.
+    auto readBytes = in_handle_read_at(pos, size, buf);
+
+    // Account for any buffered data which hasn't been written to the file yet.
+    const auto writeBufEnd = (m_writeBufPos + m_writeBufLen);
+    if (m_writeBufLen && pos < writeBufEnd)
+    {
+        const auto end = std::min(pos + size, writeBufEnd);
+        const auto begin = std::min(std::max(pos, m_writeBufPos), end);
+        const auto bytes = static_cast<u8*>(buf);
+
+        // Anything between the end of the file and the buffered data
+        // reads as nulls, just like it will once the data is written.
+        if (readBytes < (begin - pos))
+        {
+            std::memset(bytes + readBytes, 0, (begin - pos) - readBytes);
+        }
+
+        // Copy the buffered data over top of the data we read.
+        std::memcpy(bytes + (begin - pos), m_writeBuf.get() +
+            (begin - m_writeBufPos), end - begin);
+
+        readBytes = std::max(readBytes, end - pos);
+    }
+
+    return readBytes;
+}
+
+std::size_t file_stream::write_at(std::size_t pos, std::size_t size, const void* buf)
+{
+    // Discard the read buffer, as it may no longer match the file's contents.
+    m_readBufLen = 0;
+
+    // If the data only overwrites data which is still in the write buffer,
+    // just copy it into the write buffer.
+    const auto writeBufEnd = (m_writeBufPos + m_writeBufLen);
+    if (m_writeBufLen && pos >= m_writeBufPos && (pos + size) <= writeBufEnd)
+    {
+        std::memcpy(m_writeBuf.get() + (pos - m_writeBufPos), buf, size);
+        return size;
+    }
+
+    // Otherwise, if it overlaps any buffered data, write the buffered data
+    // first so that it won't overwrite the new data once it gets written.
+    if (m_writeBufLen && pos < writeBufEnd && (pos + size) > m_writeBufPos)
+    {
+        in_flush_write_buf();
+    }
+
+    // Write the data directly to the file.
+    return in_handle_write_at(pos, size, buf);
+}
+
+void file_stream::seek(seek_mode mode, long long offset)
+{
+    // NOTE: The OS' file pointer is only actually moved once we read or write
+    // data, so seeking around within the write buffer doesn't cost anything.
+    long long basePos;
+    switch (mode)
+    {
+    default:
+    case seek_mode::beg:
+        basePos = 0;
+        break;
+
+    case seek_mode::cur:
+        basePos = static_cast<long long>(m_curPos);
+        break;
+
+    case seek_mode::end:
+        basePos = static_cast<long long>(get_size());
+        break;
+    }
+
+    // Ensure we aren't seeking to before the beginning of the file.
+    if (offset < -basePos)
+    {
+        throw out_of_range_exception();
     }
 
     // Set stream curPos.
-    m_curPos = static_cast<std::size_t>(curPos);
-#endif
+    m_curPos = static_cast<std::size_t>(basePos + offset);
+}
+
+void file_stream::jump_to(std::size_t pos)
+{
+    // NOTE: The OS' file pointer is only actually moved once we read or write
+    // data, so jumping around within the write buffer doesn't cost anything.
+    m_curPos = pos;
 }
 
 void file_stream::flush()
 {
+    // Write any buffered data to the file.
+    in_flush_write_buf();
+
     // Flush the given file stream and return whether flushing was successful or not.
 #ifdef _WIN32
     if (!FlushFileBuffers(reinterpret_cast<HANDLE>(m_handle)))
@@ -291,23 +551,32 @@ std::size_t file_stream::get_size()
         throw in_win32_get_last_exception();
     }
 
-    // Return the file's size.
-    return static_cast<std::size_t>(size.QuadPart);
+    const auto fileSize = static_cast<std::size_t>(size.QuadPart);
 #else
     struct stat st;
     if (fstat(static_cast<int>(m_handle), &st))
     {
         throw in_posix_get_last_exception();
     }
-    
-    // Return the file's size.
-    return static_cast<std::size_t>(st.st_size);
+
+    const auto fileSize = static_cast<std::size_t>(st.st_size);
 #endif
+
+    // Account for any buffered data which would extend the file once written.
+    return (m_writeBufLen) ? std::max(fileSize,
+        m_writeBufPos + m_writeBufLen) : fileSize;
 }
 
 file_stream::~file_stream()
 {
-    close();
+    // NOTE: Destructors can't throw, so any errors encountered while writing
+    // buffered data here are ignored. Call close() or flush() beforehand
+    // to be able to catch them!
+    try
+    {
+        close();
+    }
+    catch (...) {}
 }
 
 #ifdef _WIN32
@@ -435,6 +704,11 @@ void file_stream::in_open(const nchar* filePath, file::mode mode)
     // Setup stream.
     m_handle = (std::uintmax_t)fileHandle;
     m_curPos = 0;
+    m_writeBufPos = 0;
+    m_writeBufLen = 0;
+    m_readBufPos = 0;
+    m_readBufLen = 0;
+    m_handlePos = 0;
 }
 
 void file_stream::close()
@@ -442,14 +716,35 @@ void file_stream::close()
     // Return early if file is already closed.
     if (!m_handle) return;
 
+    // Write any remaining buffered data to the file.
+    try
+    {
+        in_flush_write_buf();
+    }
+    catch (...)
+    {
+        // Close the file anyway so it isn't leaked, then report the error.
+#ifdef _WIN32
+        CloseHandle(reinterpret_cast<HANDLE>(m_handle));
+#else
+        ::close(static_cast<int>(m_handle));
+#endif
+
+        m_handle = 0;
+        throw;
+    }
+
     // Close file.
+    const auto handle = m_handle;
+    m_handle = 0;
+
 #ifdef _WIN32
-    if (!CloseHandle(reinterpret_cast<HANDLE>(m_handle)))
+    if (!CloseHandle(reinterpret_cast<HANDLE>(handle)))
     {
         throw in_win32_get_last_exception();
     }
 #else
-    if (::close(static_cast<int>(m_handle)) != 0)
+    if (::close(static_cast<int>(handle)) != 0)
     {
         throw in_posix_get_last_exception();
     }
@@ -464,4 +759,99 @@ void file_stream::reopen(const nchar* filePath, file::mode mode)
     // Open the new file as requested.
     in_open(filePath, mode);
 }
+
+void mapped_file::in_open(const nchar* filePath)
+{
+#ifndef _WIN32
+    // Open file at the given path.
+    const int fileHandle = ::open(filePath, O_RDONLY);
+    if (fileHandle == -1)
+    {
+        throw in_posix_get_last_exception(filePath);
+    }
+
+    // Get the file's size.
+    struct stat st;
+    if (fstat(fileHandle, &st))
+    {
+        const auto ex = in_posix_get_last_exception();
+        ::close(fileHandle);
+        throw ex;
+    }
+
+    m_size = static_cast<std::size_t>(st.st_size);
+
+    // Map the file into memory, if it isn't empty.
+    // NOTE: We use a private mapping so the data can be modified in-place
+    // (e.g. when fixing offsets) without the changes being written to the file.
+    if (m_size)
+    {
+        void* data = mmap(nullptr, m_size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE, fileHandle, 0);
+
+        if (data != MAP_FAILED)
+        {
+            m_data = data;
+            m_isMapped = true;
+        }
+    }
+
+    // NOTE: The mapping remains valid after the file is closed.
+    ::close(fileHandle);
+
+    // Return if we were able to map the file.
+    if (m_isMapped || !m_size) return;
+#endif
+
+    // Fallback to reading the file into a heap buffer.
+    std::unique_ptr<u8[]> data = file::load(filePath, &m_size);
+    m_data = data.release();
+}
+
+void mapped_file::in_close() noexcept
+{
+    // Free data.
+#ifndef _WIN32
+    if (m_isMapped)
+    {
+        munmap(m_data, m_size);
+    }
+    else
+#endif
+    {
+        delete[] static_cast<u8*>(m_data);
+    }
+
+    // Reset values.
+    m_data = nullptr;
+    m_size = 0;
+    m_isMapped = false;
+}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+{
+    if (&other != this)
+    {
+        in_close();
+
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_isMapped = other.m_isMapped;
+
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_isMapped = false;
+    }
+
+    return *this;
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept :
+    m_data(other.m_data), m_size(other.m_size),
+    m_isMapped(other.m_isMapped)
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_isMapped = false;
+}
 } // hl
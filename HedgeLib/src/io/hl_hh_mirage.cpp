@@ -365,14 +365,14 @@ void fix(void* rawData)
 
 void offsets_fix(off_table_handle offsets, void* base)
 {
-    // Fix all the offsets in the offset table.
-    for (auto& relOffPos : offsets)
-    {
-        // Endian swap offset position if necessary.
+    // Endian swap offset positions if necessary.
 #ifndef HL_IS_BIG_ENDIAN
-        hl::endian_swap(relOffPos);
+    endian_swap_arr(offsets.off_count(), offsets.off_table());
 #endif
 
+    // Fix all the offsets in the offset table.
+    for (const auto relOffPos : offsets)
+    {
         // Get pointer to current offset.
         off32<void>* curOff = ptradd<off32<void>>(base, relOffPos);
 
@@ -389,19 +389,22 @@ void offsets_fix(off_table_handle offsets, void* base)
 void offsets_write_no_sort(std::size_t basePos,
     const off_table& offTable, stream& stream)
 {
+    // Get relative offset positions.
+    std::vector<u32> relOffPositions;
+    relOffPositions.reserve(offTable.size());
+
     for (std::size_t offPos : offTable)
     {
-        // Get relative offset position.
-        u32 relOffPos = static_cast<u32>(offPos - basePos);
+        relOffPositions.push_back(static_cast<u32>(offPos - basePos));
+    }
 
-        // Endian-swap relative offset position if necessary.
+    // Endian-swap relative offset positions if necessary.
 #ifndef HL_IS_BIG_ENDIAN
-        endian_swap(relOffPos);
+    endian_swap_arr(relOffPositions.size(), relOffPositions.data());
 #endif
 
-        // Write relative offset position.
-        stream.write_obj(relOffPos);
-    }
+    // Write relative offset positions.
+    stream.write_arr(relOffPositions.size(), relOffPositions.data());
 }
 
 void offsets_write(std::size_t basePos,
@@ -0,0 +1,467 @@
+#ifndef HL_IN_JSON_WRITER_H_INCLUDED
+#define HL_IN_JSON_WRITER_H_INCLUDED
+
+#include "hedgelib/io/hl_stream.h"
+#include "hedgelib/hl_internal.h"
+#include <rapidjson/internal/dtoa.h>
+#include <rapidjson/internal/itoa.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstring>
+
+namespace hl
+{
+namespace internal
+{
+/**
+ * @brief Fast pretty-printing JSON writer.
+ *
+ * Serializes directly into a large per-thread output buffer which is reused
+ * across writes and only flushed to the given stream once it fills up (or
+ * once the root value has been closed).
+ *
+ * The output is byte-for-byte identical to what a RapidJSON PrettyWriter with
+ * an indentation of two spaces would produce for the same calls (including
+ * RapidJSON's kFormatSingleLineArray option), and NaN or Infinity double
+ * values are written as 0.0 rather than failing.
+ */
+class in_json_writer
+{
+    constexpr static std::size_t in_buf_size = 1048576U;    // 1 MB
+
+    struct in_buffer
+    {
+        std::unique_ptr<char[]> data;
+        bool isInUse = false;
+    };
+
+    struct in_level
+    {
+        std::size_t valueCount = 0;
+        bool inArray;
+
+        in_level(bool inArray) noexcept :
+            inArray(inArray) {}
+    };
+
+    constexpr static char in_escape_table[256] =
+    {
+        // 0x00 - 0x1F: Control characters.
+        'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+        'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+
+        // 0x20 - 0x2F: Double quotes.
+        0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+
+        // 0x30 - 0x5F: Backslash.
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0
+
+        // 0x60 - 0xFF: Implicitly zero.
+    };
+
+    in_buffer* m_ownedBuf = nullptr;
+    std::unique_ptr<char[]> m_privateBuf;
+    stream* m_stream;
+    char* m_bufBegin;
+    char* m_curChar;
+    char* m_bufEnd;
+    std::vector<in_level> m_levels;
+    bool m_singleLineArrays = false;
+
+    static in_buffer& in_get_thread_local_buffer()
+    {
+        thread_local in_buffer buffer;
+        return buffer;
+    }
+
+    inline void in_reserve(std::size_t count)
+    {
+        if (static_cast<std::size_t>(m_bufEnd - m_curChar) < count)
+        {
+            flush();
+        }
+    }
+
+    inline void in_put(char c)
+    {
+        in_reserve(1);
+        *m_curChar++ = c;
+    }
+
+    void in_put_n(const char* data, std::size_t count)
+    {
+        // Copy as much data as we can, flushing the buffer whenever it fills up.
+        auto freeByteCount = static_cast<std::size_t>(m_bufEnd - m_curChar);
+        while (count > freeByteCount)
+        {
+            std::memcpy(m_curChar, data, freeByteCount);
+            m_curChar += freeByteCount;
+            data += freeByteCount;
+            count -= freeByteCount;
+
+            flush();
+            freeByteCount = in_buf_size;
+        }
+
+        std::memcpy(m_curChar, data, count);
+        m_curChar += count;
+    }
+
+    void in_put_indent(std::size_t depth)
+    {
+        auto count = (depth * 2);
+        auto freeByteCount = static_cast<std::size_t>(m_bufEnd - m_curChar);
+
+        while (count > freeByteCount)
+        {
+            std::memset(m_curChar, ' ', freeByteCount);
+            m_curChar += freeByteCount;
+            count -= freeByteCount;
+
+            flush();
+            freeByteCount = in_buf_size;
+        }
+
+        std::memset(m_curChar, ' ', count);
+        m_curChar += count;
+    }
+
+    static const char* in_find_escape(const char* cur, const char* end) noexcept
+    {
+#ifdef HL_IN_HAS_SSE2
+        // Check 16 characters at a time for quotes, backslashes,
+        // and control characters (anything <= 0x1F) using SSE2 intrinsics.
+        const __m128i quotes = _mm_set1_epi8('"');
+        const __m128i backslashes = _mm_set1_epi8('\\');
+        const __m128i controlMax = _mm_set1_epi8(0x1F);
+
+        while ((end - cur) >= 16)
+        {
+            const __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(cur));
+
+            const __m128i needsEscape = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, quotes),
+                    _mm_cmpeq_epi8(v, backslashes)),
+                _mm_cmpeq_epi8(_mm_max_epu8(v, controlMax), controlMax));
+
+            const auto bitmask = static_cast<unsigned int>(
+                _mm_movemask_epi8(needsEscape));
+
+            if (bitmask)
+            {
+                return (cur + bit_ctz(bitmask));
+            }
+
+            cur += 16;
+        }
+#endif
+
+        // Check any remaining characters one at a time.
+        while (cur < end && !in_escape_table[static_cast<unsigned char>(*cur)])
+        {
+            ++cur;
+        }
+
+        return cur;
+    }
+
+    void in_put_escaped(const char* str, std::size_t len)
+    {
+        const char* end = (str + len);
+        in_put('"');
+
+        while (true)
+        {
+            // Copy every character up until the next one that needs escaping as-is.
+            const char* escapeChar = in_find_escape(str, end);
+            in_put_n(str, static_cast<std::size_t>(escapeChar - str));
+
+            if (escapeChar == end) break;
+
+            // Write escape sequence.
+            const auto c = static_cast<unsigned char>(*escapeChar);
+            const char escape = in_escape_table[c];
+
+            if (escape == 'u')
+            {
+                static const char hexDigits[] = "0123456789ABCDEF";
+
+                in_reserve(6);
+                m_curChar[0] = '\\';
+                m_curChar[1] = 'u';
+                m_curChar[2] = '0';
+                m_curChar[3] = '0';
+                m_curChar[4] = hexDigits[c >> 4];
+                m_curChar[5] = hexDigits[c & 0xF];
+                m_curChar += 6;
+            }
+            else
+            {
+                in_reserve(2);
+                m_curChar[0] = '\\';
+                m_curChar[1] = escape;
+                m_curChar += 2;
+            }
+
+            str = (escapeChar + 1);
+        }
+
+        in_put('"');
+    }
+
+    void in_prefix()
+    {
+        if (m_levels.empty()) return;
+
+        auto& level = m_levels.back();
+        if (level.inArray)
+        {
+            if (level.valueCount > 0)
+            {
+                if (m_singleLineArrays)
+                {
+                    in_reserve(2);
+                    m_curChar[0] = ',';
+                    m_curChar[1] = ' ';
+                    m_curChar += 2;
+                }
+                else
+                {
+                    in_put(',');
+                }
+            }
+
+            if (!m_singleLineArrays)
+            {
+                in_put('\n');
+                in_put_indent(m_levels.size());
+            }
+        }
+        else
+        {
+            // Object values alternate between keys (even) and values (odd).
+            if (level.valueCount & 1)
+            {
+                in_reserve(2);
+                m_curChar[0] = ':';
+                m_curChar[1] = ' ';
+                m_curChar += 2;
+            }
+            else
+            {
+                if (level.valueCount > 0)
+                {
+                    in_put(',');
+                }
+
+                in_put('\n');
+                in_put_indent(m_levels.size());
+            }
+        }
+
+        ++level.valueCount;
+    }
+
+    void in_end_value()
+    {
+        // Flush once the root value has been completely written, like RapidJSON does.
+        if (m_levels.empty())
+        {
+            flush();
+        }
+    }
+
+public:
+    inline void set_single_line_arrays(bool singleLineArrays) noexcept
+    {
+        m_singleLineArrays = singleLineArrays;
+    }
+
+    void flush()
+    {
+        if (m_curChar == m_bufBegin) return;
+
+        m_stream->write_all(static_cast<std::size_t>(
+            m_curChar - m_bufBegin), m_bufBegin);
+
+        m_curChar = m_bufBegin;
+    }
+
+    void start_object()
+    {
+        in_prefix();
+        in_put('{');
+        m_levels.emplace_back(false);
+    }
+
+    void end_object()
+    {
+        const bool isEmpty = (m_levels.back().valueCount == 0);
+        m_levels.pop_back();
+
+        if (!isEmpty)
+        {
+            in_put('\n');
+            in_put_indent(m_levels.size());
+        }
+
+        in_put('}');
+        in_end_value();
+    }
+
+    void start_array()
+    {
+        in_prefix();
+        in_put('[');
+        m_levels.emplace_back(true);
+    }
+
+    void end_array()
+    {
+        const bool isEmpty = (m_levels.back().valueCount == 0);
+        m_levels.pop_back();
+
+        if (!isEmpty && !m_singleLineArrays)
+        {
+            in_put('\n');
+            in_put_indent(m_levels.size());
+        }
+
+        in_put(']');
+        in_end_value();
+    }
+
+    inline void key(const char* str, std::size_t len)
+    {
+        string(str, len);
+    }
+
+    inline void key(const char* str)
+    {
+        string(str, std::strlen(str));
+    }
+
+    inline void key(const std::string& str)
+    {
+        string(str.c_str(), str.size());
+    }
+
+    void string(const char* str, std::size_t len)
+    {
+        in_prefix();
+        in_put_escaped(str, len);
+        in_end_value();
+    }
+
+    inline void string(const char* str)
+    {
+        string(str, std::strlen(str));
+    }
+
+    inline void string(const std::string& str)
+    {
+        string(str.c_str(), str.size());
+    }
+
+    void boolean(bool v)
+    {
+        in_prefix();
+        if (v)
+        {
+            in_put_n("true", 4);
+        }
+        else
+        {
+            in_put_n("false", 5);
+        }
+
+        in_end_value();
+    }
+
+    void int64(s64 v)
+    {
+        in_prefix();
+        in_reserve(21);
+        m_curChar = rapidjson::internal::i64toa(v, m_curChar);
+
+        in_end_value();
+    }
+
+    void uint64(u64 v)
+    {
+        in_prefix();
+        in_reserve(20);
+        m_curChar = rapidjson::internal::u64toa(v, m_curChar);
+
+        in_end_value();
+    }
+
+    void uint(u32 v)
+    {
+        in_prefix();
+        in_reserve(10);
+        m_curChar = rapidjson::internal::u32toa(v, m_curChar);
+
+        in_end_value();
+    }
+
+    void floating(double v)
+    {
+        // NOTE: We use the same Grisu2-based shortest round-trip formatter
+        // RapidJSON uses so the output stays identical to what it'd write.
+        in_prefix();
+        in_reserve(25);
+        m_curChar = rapidjson::internal::dtoa(
+            std::isfinite(v) ? v : 0.0, m_curChar);
+
+        in_end_value();
+    }
+
+    in_json_writer(stream& stream) :
+        m_stream(&stream)
+    {
+        // Use the per-thread buffer if it isn't already being used by another
+        // writer further up the call stack; otherwise, allocate our own.
+        auto& buffer = in_get_thread_local_buffer();
+        if (!buffer.isInUse)
+        {
+            if (!buffer.data)
+            {
+                buffer.data = std::unique_ptr<char[]>(new char[in_buf_size]);
+            }
+
+            buffer.isInUse = true;
+            m_ownedBuf = &buffer;
+            m_bufBegin = buffer.data.get();
+        }
+        else
+        {
+            m_privateBuf = std::unique_ptr<char[]>(new char[in_buf_size]);
+            m_bufBegin = m_privateBuf.get();
+        }
+
+        m_curChar = m_bufBegin;
+        m_bufEnd = (m_bufBegin + in_buf_size);
+        m_levels.reserve(16);
+    }
+
+    in_json_writer(const in_json_writer& other) = delete;
+    in_json_writer& operator=(const in_json_writer& other) = delete;
+
+    ~in_json_writer()
+    {
+        if (m_ownedBuf)
+        {
+            m_ownedBuf->isInUse = false;
+        }
+    }
+};
+} // internal
+} // hl
+
+#endif
@@ -4,7 +4,6 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 // TODO: Support SIMD intrinsics!!!
 #include <rapidjson/reader.h>
-#include <rapidjson/prettywriter.h>
 
 namespace hl
 {
@@ -118,174 +117,6 @@ public:
     }
 };
 
-class in_rapidjson_output_stream_wrapper
-{
-    constexpr static std::size_t in_max_buf_size = 10000U;  // 10 KB
-
-    stream*                                             m_stream;
-    char*                                               m_curChar;
-    char                                                m_buffer[in_max_buf_size];
-
-public:
-    using Ch = char;
-
-    void Put(Ch c)
-    {
-        *m_curChar = c;
-        if (++m_curChar == std::end(m_buffer))
-        {
-            Flush();
-        }
-    }
-
-    void PutN(Ch c, size_t n)
-    {
-        // NOTE: Based heavily on the FileWriteStream::PutN function from RapidJSON.
-
-        // Write and flush as many times as necessary until we have enough space
-        // left in the buffer to contain the rest of the characters we want to put.
-        auto freeByteCount = static_cast<std::size_t>(std::end(m_buffer) - m_curChar);
-        while (n > freeByteCount)
-        {
-            std::memset(m_curChar, c, freeByteCount);
-            m_curChar += freeByteCount;
-            Flush();
-            n -= freeByteCount;
-            freeByteCount = in_max_buf_size;
-        }
-
-        // Write any remaining characters to the buffer.
-        if (n > 0)
-        {
-            std::memset(m_curChar, c, n);
-            m_curChar += n;
-
-            if (m_curChar == std::end(m_buffer))
-            {
-                Flush();
-            }
-        }
-    }
-
-    inline void Flush()
-    {
-        if (m_curChar == m_buffer) return;
-        
-        const auto byteCount = static_cast<std::size_t>(m_curChar - m_buffer);
-        m_stream->write_all(byteCount, m_buffer);
-        m_curChar = m_buffer;
-    }
-
-    inline Ch* PutBegin()
-    {
-        throw unsupported_exception();
-    }
-
-    inline size_t PutEnd(Ch*)
-    {
-        throw unsupported_exception();
-    }
-
-    in_rapidjson_output_stream_wrapper(stream& stream) :
-        m_stream(&stream),
-        m_curChar(m_buffer) {}
-};
-
-/**
- * @brief Convenience wrapper around RapidJSON PrettyWriter.
- * 
- * Uses HedgeLib output stream wrapper as default stream type and
- * replaces all functions that can actually fail and return false
- * on failure with wrapper functions that throw exceptions or
- * handle the error internally in a different way (such as writing
- * 0.0 instead of failing with NaN or Infinity double values) instead
- * so you don't have to check the return values.
- * 
- * NOTE: There are several RapidJSON PrettyWriter functions that theoretically
- * can return false on failure, but whose implementations NEVER actually
- * return false. As such, these functions currently are not wrapped, but
- * you still don't actually have to check their return values.
- */
-class in_rapidjson_writer : public rapidjson::PrettyWriter<in_rapidjson_output_stream_wrapper>
-{
-public:
-    inline void Double(double d)
-    {
-        PrettyWriter::Double((rapidjson::internal::Double(d).IsNanOrInf()) ?
-            0.0 : d);
-    }
-
-    inline void RawNumber(const Ch* str, rapidjson::SizeType length, bool copy = false)
-    {
-        if (!PrettyWriter::RawNumber(str, length, copy))
-        {
-            throw std::runtime_error("Failed to serialize JSON raw number");
-        }
-    }
-
-    inline void String(const Ch* str, rapidjson::SizeType length, bool copy = false)
-    {
-        if (!PrettyWriter::String(str, length, copy))
-        {
-            throw std::runtime_error("Failed to serialize JSON string");
-        }
-    }
-
-    inline void String(const std::basic_string<Ch>& str)
-    {
-        if (!PrettyWriter::String(str))
-        {
-            throw std::runtime_error("Failed to serialize JSON string");
-        }
-    }
-
-    inline void String(const Ch* const& str)
-    {
-        if (!PrettyWriter::String(str))
-        {
-            throw std::runtime_error("Failed to serialize JSON string");
-        }
-    }
-
-    inline void Key(const Ch* str, rapidjson::SizeType length, bool copy = false)
-    {
-        if (!PrettyWriter::Key(str, length, copy))
-        {
-            throw std::runtime_error("Failed to serialize JSON key");
-        }
-    }
-
-    inline void Key(const std::basic_string<Ch>& str)
-    {
-        if (!PrettyWriter::Key(str))
-        {
-            throw std::runtime_error("Failed to serialize JSON key");
-        }
-    }
-
-    inline void Key(const Ch* const& str)
-    {
-        if (!PrettyWriter::Key(str))
-        {
-            throw std::runtime_error("Failed to serialize JSON key");
-        }
-    }
-
-    inline void RawValue(const Ch* json, size_t length, rapidjson::Type type)
-    {
-        if (!PrettyWriter::RawValue(json, length, type))
-        {
-            throw std::runtime_error("Failed to serialize JSON raw value");
-        }
-    }
-
-    in_rapidjson_writer(in_rapidjson_output_stream_wrapper& stream) :
-        PrettyWriter(stream)
-    {
-        indentCharCount_ = 2;
-    }
-};
-
 template<typename HandlerType>
 void in_parse_json(HandlerType& handler, const void* rawData, std::size_t rawDataSize)
 {
@@ -335,14 +166,3 @@ inline void in_load_json(HandlerType& handler, const nstring& filePath)
 }
 } // internal
 } // hl
-
-namespace rapidjson
-{
-template<>
-inline void PutN(
-    hl::internal::in_rapidjson_output_stream_wrapper& stream,
-    char c, size_t n)
-{
-    stream.PutN(c, n);
-}
-} // rapidjson
@@ -4,6 +4,13 @@
 
 namespace hl
 {
+bool readonly_mem_stream::in_get_read_buf(const void*& data, std::size_t& size)
+{
+    data = (m_handle + m_curPos);
+    size = (m_dataSize - m_curPos);
+    return true;
+}
+
 std::size_t readonly_mem_stream::read(std::size_t size, void* buf)
 {
     // Get current data pointer and determine how many bytes we can safely read.
@@ -96,6 +103,27 @@ std::size_t readonly_mem_stream::get_size()
     return m_dataSize;
 }
 
+std::size_t readonly_mem_stream::read_at(std::size_t pos, std::size_t size, void* buf)
+{
+    // Ensure this position is contained within the data buffer.
+    if (pos > m_dataSize)
+    {
+        throw out_of_range_exception();
+    }
+
+    // Copy as many bytes as we safely can into the given buffer.
+    const std::size_t readBytes = std::min(size, m_dataSize - pos);
+    std::memcpy(buf, m_handle + pos, readBytes);
+
+    // Return read byte count.
+    return readBytes;
+}
+
+std::size_t readonly_mem_stream::write_at(std::size_t pos, std::size_t size, const void* buf)
+{
+    throw unsupported_exception();
+}
+
 readonly_mem_stream::~readonly_mem_stream() {}
 
 void mem_stream::in_grow(std::size_t reqCap)
@@ -152,6 +180,33 @@ std::size_t mem_stream::write(std::size_t size, const void* buf)
     return size;
 }
 
+std::size_t mem_stream::write_at(std::size_t pos, std::size_t size, const void* buf)
+{
+    // Ensure this position is contained within the data buffer.
+    if (pos > m_dataSize)
+    {
+        throw out_of_range_exception();
+    }
+
+    // Enlarge data buffer if necessary.
+    if (size > (m_dataCap - pos))
+    {
+        in_grow(pos + size);
+    }
+
+    // Copy data into buffer.
+    std::memcpy(const_cast<u8*>(m_handle) + pos, buf, size);
+
+    // Increase stream buffer size if necessary.
+    if ((pos + size) > m_dataSize)
+    {
+        m_dataSize = (pos + size);
+    }
+
+    // Return written byte count.
+    return size;
+}
+
 mem_stream::~mem_stream()
 {
     close();
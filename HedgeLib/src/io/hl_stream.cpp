@@ -1,5 +1,6 @@
 #include "hedgelib/io/hl_stream.h"
 #include <memory>
+#include <cstring>
 
 namespace hl
 {
@@ -25,6 +26,68 @@ void stream::write_all(std::size_t size, const void* buf)
     }
 }
 
+std::size_t stream::read_at(std::size_t pos, std::size_t size, void* buf)
+{
+    // Jump to the given position, read the data, and jump back.
+    const std::size_t prevPos = m_curPos;
+    jump_to(pos);
+
+    std::size_t readByteCount;
+    try
+    {
+        readByteCount = read(size, buf);
+    }
+    catch (...)
+    {
+        jump_to(prevPos);
+        throw;
+    }
+
+    jump_to(prevPos);
+    return readByteCount;
+}
+
+std::size_t stream::write_at(std::size_t pos, std::size_t size, const void* buf)
+{
+    // Jump to the given position, write the data, and jump back.
+    const std::size_t prevPos = m_curPos;
+    jump_to(pos);
+
+    std::size_t writtenByteCount;
+    try
+    {
+        writtenByteCount = write(size, buf);
+    }
+    catch (...)
+    {
+        jump_to(prevPos);
+        throw;
+    }
+
+    jump_to(prevPos);
+    return writtenByteCount;
+}
+
+void stream::read_all_at(std::size_t pos, std::size_t size, void* buf)
+{
+    const std::size_t readByteCount = read_at(pos, size, buf);
+    if (readByteCount != size)
+    {
+        // TODO: Throw a better error?
+        throw unknown_exception();
+    }
+}
+
+void stream::write_all_at(std::size_t pos, std::size_t size, const void* buf)
+{
+    const std::size_t writtenByteCount = write_at(pos, size, buf);
+    if (writtenByteCount != size)
+    {
+        // TODO: Throw a better error?
+        throw unknown_exception();
+    }
+}
+
 static const u8 in_stream_nulls_static_buffer[1024] = {};
 
 void stream::write_nulls(std::size_t amount)
@@ -112,15 +175,67 @@ void stream::fix_off64(std::size_t basePos, std::size_t offPos,
     jump_to(endPos);
 }
 
+bool stream::in_get_read_buf(const void*& data, std::size_t& size)
+{
+    return false;
+}
+
 bool stream::read_str(std::size_t bufSize, char* buf)
 {
     constexpr std::size_t tmpBufSize = 20;
     char tmpBuf[tmpBufSize];
+    const void* data;
+    std::size_t size;
 
     // Return early if bufSize == 0
     if (!bufSize) return true;
 
-    // Read string into buffer.
+    // If we can read the stream's data directly, just search it for a null terminator.
+    if (in_get_read_buf(data, size))
+    {
+        while (true)
+        {
+            // Append a null terminator and return failure
+            // if we've reached the end of the stream.
+            if (!size)
+            {
+                *buf = '\0';
+                return false;
+            }
+
+            // Copy the string into the buffer and return success if we find a null terminator.
+            const auto safeReadCount = std::min(size, bufSize);
+            const auto nullChar = static_cast<const char*>(
+                std::memchr(data, '\0', safeReadCount));
+
+            if (nullChar)
+            {
+                const auto len = static_cast<std::size_t>(
+                    (nullChar + 1) - static_cast<const char*>(data));
+
+                std::memcpy(buf, data, len);
+                jump_to(m_curPos + len);
+                return true;
+            }
+
+            // Otherwise, copy all of the data into the buffer and continue searching.
+            std::memcpy(buf, data, safeReadCount);
+            jump_to(m_curPos + safeReadCount);
+
+            buf += safeReadCount;
+            bufSize -= safeReadCount;
+
+            // Raise an error if we've exceeded the buffer size.
+            if (!bufSize)
+            {
+                throw out_of_range_exception();
+            }
+
+            in_get_read_buf(data, size);
+        }
+    }
+
+    // Otherwise, read string into buffer.
     while (true)
     {
         const std::size_t readByteCount = read(tmpBufSize, tmpBuf);
@@ -160,10 +275,43 @@ bool stream::read_str(std::size_t bufSize, char* buf)
 
 std::string stream::read_str()
 {
-    constexpr std::size_t tmpBufSize = 20;
+    constexpr std::size_t tmpBufSize = 64;
     std::string str;
     char tmpBuf[tmpBufSize];
+    const void* data;
+    std::size_t size;
+
+    // If we can read the stream's data directly, just search it for a null terminator.
+    if (in_get_read_buf(data, size))
+    {
+        // Return if we've reached the end of the stream.
+        while (size)
+        {
+            const auto chars = static_cast<const char*>(data);
+            const auto nullChar = static_cast<const char*>(
+                std::memchr(chars, '\0', size));
+
+            // Append the string and jump past its null terminator
+            // if we found the null terminator.
+            if (nullChar)
+            {
+                str.append(chars, nullChar);
+                jump_to(m_curPos + static_cast<std::size_t>(
+                    (nullChar + 1) - chars));
+
+                break;
+            }
 
+            // Otherwise, append all of the data and continue searching.
+            str.append(chars, size);
+            jump_to(m_curPos + size);
+            in_get_read_buf(data, size);
+        }
+
+        return str;
+    }
+
+    // Otherwise, read string in chunks.
     while (true)
     {
         const std::size_t readByteCount = read(tmpBufSize, tmpBuf);
@@ -171,20 +319,79 @@ std::string stream::read_str()
         // Return if we've reached the end of the stream.
         if (readByteCount == 0) return str;
 
+        // Jump to end of string and return if we read a null terminator.
+        const auto nullChar = static_cast<const char*>(
+            std::memchr(tmpBuf, '\0', readByteCount));
+
+        if (nullChar)
+        {
+            str.append(tmpBuf, static_cast<std::size_t>(nullChar - tmpBuf));
+            jump_behind(static_cast<long long>(
+                (tmpBuf + readByteCount) - (nullChar + 1)));
+
+            return str;
+        }
+
         // Otherwise, append all of the bytes we just read into the temporary buffer.
-        for (std::size_t i = 0; i < readByteCount; ++i)
+        str.append(tmpBuf, readByteCount);
+    }
+}
+
+void stream::read_strs(std::size_t count, std::string* strs)
+{
+    const void* data;
+    std::size_t size;
+
+    // Fallback to reading strings one at a time if we can't read the stream's data directly.
+    if (!in_get_read_buf(data, size))
+    {
+        for (std::size_t i = 0; i < count; ++i)
         {
-            // Jump to end of string and return if we read a null terminator.
-            if (tmpBuf[i] == '\0')
+            strs[i] = read_str();
+        }
+
+        return;
+    }
+
+    // Otherwise, read as many strings as we can out of the data
+    // before jumping ahead and getting more of it.
+    auto begin = static_cast<const char*>(data);
+    auto cur = begin;
+    auto end = (begin + size);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto& str = strs[i];
+        str.clear();
+
+        // Stop appending if we've reached the end of the stream.
+        while (cur != end)
+        {
+            const auto nullChar = static_cast<const char*>(
+                std::memchr(cur, '\0', static_cast<std::size_t>(end - cur)));
+
+            // Append the string and move past its null terminator
+            // if we found the null terminator.
+            if (nullChar)
             {
-                jump_behind(static_cast<long long>(readByteCount - (i + 1)));
-                return str;
+                str.append(cur, nullChar);
+                cur = (nullChar + 1);
+                break;
             }
 
-            // Append characters.
-            str += tmpBuf[i];
+            // Otherwise, append all of the data and get more of it.
+            str.append(cur, end);
+            jump_to(m_curPos + static_cast<std::size_t>(end - begin));
+            in_get_read_buf(data, size);
+
+            begin = static_cast<const char*>(data);
+            cur = begin;
+            end = (begin + size);
         }
     }
+
+    // Jump past all of the strings we read.
+    jump_to(m_curPos + static_cast<std::size_t>(cur - begin));
 }
 
 void stream::align(std::size_t stride)
@@ -868,6 +868,184 @@ static void in_swap_vertex(const raw_vertex_element& rawVtxElem, void* rawVtx)
     }
 }
 
+static bool in_get_vertex_swap_info(raw_vertex_format format,
+    u32& wordCount, bool& hasHalfWords) noexcept
+{
+    // Get the amount of 32-bit words the given vertex format takes up, and
+    // whether those words are actually made up of two 16-bit values each.
+    hasHalfWords = false;
+
+    switch (format)
+    {
+    case raw_vertex_format::float1:
+    case raw_vertex_format::int1:
+    case raw_vertex_format::int1_norm:
+    case raw_vertex_format::uint1:
+    case raw_vertex_format::uint1_norm:
+    case raw_vertex_format::d3d_color:
+    case raw_vertex_format::udec3:
+    case raw_vertex_format::dec3:
+    case raw_vertex_format::udec3_norm:
+    case raw_vertex_format::dec3_norm:
+    case raw_vertex_format::udec4:
+    case raw_vertex_format::dec4:
+    case raw_vertex_format::udec4_norm:
+    case raw_vertex_format::dec4_norm:
+    case raw_vertex_format::uhend3:
+    case raw_vertex_format::hend3:
+    case raw_vertex_format::uhend3_norm:
+    case raw_vertex_format::hend3_norm:
+    case raw_vertex_format::udhen3:
+    case raw_vertex_format::dhen3:
+    case raw_vertex_format::udhen3_norm:
+    case raw_vertex_format::dhen3_norm:
+    case raw_vertex_format::ubyte4:
+    case raw_vertex_format::byte4:
+    case raw_vertex_format::ubyte4_norm:
+    case raw_vertex_format::byte4_norm:
+        wordCount = 1;
+        return true;
+
+    case raw_vertex_format::float2:
+    case raw_vertex_format::int2:
+    case raw_vertex_format::int2_norm:
+    case raw_vertex_format::uint2:
+    case raw_vertex_format::uint2_norm:
+        wordCount = 2;
+        return true;
+
+    case raw_vertex_format::float3:
+        wordCount = 3;
+        return true;
+
+    case raw_vertex_format::float4:
+    case raw_vertex_format::int4:
+    case raw_vertex_format::int4_norm:
+    case raw_vertex_format::uint4:
+    case raw_vertex_format::uint4_norm:
+        wordCount = 4;
+        return true;
+
+    case raw_vertex_format::short2:
+    case raw_vertex_format::short2_norm:
+    case raw_vertex_format::ushort2:
+    case raw_vertex_format::ushort2_norm:
+    case raw_vertex_format::float16_2:
+        wordCount = 1;
+        hasHalfWords = true;
+        return true;
+
+    case raw_vertex_format::short4:
+    case raw_vertex_format::short4_norm:
+    case raw_vertex_format::ushort4:
+    case raw_vertex_format::ushort4_norm:
+    case raw_vertex_format::float16_4:
+        wordCount = 2;
+        hasHalfWords = true;
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+static bool in_swap_vertices_bulk(const raw_vertex_element* rawVtxElems,
+    std::size_t rawVtxElemCount, u32 vertexSize,
+    u32 vertexCount, void* vertices)
+{
+    // The bulk path requires every vertex to consist entirely of 32-bit words.
+    if ((vertexSize % sizeof(u32)) != 0) return false;
+
+    // Ensure every word within the vertex is covered by exactly one element.
+    const u32 vertexWordCount = (vertexSize / sizeof(u32));
+    std::vector<u8> wordStates(vertexWordCount, 0);
+    u32 coveredWordCount = 0;
+    bool hasHalfWords = false;
+
+    for (std::size_t i = 0; i < rawVtxElemCount; ++i)
+    {
+        const raw_vertex_element& rawVtxElem = rawVtxElems[i];
+        u32 elemWordCount;
+        bool elemHasHalfWords;
+
+        if ((rawVtxElem.offset % sizeof(u32)) != 0 ||
+            !in_get_vertex_swap_info(rawVtxElem.format,
+            elemWordCount, elemHasHalfWords))
+        {
+            return false;
+        }
+
+        const u32 firstWordIndex = (rawVtxElem.offset / sizeof(u32));
+        if ((firstWordIndex + elemWordCount) > vertexWordCount)
+        {
+            return false;
+        }
+
+        for (u32 i2 = firstWordIndex; i2 < (firstWordIndex + elemWordCount); ++i2)
+        {
+            if (wordStates[i2] != 0) return false;
+            wordStates[i2] = (elemHasHalfWords) ? 2 : 1;
+        }
+
+        coveredWordCount += elemWordCount;
+        hasHalfWords |= elemHasHalfWords;
+    }
+
+    if (coveredWordCount != vertexWordCount) return false;
+
+    // Swap every word within the vertex buffer at once.
+    u32* curVtx = static_cast<u32*>(vertices);
+    endian_swap_arr(static_cast<std::size_t>(vertexWordCount) *
+        vertexCount, curVtx);
+
+    // Swap the 16-bit halves of any words which actually contain two
+    // 16-bit values back into their original positions.
+    if (hasHalfWords)
+    {
+        for (u32 i = 0; i < vertexCount; ++i)
+        {
+            for (u32 i2 = 0; i2 < vertexWordCount; ++i2)
+            {
+                if (wordStates[i2] == 2)
+                {
+                    curVtx[i2] = ((curVtx[i2] << 16) | (curVtx[i2] >> 16));
+                }
+            }
+
+            curVtx += vertexWordCount;
+        }
+    }
+
+    return true;
+}
+
+static void in_swap_vertices(const raw_vertex_element* rawVtxElems,
+    std::size_t rawVtxElemCount, u32 vertexSize,
+    u32 vertexCount, void* vertices)
+{
+    // Swap all vertices at once if possible.
+    if (in_swap_vertices_bulk(rawVtxElems, rawVtxElemCount,
+        vertexSize, vertexCount, vertices))
+    {
+        return;
+    }
+
+    // Otherwise, swap vertices one element at a time.
+    for (std::size_t i = 0; i < rawVtxElemCount; ++i)
+    {
+        // Swap vertices based on vertex element.
+        void* curVtx = ptradd(vertices, rawVtxElems[i].offset);
+        for (u32 i2 = 0; i2 < vertexCount; ++i2)
+        {
+            // Swap vertex.
+            in_swap_vertex(rawVtxElems[i], curVtx);
+
+            // Increase vertices pointer.
+            curVtx = ptradd(curVtx, vertexSize);
+        }
+    }
+}
+
 template<typename RawMeshType>
 static void in_swap_recursive(RawMeshType& rawMesh)
 {
@@ -875,10 +1053,7 @@ static void in_swap_recursive(RawMeshType& rawMesh)
     endian_swap<false>(rawMesh);
 
     // Swap faces.
-    for (auto& face : rawMesh.faces)
-    {
-        endian_swap(face);
-    }
+    endian_swap_arr(rawMesh.faces.count, rawMesh.faces.data());
 
     // Swap vertex format (array of vertex elements).
     raw_vertex_element* curVtxElem = rawMesh.vertexElements.get();
@@ -889,31 +1064,17 @@ static void in_swap_recursive(RawMeshType& rawMesh)
     while ((curVtxElem++)->format != raw_vertex_format::last_entry);
 
     // Swap vertices based on vertex format.
-    curVtxElem = rawMesh.vertexElements.get();
-    while (curVtxElem->format != raw_vertex_format::last_entry)
-    {
-        // Swap vertices based on vertex element.
-        void* curVtx = ptradd(rawMesh.vertices.get(), curVtxElem->offset);
-        for (u32 i = 0; i < rawMesh.vertexCount; ++i)
-        {
-            // Swap vertex.
-            in_swap_vertex(*curVtxElem, curVtx);
+    const std::size_t vtxElemCount = static_cast<std::size_t>(
+        (curVtxElem - 1) - rawMesh.vertexElements.get());
 
-            // Increase vertices pointer.
-            curVtx = ptradd(curVtx, rawMesh.vertexSize);
-        }
-
-        // Increase current vertex element pointer.
-        ++curVtxElem;
-    }
+    in_swap_vertices(rawMesh.vertexElements.get(), vtxElemCount,
+        rawMesh.vertexSize, rawMesh.vertexCount, rawMesh.vertices.get());
 
     // Swap bone node indices if necessary.
     if constexpr (std::is_same_v<RawMeshType, raw_mesh_r2>)
     {
-        for (auto& boneNodeIndex : rawMesh.boneNodeIndices)
-        {
-            endian_swap(boneNodeIndex);
-        }
+        endian_swap_arr(rawMesh.boneNodeIndices.count,
+            rawMesh.boneNodeIndices.data());
     }
 }
 
@@ -1181,7 +1342,7 @@ static void in_mesh_add_faces_strips(const mesh& hhMesh, hl::mesh& hlMesh)
 
 hl::mesh& mesh::add_to_node(hl::node& node, topology_type topType,
     const std::vector<mirage::node>* hhNodes, bool includeLibGensTags,
-    const char* libGensLayerName) const
+    const char* libGensLayerName, const bone_table* boneTable) const
 {
     // TODO: Handle multi-channel stuff!!!
 
@@ -1323,6 +1484,29 @@ hl::mesh& mesh::add_to_node(hl::node& node, topology_type topType,
         {
             if (!hhNodes) continue;
 
+            // Find the bones referenced by this mesh up-front,
+            // rather than searching for them once per vertex.
+            std::unique_ptr<hl::bone*[]> bones(
+                new hl::bone*[boneNodeIndices.size()]);
+
+            for (std::size_t i = 0; i < boneNodeIndices.size(); ++i)
+            {
+                const std::string& boneName = (*hhNodes)[boneNodeIndices[i]].name;
+                hl::bone* hlBone = nullptr;
+
+                if (boneTable)
+                {
+                    const auto it = boneTable->find(boneName);
+                    if (it != boneTable->end())
+                    {
+                        hlBone = it->second;
+                    }
+                }
+
+                // Fallback to searching the scene graph if the bone isn't in the table.
+                bones[i] = (hlBone) ? hlBone : scene.find_node<hl::bone>(boneName);
+            }
+
             const u8* curVtx = (vertices.get() + vtxElem.offset);
             for (u32 i = 0; i < vertexCount; ++i)
             {
@@ -1336,26 +1520,22 @@ hl::mesh& mesh::add_to_node(hl::node& node, topology_type topType,
 
                 if (val.x >= 0)
                 {
-                    bone[0] = scene.find_node<hl::bone>(
-                        (*hhNodes)[boneNodeIndices[val.x]].name);
+                    bone[0] = bones[val.x];
                 }
 
                 if (val.y >= 0)
                 {
-                    bone[1] = scene.find_node<hl::bone>(
-                        (*hhNodes)[boneNodeIndices[val.y]].name);
+                    bone[1] = bones[val.y];
                 }
 
                 if (val.z >= 0)
                 {
-                    bone[2] = scene.find_node<hl::bone>(
-                        (*hhNodes)[boneNodeIndices[val.z]].name);
+                    bone[2] = bones[val.z];
                 }
 
                 if (val.w >= 0)
                 {
-                    bone[3] = scene.find_node<hl::bone>(
-                        (*hhNodes)[boneNodeIndices[val.w]].name);
+                    bone[3] = bones[val.w];
                 }
 
                 // Get next vertex.
@@ -1501,10 +1681,10 @@ void mesh::write(writer& writer, u32 revision) const
     writer.fix_offset(meshPos + offsetof(raw_mesh_r1, faces.dataPtr));
 
 #ifndef HL_IS_BIG_ENDIAN
-    for (auto face : faces)
     {
-        hl::endian_swap(face);
-        writer.write_obj(face);
+        std::vector<u16> tmpFaces(faces);
+        endian_swap_arr(tmpFaces.size(), tmpFaces.data());
+        writer.write_arr(tmpFaces.size(), tmpFaces.data());
     }
 #else
     writer.write_arr(faces.size(), faces.data());
@@ -1516,25 +1696,20 @@ void mesh::write(writer& writer, u32 revision) const
     writer.fix_offset(meshPos + offsetof(raw_mesh_r1, vertices));
 
 #ifndef HL_IS_BIG_ENDIAN
-    std::unique_ptr<u8[]> tmpVertexBuf(new u8[vertexSize]);
-    const u8* curVtx = vertices.get();
-
-    for (u32 i = 0; i < vertexCount; ++i)
     {
-        // Copy current vertex into temporary vertex buffer.
-        std::memcpy(tmpVertexBuf.get(), curVtx, vertexSize);
+        // Copy vertices into temporary vertex buffer.
+        const std::size_t verticesSize = (
+            static_cast<std::size_t>(vertexSize) * vertexCount);
 
-        // Swap vertex in temporary vertex buffer.
-        for (auto& curVtxElem : vertexElements)
-        {
-            in_swap_vertex(curVtxElem, tmpVertexBuf.get() + curVtxElem.offset);
-        }
+        std::unique_ptr<u8[]> tmpVertexBuf(new u8[verticesSize]);
+        std::memcpy(tmpVertexBuf.get(), vertices.get(), verticesSize);
 
-        // Write swapped vertex to stream.
-        writer.write_all(vertexSize, tmpVertexBuf.get());
+        // Swap vertices in temporary vertex buffer.
+        in_swap_vertices(vertexElements.data(), vertexElements.size(),
+            vertexSize, vertexCount, tmpVertexBuf.get());
 
-        // Increase vertices pointer.
-        curVtx += vertexSize;
+        // Write swapped vertices to stream.
+        writer.write_all(verticesSize, tmpVertexBuf.get());
     }
 #else
     writer.write_all(static_cast<std::size_t>(vertexSize) *
@@ -1585,11 +1760,9 @@ void mesh::write(writer& writer, u32 revision) const
     else
     {
 #ifndef HL_IS_BIG_ENDIAN
-        for (u16 boneNodeIndex : boneNodeIndices)
-        {
-            hl::endian_swap(boneNodeIndex);
-            writer.write_obj(boneNodeIndex);
-        }
+        std::vector<u16> tmpBoneNodeIndices(boneNodeIndices);
+        endian_swap_arr(tmpBoneNodeIndices.size(), tmpBoneNodeIndices.data());
+        writer.write_arr(tmpBoneNodeIndices.size(), tmpBoneNodeIndices.data());
 #else
         writer.write_arr(boneNodeIndices.size(), boneNodeIndices.data());
 #endif
@@ -1698,12 +1871,12 @@ void mesh_slot::get_unique_material_names(
 
 void mesh_slot::add_to_node(hl::node& node, topology_type topType,
     const std::vector<mirage::node>* hhNodes, bool includeLibGensTags,
-    const char* libGensLayerName) const
+    const char* libGensLayerName, const bone_table* boneTable) const
 {
     for (auto& hhMesh : *this)
     {
         hhMesh.add_to_node(node, topType, hhNodes,
-            includeLibGensTags, libGensLayerName);
+            includeLibGensTags, libGensLayerName, boneTable);
     }
 }
 
@@ -1799,7 +1972,8 @@ void mesh_group::get_unique_material_names(
 }
 
 void mesh_group::add_to_node(hl::node& node, topology_type topType,
-    const std::vector<mirage::node>* hhNodes, bool includeLibGensTags) const
+    const std::vector<mirage::node>* hhNodes, bool includeLibGensTags,
+    const bone_table* boneTable) const
 {
     // Add LibGens NAME tag to node if necessary.
     if (includeLibGensTags && !name.empty())
@@ -1810,14 +1984,14 @@ void mesh_group::add_to_node(hl::node& node, topology_type topType,
     }
 
     // Add normal mesh slots to node.
-    opaq.add_to_node(node, topType, hhNodes, includeLibGensTags);
-    trans.add_to_node(node, topType, hhNodes, includeLibGensTags, "trans");
-    punch.add_to_node(node, topType, hhNodes, includeLibGensTags, "punch");
+    opaq.add_to_node(node, topType, hhNodes, includeLibGensTags, nullptr, boneTable);
+    trans.add_to_node(node, topType, hhNodes, includeLibGensTags, "trans", boneTable);
+    punch.add_to_node(node, topType, hhNodes, includeLibGensTags, "punch", boneTable);
 
     // Add special mesh slots to node.
     for (auto& specialSlot : special)
     {
-        specialSlot.add_to_node(node, topType, hhNodes, includeLibGensTags);
+        specialSlot.add_to_node(node, topType, hhNodes, includeLibGensTags, boneTable);
     }
 }
 
@@ -2577,6 +2751,9 @@ void terrain_model::save(const nchar* filePath,
     file_stream stream(filePath, file::mode::write);
     save(stream, headerType, version, revision,
         (revision >= 2) ? nullptr : "");
+
+    // Close file.
+    stream.close();
 }
 
 void terrain_model::save(const nchar* filePath,
@@ -2584,6 +2761,9 @@ void terrain_model::save(const nchar* filePath,
 {
     file_stream stream(filePath, file::mode::write);
     save(stream, headerType, version);
+
+    // Close file.
+    stream.close();
 }
 
 void terrain_model::save(stream& stream) const
@@ -2595,6 +2775,9 @@ void terrain_model::save(const nchar* filePath) const
 {
     file_stream stream(filePath, file::mode::write);
     save(stream);
+
+    // Close file.
+    stream.close();
 }
 
 terrain_model::terrain_model(const void* rawData, std::string name) :
@@ -2813,6 +2996,17 @@ void skeletal_model::add_to_node(hl::node& parentNode, bool includeLibGensTags)
             &parentNode : nodePtrs[0];
     }
 
+    // Map our node names to the bones we just added for them, so our meshes can
+    // quickly find the bones they reference. If multiple nodes share the same
+    // name, the first one is kept, just like when searching the scene graph.
+    bone_table boneTable;
+    boneTable.reserve(nodes.size());
+
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        boneTable.emplace(nodes[i].name, static_cast<hl::bone*>(nodePtrs[i]));
+    }
+
     // Add mesh groups to model.
     std::size_t unnamedMeshGroupCount = 0;
     for (std::size_t i = 0; i < meshGroups.size(); ++i)
@@ -2828,7 +3022,8 @@ void skeletal_model::add_to_node(hl::node& parentNode, bool includeLibGensTags)
         }
 
         hl::node& meshGroupNode = fallbackParentNode->add_child(std::move(meshGroupName));
-        meshGroups[i].add_to_node(meshGroupNode, topType, &nodes, includeLibGensTags);
+        meshGroups[i].add_to_node(meshGroupNode, topType,
+            &nodes, includeLibGensTags, &boneTable);
     }
 }
 
@@ -3123,6 +3318,9 @@ void skeletal_model::save(const nchar* filePath,
 
     file_stream stream(filePath, file::mode::write);
     save(stream, headerType, version, fileNamePtr);
+
+    // Close file.
+    stream.close();
 }
 
 void skeletal_model::save(stream& stream) const
@@ -3135,6 +3333,9 @@ void skeletal_model::save(const nchar* filePath) const
 {
     file_stream stream(filePath, file::mode::write);
     save(stream);
+
+    // Close file.
+    stream.close();
 }
 
 skeletal_model::skeletal_model(const void* rawData, std::string name) :
@@ -1,4 +1,5 @@
 #include "../io/hl_in_rapidjson.h"
+#include "../io/hl_in_json_writer.h"
 #include "hedgelib/sets/hl_hson.h"
 #include "hedgelib/io/hl_file.h"
 #include "hedgelib/io/hl_mem_stream.h"
@@ -138,6 +139,12 @@ class in_project_json_handler
             return false;
         }
 
+        // Allocate the parameter tree's nodes from the project's arena, if any.
+        if (paramTree->empty())
+        {
+            paramTree->set_arena(m_project->get_arena());
+        }
+
         // Add parameter to parameter tree and push onto stack.
         m_paramStack.push_back(&paramTree->insert(key).first->second);
         return true;
@@ -775,55 +782,55 @@ bool in_project_json_handler::EndArray(SizeType elementCount)
     }
 }
 
-void parameter::in_write_all(internal::in_rapidjson_writer& writer,
+void parameter::in_write_all(internal::in_json_writer& writer,
     const radix_tree<parameter>& parameters)
 {
     for (const auto it : parameters)
     {
-        writer.Key(it.first);
+        writer.key(it.first);
         it.second.in_write(writer);
     }
 }
 
-void parameter::in_write(internal::in_rapidjson_writer& writer) const
+void parameter::in_write(internal::in_json_writer& writer) const
 {
     switch (m_type)
     {
     case parameter_type::boolean:
-        writer.Bool(m_valBool);
+        writer.boolean(m_valBool);
         break;
 
     case parameter_type::signed_integer:
-        writer.Int64(m_valSignedInt);
+        writer.int64(m_valSignedInt);
         break;
 
     case parameter_type::unsigned_integer:
-        writer.Uint64(m_valUnsignedInt);
+        writer.uint64(m_valUnsignedInt);
         break;
 
     case parameter_type::floating:
-        writer.Double(m_valFloating);
+        writer.floating(m_valFloating);
         break;
 
     case parameter_type::string:
-        writer.String(m_valString);
+        writer.string(m_valString);
         break;
 
     case parameter_type::array:
-        writer.StartArray();
+        writer.start_array();
 
         for (auto& param : m_valArray)
         {
             param.in_write(writer);
         }
 
-        writer.EndArray();
+        writer.end_array();
         break;
 
     case parameter_type::object:
-        writer.StartObject();
+        writer.start_object();
         in_write_all(writer, m_valObject);
-        writer.EndObject();
+        writer.end_object();
         break;
     }
 }
@@ -1171,103 +1178,103 @@ const parameter* object::in_get_parameter_from_path(const char* firstNameSep,
     return nullptr;
 }
 
-void object::in_write(internal::in_rapidjson_writer& writer) const
+void object::in_write(internal::in_json_writer& writer) const
 {
     const auto hasInstance = has_instance();
 
     // Write name if necessary.
     if (name.has_value() && (hasInstance || !name->empty()))
     {
-        writer.Key("name");
-        writer.String(*name);
+        writer.key("name");
+        writer.string(*name);
     }
 
     // Write parentId if necessary.
     if (parentID.has_value() && (hasInstance || !parentID->empty()))
     {
-        writer.Key("parentId");
-        writer.String(parentID->as_string());
+        writer.key("parentId");
+        writer.string(parentID->as_string());
     }
 
     // Write instanceOf if necessary
     if (hasInstance)
     {
-        writer.Key("instanceOf");
-        writer.String(instanceOf.as_string());
+        writer.key("instanceOf");
+        writer.string(instanceOf.as_string());
     }
 
     // Write type.
     if (!hasInstance || has_type())
     {
-        writer.Key("type");
-        writer.String(type);
+        writer.key("type");
+        writer.string(type);
     }
 
     // Set array formatting to same-line.
-    writer.SetFormatOptions(rapidjson::kFormatSingleLineArray);
+    writer.set_single_line_arrays(true);
 
     // Write position if necessary.
     if (position.has_value() && (hasInstance || *position != default_position))
     {
-        writer.Key("position");
-        writer.StartArray();
-        writer.Double(position->x);
-        writer.Double(position->y);
-        writer.Double(position->z);
-        writer.EndArray();
+        writer.key("position");
+        writer.start_array();
+        writer.floating(position->x);
+        writer.floating(position->y);
+        writer.floating(position->z);
+        writer.end_array();
     }
 
     // Write rotation if necessary.
     if (rotation.has_value() && (hasInstance || *rotation != default_rotation))
     {
-        writer.Key("rotation");
-        writer.StartArray();
-        writer.Double(rotation->x);
-        writer.Double(rotation->y);
-        writer.Double(rotation->z);
-        writer.Double(rotation->w);
-        writer.EndArray();
+        writer.key("rotation");
+        writer.start_array();
+        writer.floating(rotation->x);
+        writer.floating(rotation->y);
+        writer.floating(rotation->z);
+        writer.floating(rotation->w);
+        writer.end_array();
     }
 
     // Write scale if necessary.
     if (scale.has_value() && (hasInstance || *scale != default_scale))
     {
-        writer.Key("scale");
-        writer.StartArray();
-        writer.Double(scale->x);
-        writer.Double(scale->y);
-        writer.Double(scale->z);
-        writer.EndArray();
+        writer.key("scale");
+        writer.start_array();
+        writer.floating(scale->x);
+        writer.floating(scale->y);
+        writer.floating(scale->z);
+        writer.end_array();
     }
 
     // Set array formatting to multi-line.
-    writer.SetFormatOptions(rapidjson::kFormatDefault);
+    writer.set_single_line_arrays(false);
 
     // Write isEditorVisible if necessary.
     if (isEditorVisible.has_value() && (hasInstance ||
         *isEditorVisible != default_is_editor_visible))
     {
-        writer.Key("isEditorVisible");
-        writer.Bool(*isEditorVisible);
+        writer.key("isEditorVisible");
+        writer.boolean(*isEditorVisible);
     }
 
     // Write isExcluded if necessary.
     if (isExcluded.has_value() && (hasInstance ||
         *isExcluded != default_is_excluded))
     {
-        writer.Key("isExcluded");
-        writer.Bool(*isExcluded);
+        writer.key("isExcluded");
+        writer.boolean(*isExcluded);
     }
 
     // Write parameters if necessary.
     if (!parameters.empty())
     {
-        writer.Key("parameters");
-        writer.StartObject();
+        writer.key("parameters");
+        writer.start_object();
 
         parameter::in_write_all(writer, parameters);
 
-        writer.EndObject();
+        writer.end_object();
     }
 
     // Write custom properties if necessary.
@@ -1366,14 +1373,10 @@ const vec3& object::get_local_scale(
     return (localScale) ? *localScale : default_scale;
 }
 
-static DirectX::XMMATRIX in_get_matrix(const object& obj,
-    const ordered_map<guid, object>& objects) noexcept
+static DirectX::XMMATRIX in_get_matrix(const vec3& pos,
+    const quat& rot, const vec3& scale) noexcept
 {
-    // Compute matrix with the given translation and rotation.
-    const auto& pos = obj.get_local_position(objects);
-    const auto& rot = obj.get_local_rotation(objects);
-    const auto& scale = obj.get_local_scale(objects);
-
+    // Compute matrix with the given translation, rotation, and scale.
     return DirectX::XMMatrixAffineTransformation(
         DirectX::XMLoadFloat3(reinterpret_cast<const DirectX::XMFLOAT3*>(&scale.x)),
         DirectX::g_XMZero,
@@ -1382,6 +1385,13 @@ static DirectX::XMMATRIX in_get_matrix(const object& obj,
     );
 }
 
+static DirectX::XMMATRIX in_get_matrix(const object& obj,
+    const ordered_map<guid, object>& objects) noexcept
+{
+    return in_get_matrix(obj.get_local_position(objects),
+        obj.get_local_rotation(objects), obj.get_local_scale(objects));
+}
+
 matrix4x4A object::get_local_transform(const ordered_map<guid, object>& objects) const
 {
     HL_STATIC_ASSERT_SIZE(DirectX::XMFLOAT4X4A, sizeof(matrix4x4A));
@@ -1528,41 +1538,41 @@ radix_tree<parameter> object::get_flattened_parameters(
     return result;
 }
 
-void project_metadata::in_write(internal::in_rapidjson_writer& writer) const
+void project_metadata::in_write(internal::in_json_writer& writer) const
 {
     // Write name if necessary.
     if (!name.empty())
     {
-        writer.Key("name");
-        writer.String(name);
+        writer.key("name");
+        writer.string(name);
     }
 
     // Write author if necessary.
     if (!author.empty())
     {
-        writer.Key("author");
-        writer.String(author);
+        writer.key("author");
+        writer.string(author);
     }
 
     // Write date if necessary.
     if (!date.empty())
     {
-        writer.Key("date");
-        writer.String(date);
+        writer.key("date");
+        writer.string(date);
     }
 
     // Write version if necessary.
     if (!version.empty())
     {
-        writer.Key("version");
-        writer.String(version);
+        writer.key("version");
+        writer.string(version);
     }
 
     // Write description if necessary.
     if (!description.empty())
     {
-        writer.Key("description");
-        writer.String(description);
+        writer.key("description");
+        writer.string(description);
     }
 
     // Write custom properties if necessary.
@@ -1591,29 +1601,28 @@ void project_metadata::clear() noexcept
 
 void project::write(stream& stream) const
 {
-    // Create RapidJSON writer.
-    internal::in_rapidjson_output_stream_wrapper jsonStream(stream);
-    internal::in_rapidjson_writer writer(jsonStream);
+    // Create JSON writer.
+    internal::in_json_writer writer(stream);
 
     // Write HSON header.
-    writer.StartObject();
-    writer.Key("version");
-    writer.Uint(max_supported_version);
+    writer.start_object();
+    writer.key("version");
+    writer.uint(max_supported_version);
 
     // Write metadata if necessary.
     if (!metadata.empty())
     {
-        writer.Key("metadata");
-        writer.StartObject();
+        writer.key("metadata");
+        writer.start_object();
         metadata.in_write(writer);
-        writer.EndObject();
+        writer.end_object();
     }
 
     // Write objects if necessary.
     if (!objects.empty())
     {
-        writer.Key("objects");
-        writer.StartArray();
+        writer.key("objects");
+        writer.start_array();
 
         // Determine which objects need to have their ids written.
         const bool writeAllIDs = true; // TODO: Make this optional.
@@ -1644,20 +1653,20 @@ void project::write(stream& stream) const
         // Write objects.
         for (const auto& it : objects)
         {
-            writer.StartObject();
+            writer.start_object();
             
             // Write ID if necessary.
             if (writeAllIDs || requiredIDs.contains(it.first))
             {
-                writer.Key("id");
-                writer.String(it.first.as_string());
+                writer.key("id");
+                writer.string(it.first.as_string());
             }
 
             it.second.in_write(writer);
-            writer.EndObject();
+            writer.end_object();
         }
 
-        writer.EndArray();
+        writer.end_array();
     }
 
     // Write custom properties if necessary.
@@ -1666,13 +1675,16 @@ void project::write(stream& stream) const
         parameter::in_write_all(writer, customProperties);
     }
 
-    writer.EndObject();
+    writer.end_object();
 }
 
 void project::save(const nchar* filePath) const
 {
     file_stream stream(filePath, file::mode::write);
     write(stream);
+
+    // Close file.
+    stream.close();
 }
 
 void project::in_parse(const void* rawData, std::size_t rawDataSize)
@@ -1732,5 +1744,422 @@ project::project(const nchar* filePath)
 {
     in_load(filePath);
 }
+
+enum in_project_view_flags : unsigned char
+{
+    in_project_view_flag_dirty = 1,
+    in_project_view_flag_resolving = 2,
+    in_project_view_flag_has_flat_params = 4
+};
+
+std::size_t project_view::in_find_index(const guid& id) const noexcept
+{
+    const auto it = m_indices.find(id);
+    return (it != m_indices.end()) ? it->second : npos;
+}
+
+template<typename T, typename getter_t>
+T project_view::in_get_inherited_value(std::size_t index,
+    const getter_t& getter) const noexcept
+{
+    // Walk up the instance chain until we find an object which specifies the value.
+    // NOTE: The step limit guards against instance chains which loop back on themselves.
+    for (std::size_t steps = 0; index != npos &&
+        steps < m_objects.size(); ++steps)
+    {
+        const T value = getter(*m_objects[index]);
+        if (value) return value;
+
+        index = m_instanceIndices[index];
+    }
+
+    return nullptr;
+}
+
+void project_view::in_resolve_values(std::size_t index) noexcept
+{
+    m_names[index] = in_get_inherited_value<const std::string*>(index,
+        [](const object& obj)
+        {
+            return (obj.name.has_value()) ? &obj.name.value() : nullptr;
+        });
+
+    m_types[index] = in_get_inherited_value<const std::string*>(index,
+        [](const object& obj)
+        {
+            return (obj.has_type()) ? &obj.type : nullptr;
+        });
+
+    m_parentIDs[index] = in_get_inherited_value<const guid*>(index,
+        [](const object& obj)
+        {
+            return (obj.parentID.has_value()) ? &obj.parentID.value() : nullptr;
+        });
+
+    m_parentIndices[index] = (m_parentIDs[index] && !m_parentIDs[index]->empty()) ?
+        in_find_index(*m_parentIDs[index]) : npos;
+}
+
+void project_view::in_rebuild()
+{
+    // Index all of the objects within the project.
+    const auto& objects = m_project->objects;
+    const std::size_t objCount = objects.size();
+
+    m_indices.clear();
+    m_indices.reserve(objCount);
+    m_ids.clear();
+    m_ids.reserve(objCount);
+    m_objects.clear();
+    m_objects.reserve(objCount);
+
+    for (const auto& it : objects)
+    {
+        m_indices.emplace(it.first, m_objects.size());
+        m_ids.push_back(&it.first);
+        m_objects.push_back(&it.second);
+    }
+
+    // Look up the index of every object's instanced object.
+    m_instanceIndices.assign(objCount, npos);
+    for (std::size_t i = 0; i < objCount; ++i)
+    {
+        const auto& obj = *m_objects[i];
+        if (obj.has_instance())
+        {
+            m_instanceIndices[i] = in_find_index(obj.instanceOf);
+        }
+    }
+
+    // Resolve the inherited values of every object.
+    m_names.assign(objCount, nullptr);
+    m_types.assign(objCount, nullptr);
+    m_parentIDs.assign(objCount, nullptr);
+    m_parentIndices.assign(objCount, npos);
+
+    for (std::size_t i = 0; i < objCount; ++i)
+    {
+        in_resolve_values(i);
+    }
+
+    // Mark every object as needing its transform and flattened parameters resolved.
+    m_globalTransforms.resize(objCount);
+    m_flatParams.clear();
+    m_flatParams.resize(objCount);
+    m_flags.assign(objCount, in_project_view_flag_dirty);
+
+    // Build a list of the objects which are parented to, or instance, each object.
+    m_dependentsBegin.assign(objCount + 1, 0);
+    for (std::size_t i = 0; i < objCount; ++i)
+    {
+        if (m_instanceIndices[i] != npos)
+        {
+            ++m_dependentsBegin[m_instanceIndices[i] + 1];
+        }
+
+        if (m_parentIndices[i] != npos && m_parentIndices[i] != m_instanceIndices[i])
+        {
+            ++m_dependentsBegin[m_parentIndices[i] + 1];
+        }
+    }
+
+    for (std::size_t i = 0; i < objCount; ++i)
+    {
+        m_dependentsBegin[i + 1] += m_dependentsBegin[i];
+    }
+
+    std::vector<std::size_t> dependentsEnd(m_dependentsBegin.begin(),
+        m_dependentsBegin.end() - 1);
+
+    m_dependents.resize(m_dependentsBegin[objCount]);
+
+    for (std::size_t i = 0; i < objCount; ++i)
+    {
+        if (m_instanceIndices[i] != npos)
+        {
+            m_dependents[dependentsEnd[m_instanceIndices[i]]++] = i;
+        }
+
+        if (m_parentIndices[i] != npos && m_parentIndices[i] != m_instanceIndices[i])
+        {
+            m_dependents[dependentsEnd[m_parentIndices[i]]++] = i;
+        }
+    }
+
+    m_needsRebuild = false;
+    m_hasDirtyObjects = true;
+}
+
+void project_view::in_resolve_global_transforms()
+{
+    std::vector<std::size_t> chain;
+    for (std::size_t i = 0; i < m_objects.size(); ++i)
+    {
+        if (!(m_flags[i] & in_project_view_flag_dirty)) continue;
+
+        // Walk up the parent chain until we reach an object which
+        // has already been resolved, or which has no (valid) parent.
+        std::size_t curIndex = i;
+        while (true)
+        {
+            chain.push_back(curIndex);
+            m_flags[curIndex] |= in_project_view_flag_resolving;
+
+            const auto parentIndex = m_parentIndices[curIndex];
+            if (parentIndex == npos ||
+                !(m_flags[parentIndex] & in_project_view_flag_dirty) ||
+                (m_flags[parentIndex] & in_project_view_flag_resolving))
+            {
+                break;
+            }
+
+            curIndex = parentIndex;
+        }
+
+        // Resolve the chain from the top down, so that each object's
+        // parent has always been resolved before the object itself.
+        while (!chain.empty())
+        {
+            curIndex = chain.back();
+            chain.pop_back();
+
+            // Compute the object's local transform.
+            const auto pos = in_get_inherited_value<const vec3*>(curIndex,
+                [](const object& obj)
+                {
+                    return (obj.position.has_value()) ? &obj.position.value() : nullptr;
+                });
+
+            const auto rot = in_get_inherited_value<const quat*>(curIndex,
+                [](const object& obj)
+                {
+                    return (obj.rotation.has_value()) ? &obj.rotation.value() : nullptr;
+                });
+
+            const auto scale = in_get_inherited_value<const vec3*>(curIndex,
+                [](const object& obj)
+                {
+                    return (obj.scale.has_value()) ? &obj.scale.value() : nullptr;
+                });
+
+            auto xmMtx = in_get_matrix(
+                (pos) ? *pos : object::default_position,
+                (rot) ? *rot : object::default_rotation,
+                (scale) ? *scale : object::default_scale);
+
+            // If the object has a resolved parent, its transform is local to the parent.
+            // NOTE: The parent could only still be unresolved here if the chain loops.
+            const auto parentIndex = m_parentIndices[curIndex];
+            if (parentIndex != npos &&
+                !(m_flags[parentIndex] & in_project_view_flag_dirty))
+            {
+                xmMtx = DirectX::XMMatrixMultiply(xmMtx,
+                    DirectX::XMLoadFloat4x4A(reinterpret_cast<
+                        const DirectX::XMFLOAT4X4A*>(
+                        &m_globalTransforms[parentIndex].m11)));
+            }
+
+            DirectX::XMStoreFloat4x4A(reinterpret_cast<DirectX::XMFLOAT4X4A*>(
+                &m_globalTransforms[curIndex].m11), xmMtx);
+
+            m_flags[curIndex] &= ~(in_project_view_flag_dirty |
+                in_project_view_flag_resolving);
+        }
+    }
+}
+
+std::size_t project_view::size()
+{
+    in_update_if_necessary();
+    return m_objects.size();
+}
+
+std::size_t project_view::index_of(const guid& id)
+{
+    in_update_if_necessary();
+    return in_find_index(id);
+}
+
+const guid& project_view::get_id(std::size_t index)
+{
+    in_update_if_necessary();
+    return *m_ids[index];
+}
+
+const object& project_view::get_object(std::size_t index)
+{
+    in_update_if_necessary();
+    return *m_objects[index];
+}
+
+const std::string* project_view::get_inherited_name(std::size_t index)
+{
+    in_update_if_necessary();
+    return m_names[index];
+}
+
+const std::string* project_view::get_inherited_type(std::size_t index)
+{
+    in_update_if_necessary();
+    return m_types[index];
+}
+
+const guid* project_view::get_inherited_parent_id(std::size_t index)
+{
+    in_update_if_necessary();
+    return m_parentIDs[index];
+}
+
+std::size_t project_view::get_parent_index(std::size_t index)
+{
+    in_update_if_necessary();
+    return m_parentIndices[index];
+}
+
+const matrix4x4A& project_view::get_global_transform(std::size_t index)
+{
+    in_update_if_necessary();
+    return m_globalTransforms[index];
+}
+
+const radix_tree<parameter>& project_view::get_flattened_parameters(std::size_t index)
+{
+    in_update_if_necessary();
+
+    // Flatten the object's parameters if we haven't already.
+    auto& flatParams = m_flatParams[index];
+    if (!(m_flags[index] & in_project_view_flag_has_flat_params))
+    {
+        // Add all parameters from the object, followed by each of its instanced objects.
+        // NOTE: The step limit guards against instance chains which loop back on themselves.
+        std::size_t curIndex = index;
+        for (std::size_t steps = 0; curIndex != npos &&
+            steps < m_objects.size(); ++steps)
+        {
+            in_insert_flattened_parameters(
+                m_objects[curIndex]->parameters, flatParams);
+
+            curIndex = m_instanceIndices[curIndex];
+        }
+
+        m_flags[index] |= in_project_view_flag_has_flat_params;
+    }
+
+    return flatParams;
+}
+
+void project_view::invalidate(const guid& id)
+{
+    // Everything will already be re-resolved if we need to rebuild.
+    if (m_needsRebuild) return;
+
+    // If the object was added or removed, rebuild everything.
+    const auto index = in_find_index(id);
+    const auto obj = m_project->objects.get(id);
+
+    if (index == npos || obj != m_objects[index])
+    {
+        m_needsRebuild = true;
+        return;
+    }
+
+    // If the object's instanced object or (inherited) parent changed,
+    // the list of objects which depend on it is no longer correct,
+    // so rebuild everything.
+    const auto instanceIndex = (obj->has_instance()) ?
+        in_find_index(obj->instanceOf) : npos;
+
+    const auto parentIndex = m_parentIndices[index];
+    if (instanceIndex != m_instanceIndices[index])
+    {
+        m_needsRebuild = true;
+        return;
+    }
+
+    in_resolve_values(index);
+    if (m_parentIndices[index] != parentIndex)
+    {
+        m_needsRebuild = true;
+        return;
+    }
+
+    // Return early if the object has already been invalidated, as
+    // every object which depends on it will have been invalidated too.
+    if (m_flags[index] & in_project_view_flag_dirty) return;
+
+    // Mark the object, and every object which depends on it, as dirty.
+    std::vector<std::size_t> dirtyIndices;
+    dirtyIndices.push_back(index);
+    m_flags[index] |= in_project_view_flag_dirty;
+
+    while (!dirtyIndices.empty())
+    {
+        const auto curIndex = dirtyIndices.back();
+        dirtyIndices.pop_back();
+
+        for (std::size_t i = m_dependentsBegin[curIndex];
+            i < m_dependentsBegin[curIndex + 1]; ++i)
+        {
+            const auto dependentIndex = m_dependents[i];
+            if (!(m_flags[dependentIndex] & in_project_view_flag_dirty))
+            {
+                m_flags[dependentIndex] |= in_project_view_flag_dirty;
+                dirtyIndices.push_back(dependentIndex);
+            }
+        }
+    }
+
+    m_hasDirtyObjects = true;
+}
+
+void project_view::invalidate_all() noexcept
+{
+    m_needsRebuild = true;
+}
+
+void project_view::update()
+{
+    // Rebuild everything if necessary.
+    if (m_needsRebuild)
+    {
+        in_rebuild();
+    }
+
+    // Otherwise, just resolve the inherited values of dirty objects.
+    else if (m_hasDirtyObjects)
+    {
+        for (std::size_t i = 0; i < m_objects.size(); ++i)
+        {
+            if (m_flags[i] & in_project_view_flag_dirty)
+            {
+                in_resolve_values(i);
+            }
+        }
+    }
+
+    else
+    {
+        return;
+    }
+
+    // Free the flattened parameters of dirty objects; they'll be
+    // flattened again the next time they're requested.
+    for (std::size_t i = 0; i < m_objects.size(); ++i)
+    {
+        if ((m_flags[i] & in_project_view_flag_dirty) &&
+            (m_flags[i] & in_project_view_flag_has_flat_params))
+        {
+            m_flatParams[i].clear();
+            m_flags[i] &= ~in_project_view_flag_has_flat_params;
+        }
+    }
+
+    // Resolve the global transforms of dirty objects.
+    in_resolve_global_transforms();
+    m_hasDirtyObjects = false;
+}
+
+project_view::project_view(const hson::project& project) :
+    m_project(&project) {}
 } // hson
 } // hl
@@ -1,6 +1,11 @@
 #include "../io/hl_in_rapidjson.h"
 #include "hedgelib/sets/hl_set_obj_type.h"
+#include "hedgelib/io/hl_path.h"
+#include "hedgelib/io/hl_file.h"
+#include "hedgelib/hl_blob.h"
+#include <robin_hood.h>
 #include <string_view>
+#include <cstring>
 
 namespace hl
 {
@@ -1167,8 +1172,405 @@ bool in_set_object_type_database_json_handler::EndArray(SizeType elementCount)
         return false;
     }
 }
+
+/*
+    Set object type database cache format:
+
+    A small header, followed by the database's contents written out in
+    the same order they're stored in within the database, so reading them
+    back in order re-creates an identical database. All values are stored
+    in the host's native byte order, and strings are stored as a u32
+    length followed by their (non-null-terminated) characters.
+*/
+constexpr u32 in_set_obj_type_cache_sig = make_sig("HLTC");
+
+// NOTE: Increment this whenever the cache format, or the way
+// the database is parsed from JSON data, is changed.
+constexpr u32 in_set_obj_type_cache_version = 1;
+
+struct in_set_obj_type_cache_header
+{
+    u32 signature;
+    u32 version;
+    u64 sourceSize;
+    u64 sourceHash;
+};
+
+class in_set_obj_type_cache_reader
+{
+    const u8* m_curPtr;
+    const u8* m_endPtr;
+
+public:
+    void read_all(std::size_t size, void* buf)
+    {
+        if (size > static_cast<std::size_t>(m_endPtr - m_curPtr))
+        {
+            throw std::runtime_error("Set object type database cache is truncated");
+        }
+
+        std::memcpy(buf, m_curPtr, size);
+        m_curPtr += size;
+    }
+
+    template<typename T>
+    T read_obj()
+    {
+        T obj;
+        read_all(sizeof(T), &obj);
+        return obj;
+    }
+
+    std::string read_str()
+    {
+        const auto len = read_obj<u32>();
+        if (len > static_cast<std::size_t>(m_endPtr - m_curPtr))
+        {
+            throw std::runtime_error("Set object type database cache is truncated");
+        }
+
+        std::string str(reinterpret_cast<const char*>(m_curPtr), len);
+        m_curPtr += len;
+        return str;
+    }
+
+    in_set_obj_type_cache_reader(const void* rawData, std::size_t rawDataSize) noexcept :
+        m_curPtr(static_cast<const u8*>(rawData)),
+        m_endPtr(m_curPtr + rawDataSize) {}
+};
+
+static u64 in_hash_set_obj_type_json(const void* rawData, std::size_t rawDataSize) noexcept
+{
+    return static_cast<u64>(robin_hood::hash_bytes(rawData, rawDataSize));
+}
+
+static void in_write_cache_str(stream& stream, const std::string& str)
+{
+    stream.write_obj(static_cast<u32>(str.size()));
+    stream.write_all(str.size(), str.data());
+}
+
+static void in_write_cache_descriptions(stream& stream,
+    const radix_tree<std::string>& descriptions)
+{
+    stream.write_obj(static_cast<u32>(descriptions.size()));
+    for (const auto it : descriptions)
+    {
+        in_write_cache_str(stream, it.first);
+        in_write_cache_str(stream, it.second);
+    }
+}
+
+static void in_read_cache_descriptions(in_set_obj_type_cache_reader& reader,
+    radix_tree<std::string>& descriptions)
+{
+    const auto descCount = reader.read_obj<u32>();
+    descriptions.reserve(descCount);
+
+    for (u32 i = 0; i < descCount; ++i)
+    {
+        const auto lang = reader.read_str();
+        descriptions.insert(lang, reader.read_str());
+    }
+}
+
+static void in_write_cache_default_val(stream& stream,
+    const reflect::field_definition& field)
+{
+    // NOTE: The active default value always matches the field's type
+    // (not its subtype), as the JSON handler only sets default values
+    // based on the field's type.
+    if (field.is_string())
+    {
+        in_write_cache_str(stream, field.default_val_string());
+    }
+    else if (field.is_floating())
+    {
+        stream.write_obj(field.default_val_floating());
+    }
+    else if (field.is_char())
+    {
+        stream.write_obj(field.default_val_char());
+    }
+    else if (field.is_bool())
+    {
+        stream.write_obj(static_cast<u8>(field.default_val_bool()));
+    }
+    else if (field.is_vec2())
+    {
+        stream.write_obj(field.default_val_vec2());
+    }
+    else if (field.is_vec3())
+    {
+        stream.write_obj(field.default_val_vec3());
+    }
+    else if (field.is_vec4())
+    {
+        stream.write_obj(field.default_val_vec4());
+    }
+    else if (field.is_quat())
+    {
+        stream.write_obj(field.default_val_quat());
+    }
+    else
+    {
+        stream.write_obj(static_cast<u64>(field.default_val_uint()));
+    }
+}
+
+static void in_read_cache_default_val(in_set_obj_type_cache_reader& reader,
+    reflect::field_definition& field)
+{
+    if (field.is_string())
+    {
+        field.set_default_val_string(reader.read_str());
+    }
+    else if (field.is_floating())
+    {
+        field.set_default_val_floating(reader.read_obj<double>());
+    }
+    else if (field.is_char())
+    {
+        field.set_default_val_char(reader.read_obj<char>());
+    }
+    else if (field.is_bool())
+    {
+        field.set_default_val_bool(reader.read_obj<u8>() != 0);
+    }
+    else if (field.is_vec2())
+    {
+        field.set_default_val_vec2(reader.read_obj<vec2>());
+    }
+    else if (field.is_vec3())
+    {
+        field.set_default_val_vec3(reader.read_obj<vec3>());
+    }
+    else if (field.is_vec4())
+    {
+        field.set_default_val_vec4(reader.read_obj<vec4>());
+    }
+    else if (field.is_quat())
+    {
+        field.set_default_val_quat(reader.read_obj<quat>());
+    }
+    else
+    {
+        field.set_default_val_uint(static_cast<std::uintmax_t>(
+            reader.read_obj<u64>()));
+    }
+}
 } // internal
 
+bool set_object_type_database::in_read_cache(const void* rawData,
+    std::size_t rawDataSize, u64 sourceSize, u64 sourceHash)
+{
+    internal::in_set_obj_type_cache_reader reader(rawData, rawDataSize);
+
+    // Ensure the cache is up-to-date.
+    const auto header = reader.read_obj<internal::in_set_obj_type_cache_header>();
+    if (header.signature != internal::in_set_obj_type_cache_sig ||
+        header.version != internal::in_set_obj_type_cache_version ||
+        header.sourceSize != sourceSize || header.sourceHash != sourceHash)
+    {
+        return false;
+    }
+
+    // Read format.
+    const auto formatVal = reader.read_obj<u32>();
+    if (formatVal > static_cast<u32>(set_object_format::gedit_v3))
+    {
+        throw std::runtime_error("Invalid set object format in cache");
+    }
+
+    format = static_cast<set_object_format>(formatVal);
+
+    // Read enums.
+    const auto enumCount = reader.read_obj<u32>();
+    enums.reserve(enumCount);
+
+    for (u32 i = 0; i < enumCount; ++i)
+    {
+        auto& enumDef = enums.insert(reader.read_str()).first->second;
+        const auto enumType = reader.read_obj<u8>();
+
+        if (enumType > static_cast<u8>(reflect::integral_type::uint64))
+        {
+            throw std::runtime_error("Invalid enum type in cache");
+        }
+
+        enumDef.type = static_cast<reflect::integral_type>(enumType);
+
+        const auto valCount = reader.read_obj<u32>();
+        enumDef.values.reserve(valCount);
+
+        for (u32 i2 = 0; i2 < valCount; ++i2)
+        {
+            auto& enumVal = enumDef.values.insert(reader.read_str()).first->second;
+            enumVal.value = static_cast<std::uintmax_t>(reader.read_obj<u64>());
+            enumVal.defaultDescription = reader.read_str();
+            internal::in_read_cache_descriptions(reader, enumVal.descriptions);
+        }
+    }
+
+    // Read structs.
+    const auto structCount = reader.read_obj<u32>();
+    structs.reserve(structCount);
+
+    for (u32 i = 0; i < structCount; ++i)
+    {
+        auto& structDef = structs.insert(reader.read_str()).first->second;
+        structDef.parent = reader.read_str();
+        structDef.alignment = static_cast<std::size_t>(reader.read_obj<u64>());
+
+        const auto fieldCount = reader.read_obj<u32>();
+        structDef.fields.reserve(fieldCount);
+
+        for (u32 i2 = 0; i2 < fieldCount; ++i2)
+        {
+            auto& field = structDef.fields.emplace_back(reader.read_str());
+            field.set_type(reader.read_str());
+            field.set_subtype(reader.read_str());
+            field.set_array_count(static_cast<std::size_t>(reader.read_obj<u64>()));
+            field.alignment = static_cast<std::size_t>(reader.read_obj<u64>());
+
+            internal::in_read_cache_default_val(reader, field);
+            field.defaultDescription = reader.read_str();
+            internal::in_read_cache_descriptions(reader, field.descriptions);
+        }
+    }
+
+    // Read objects.
+    const auto objCount = reader.read_obj<u32>();
+    reserve(objCount);
+
+    for (u32 i = 0; i < objCount; ++i)
+    {
+        auto& obj = insert(reader.read_str()).first->second;
+        obj.structType = reader.read_str();
+        obj.category = reader.read_str();
+    }
+
+    return true;
+}
+
+void set_object_type_database::in_write_cache(stream& stream,
+    u64 sourceSize, u64 sourceHash) const
+{
+    // Write header.
+    const internal::in_set_obj_type_cache_header header =
+    {
+        internal::in_set_obj_type_cache_sig,        // signature
+        internal::in_set_obj_type_cache_version,    // version
+        sourceSize,                                 // sourceSize
+        sourceHash                                  // sourceHash
+    };
+
+    stream.write_obj(header);
+
+    // Write format.
+    stream.write_obj(static_cast<u32>(format));
+
+    // Write enums.
+    stream.write_obj(static_cast<u32>(enums.size()));
+    for (const auto enumIt : enums)
+    {
+        const auto& enumDef = enumIt.second;
+        internal::in_write_cache_str(stream, enumIt.first);
+        stream.write_obj(static_cast<u8>(enumDef.type));
+
+        stream.write_obj(static_cast<u32>(enumDef.values.size()));
+        for (const auto valIt : enumDef.values)
+        {
+            const auto& enumVal = valIt.second;
+            internal::in_write_cache_str(stream, valIt.first);
+            stream.write_obj(static_cast<u64>(enumVal.value));
+            internal::in_write_cache_str(stream, enumVal.defaultDescription);
+            internal::in_write_cache_descriptions(stream, enumVal.descriptions);
+        }
+    }
+
+    // Write structs.
+    stream.write_obj(static_cast<u32>(structs.size()));
+    for (const auto structIt : structs)
+    {
+        const auto& structDef = structIt.second;
+        internal::in_write_cache_str(stream, structIt.first);
+        internal::in_write_cache_str(stream, structDef.parent);
+        stream.write_obj(static_cast<u64>(structDef.alignment));
+
+        stream.write_obj(static_cast<u32>(structDef.fields.size()));
+        for (const auto& field : structDef.fields)
+        {
+            internal::in_write_cache_str(stream, field.name);
+            internal::in_write_cache_str(stream, field.type());
+            internal::in_write_cache_str(stream, field.subtype());
+            stream.write_obj(static_cast<u64>(field.array_count()));
+            stream.write_obj(static_cast<u64>(field.alignment));
+
+            internal::in_write_cache_default_val(stream, field);
+            internal::in_write_cache_str(stream, field.defaultDescription);
+            internal::in_write_cache_descriptions(stream, field.descriptions);
+        }
+    }
+
+    // Write objects.
+    stream.write_obj(static_cast<u32>(size()));
+    for (const auto objIt : *this)
+    {
+        internal::in_write_cache_str(stream, objIt.first);
+        internal::in_write_cache_str(stream, objIt.second.structType);
+        internal::in_write_cache_str(stream, objIt.second.category);
+    }
+}
+
+void set_object_type_database::in_load(
+    const nchar* filePath, const nchar* cacheFilePath)
+{
+    // Load JSON data and compute its hash. This is far cheaper than parsing
+    // it, and lets us tell whether the cache is still up-to-date.
+    const blob jsonData(filePath);
+    const auto jsonSize = static_cast<u64>(jsonData.size());
+    const auto jsonHash = internal::in_hash_set_obj_type_json(
+        jsonData.data(), jsonData.size());
+
+    // Read the cache if it exists and is up-to-date.
+    if (path::exists(cacheFilePath))
+    {
+        try
+        {
+            const blob cacheData(cacheFilePath);
+            if (in_read_cache(cacheData.data(), cacheData.size(),
+                jsonSize, jsonHash))
+            {
+                return;
+            }
+        }
+        catch (const std::exception&)
+        {
+            // Treat caches we can't read as though they were out-of-date.
+        }
+
+        // Discard anything we read from the cache before it was rejected.
+        clear();
+    }
+
+    // Parse the JSON data.
+    in_parse(jsonData.data(), jsonData.size());
+
+    // (Re-)generate the cache.
+    try
+    {
+        file_stream cacheStream(cacheFilePath, file::mode::write);
+        in_write_cache(cacheStream, jsonSize, jsonHash);
+        cacheStream.close();
+    }
+    catch (const std::exception&)
+    {
+        // The cache is purely an optimization, so failing to write it (e.g.
+        // because the templates directory is read-only) isn't an error.
+    }
+}
+
 void set_object_type_database::in_parse(
     const void* rawData, std::size_t rawDataSize)
 {
@@ -1215,6 +1617,13 @@ void set_object_type_database::load(const nchar* filePath)
     in_load(filePath);
 }
 
+void set_object_type_database::load(
+    const nchar* filePath, const nchar* cacheFilePath)
+{
+    clear();
+    in_load(filePath, cacheFilePath);
+}
+
 set_object_type_database::set_object_type_database(
     const void* rawData, std::size_t rawDataSize)
 {
@@ -1230,4 +1639,10 @@ set_object_type_database::set_object_type_database(const nchar* filePath)
 {
     in_load(filePath);
 }
+
+set_object_type_database::set_object_type_database(
+    const nchar* filePath, const nchar* cacheFilePath)
+{
+    in_load(filePath, cacheFilePath);
+}
 } // hl
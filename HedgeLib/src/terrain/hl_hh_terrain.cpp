@@ -26,16 +26,10 @@ static void in_swap_recursive(raw_lit_element& elem)
     elem.endian_swap<false>();
 
     // Swap light indices.
-    for (auto& lightIndex : elem.lightIndices)
-    {
-        hl::endian_swap(lightIndex);
-    }
+    endian_swap_arr(elem.lightIndices.count, elem.lightIndices.data());
 
     // Swap lit vertex indices.
-    for (auto& litVtxIndex : elem.litVtxIndices)
-    {
-        hl::endian_swap(litVtxIndex);
-    }
+    endian_swap_arr(elem.litVtxIndices.count, elem.litVtxIndices.data());
 }
 
 static void in_swap_recursive(raw_lit_mesh& mesh)
@@ -116,10 +110,10 @@ void lit_element::write(std::size_t basePos, stream& stream, off_table& offTable
 
     // Write light indices.
 #ifndef HL_IS_BIG_ENDIAN
-    for (auto lightIndex : lightIndices)
     {
-        hl::endian_swap(lightIndex);
-        stream.write_obj(lightIndex);
+        std::vector<u32> tmpLightIndices(lightIndices);
+        endian_swap_arr(tmpLightIndices.size(), tmpLightIndices.data());
+        stream.write_arr(tmpLightIndices.size(), tmpLightIndices.data());
     }
 #else
     stream.write_arr(lightIndices.size(), lightIndices.data());
@@ -131,10 +125,10 @@ void lit_element::write(std::size_t basePos, stream& stream, off_table& offTable
 
     // Write lit vertex indices.
 #ifndef HL_IS_BIG_ENDIAN
-    for (auto litVtxIndex : litVtxIndices)
     {
-        hl::endian_swap(litVtxIndex);
-        stream.write_obj(litVtxIndex);
+        std::vector<u16> tmpLitVtxIndices(litVtxIndices);
+        endian_swap_arr(tmpLitVtxIndices.size(), tmpLitVtxIndices.data());
+        stream.write_arr(tmpLitVtxIndices.size(), tmpLitVtxIndices.data());
     }
 #else
     stream.write_arr(litVtxIndices.size(), litVtxIndices.data());
@@ -451,6 +445,9 @@ void terrain_instance_info::save(const nchar* filePath, u32 version) const
 {
     file_stream stream(filePath, file::mode::write);
     save(stream, version, (version == 5) ? "" : nullptr);
+
+    // Close file.
+    stream.close();
 }
 
 void terrain_instance_info::save(stream& stream) const
@@ -463,6 +460,9 @@ void terrain_instance_info::save(const nchar* filePath) const
 {
     file_stream stream(filePath, file::mode::write);
     save(stream);
+
+    // Close file.
+    stream.close();
 }
 } // mirage
 } // hh
@@ -2,6 +2,7 @@
 #include <hedgelib/archives/hl_hh_archive.h>
 #include <hedgelib/archives/hl_pacx.h>
 #include <hedgelib/io/hl_path.h>
+#include <hedgelib/hl_thread_pool.h>
 #include <exception>
 #include <optional>
 
@@ -839,7 +840,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            (args.generatePFI) ? &pfi : nullptr);           // pfi
+            (args.generatePFI) ? &pfi : nullptr,            // pfi
+            &hl::thread_pool::get_default());               // pool
 
         break;
 
@@ -851,7 +853,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            (args.generatePFI) ? &pfi : nullptr);           // pfi
+            (args.generatePFI) ? &pfi : nullptr,            // pfi
+            &hl::thread_pool::get_default());               // pool
 
         break;
 
@@ -866,7 +869,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            (args.generatePFI) ? &pfi : nullptr);           // pfi
+            (args.generatePFI) ? &pfi : nullptr,            // pfi
+            &hl::thread_pool::get_default());               // pool
 
         break;
 
@@ -883,7 +887,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            false);                                         // noCompress
+            false,                                          // noCompress
+            &hl::thread_pool::get_default());               // pool
 
         break;
 
@@ -900,7 +905,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            false);                                         // noCompress
+            false,                                          // noCompress
+            &hl::thread_pool::get_default());               // pool
 
         break;
 
@@ -917,7 +923,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            false);                                         // noCompress
+            false,                                          // noCompress
+            &hl::thread_pool::get_default());               // pool
 
         break;
 
@@ -934,7 +941,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            false);                                         // noCompress
+            false,                                          // noCompress
+            &hl::thread_pool::get_default());               // pool
 
         break;
 
@@ -951,7 +959,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            false);                                         // noCompress
+            false,                                          // noCompress
+            &hl::thread_pool::get_default());               // pool
 
         break;
 
@@ -968,7 +977,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            false);                                         // noCompress
+            false,                                          // noCompress
+            &hl::thread_pool::get_default());               // pool
 
         break;
 
@@ -985,7 +995,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            false);                                         // noCompress
+            false,                                          // noCompress
+            &hl::thread_pool::get_default());               // pool
 
         break;
 
@@ -1021,25 +1032,38 @@ static void pack(const arguments& args)
     }
 }
 
-static hl::archive load_arc(const arguments& args)
+static hl::archive load_arc(const arguments& args,
+    std::vector<hl::mapped_file>& mappings)
 {
+    // NOTE: Where possible, we memory-map archives and have the entries point
+    // directly into the mappings, rather than making copies of every file.
+    hl::archive arc;
     switch (args.type)
     {
     case arc_type::hh_ar:
-        return hl::hh::ar::load(hl::hh::ar::get_root_path(args.input));
+        hl::hh::ar::load_mapped(hl::hh::ar::get_root_path(args.input),
+            arc, mappings);
+        return arc;
 
     case arc_type::hh_pfd:
-        return hl::hh::ar::load(args.input);
+        hl::hh::ar::load_mapped(args.input, arc, mappings);
+        return arc;
 
     case arc_type::pacx:
-        return hl::pacx::load(hl::pacx::get_root_path(args.input));
+        hl::pacx::load_mapped(hl::pacx::get_root_path(args.input),
+            arc, mappings, &hl::thread_pool::get_default());
+        return arc;
 
     case arc_type::lw:
     case arc_type::rio:
-        return hl::pacx::v2::load(hl::pacx::get_root_path(args.input));
+        hl::pacx::v2::load_mapped(hl::pacx::get_root_path(args.input),
+            arc, mappings);
+        return arc;
 
     case arc_type::forces:
-        return hl::pacx::v3::load(hl::pacx::get_root_path(args.input));
+        hl::pacx::v3::load_mapped(hl::pacx::get_root_path(args.input),
+            arc, mappings);
+        return arc;
 
     case arc_type::tokyo1:
     case arc_type::tokyo2:
@@ -1047,7 +1071,8 @@ static hl::archive load_arc(const arguments& args)
     case arc_type::ppt2:
     case arc_type::frontiers:
     case arc_type::sxsg:
-        return hl::pacx::v4::load(args.input);
+        return hl::pacx::v4::load(args.input, true,
+            &hl::thread_pool::get_default());
 
     default:
         throw hl::unsupported_exception();
@@ -1060,10 +1085,11 @@ static void extract(const arguments& args)
     hl::console::write_line(get_text(text_id::extracting));
 
     // Load archive based on type.
-    hl::archive arc = load_arc(args);
+    std::vector<hl::mapped_file> mappings;
+    hl::archive arc = load_arc(args, mappings);
 
     // Extract archive.
-    arc.extract(args.output);
+    arc.extract(args.output, true, &hl::thread_pool::get_default());
 }
 
 int HL_NMAIN(int argc, hl::nchar* argv[])
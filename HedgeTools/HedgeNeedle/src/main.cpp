@@ -306,6 +306,9 @@ static void pack(const hl::nchar* input, const hl::nchar* output)
     arc.jump_to(fileStartPos + 8);
     arc.write_obj(arcSize);
     arc.jump_to(arcEndPos);
+
+    // Close file.
+    arc.close();
 }
 
 int HL_NMAIN(int argc, hl::nchar* argv[])
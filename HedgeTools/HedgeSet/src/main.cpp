@@ -3,6 +3,8 @@
 #include <hedgelib/io/hl_path.h>
 #include <hedgelib/io/hl_file.h>
 #include <hedgelib/hl_tool_helpers.h>
+#include <hedgelib/hl_thread_pool.h>
+#include <algorithm>
 
 static hl::language current_language = hl::get_default_language();
 
@@ -98,6 +100,9 @@ static void print_usage(const hl::nchar* templateDir, std::FILE* s)
     hl::nfputs(HL_NTEXT("HedgeSet input [output] [flags]\n\n"), s);
     hl::nfputs(HL_NTEXT("Arguments surrounded by square brackets are optional. If they\n"), s);
     hl::nfputs(HL_NTEXT("aren't specified, they will be auto-deterined based on input.\n\n"), s);
+    hl::nfputs(HL_NTEXT("If input is a directory, every game set data file within it\n"), s);
+    hl::nfputs(HL_NTEXT("will be converted to HSON in parallel, and output (if specified)\n"), s);
+    hl::nfputs(HL_NTEXT("is treated as the directory to write the HSON files to.\n\n"), s);
     hl::nfputs(HL_NTEXT("If the desired game type wasn't specified with -game, the user\n"), s);
     hl::nfputs(HL_NTEXT("will be prompted to enter one.\n\n"), s);
     hl::nfputs(HL_NTEXT("Flags:\n\n"), s);
@@ -167,6 +172,87 @@ static void convert_gedit_v3_to_hson(const hl::set_object_type_database& objType
     hsonProject.save(output);
 }
 
+static bool convert_gedit_v3_dir_to_hson(const hl::set_object_type_database& objTypeDB,
+    const hl::nchar* inputDir, const hl::nchar* outputDir, platform_type platform)
+{
+    // Get the names of every .gedit file within the input directory, sorted
+    // so the files are always converted and reported in the same order.
+    std::vector<hl::nstring> fileNames;
+    for (const auto dirEntry : hl::path::dir(inputDir))
+    {
+        if (dirEntry.type() == hl::path::dir_entry_type::regular &&
+            hl::text::iequal(hl::path::get_ext(dirEntry.name()),
+                hl::hh::gedit::extension))
+        {
+            fileNames.emplace_back(dirEntry.name());
+        }
+    }
+
+    std::sort(fileNames.begin(), fileNames.end());
+
+    // Generate input and output file paths.
+    std::vector<hl::nstring> inputs, outputs;
+    inputs.reserve(fileNames.size());
+    outputs.reserve(fileNames.size());
+
+    for (const auto& fileName : fileNames)
+    {
+        const auto outputName = (hl::path::remove_ext(fileName) + HL_NTEXT(".hson"));
+        inputs.push_back(hl::path::combine(inputDir, fileName.c_str()));
+        outputs.push_back(hl::path::combine(outputDir, outputName.c_str()));
+    }
+
+    // Convert every file, sharing the same templates between them.
+    hl::nprintf(HL_NTEXT("Converting %zu gedit files to HSON...\n"), inputs.size());
+    hl::path::create_dir(outputDir);
+
+    std::vector<std::exception_ptr> errors;
+    hl::hh::gedit::v3::convert_to_hson(inputs, outputs, objTypeDB,
+        platform == platform_type::pc ||
+        platform == platform_type::xbox_one ||
+        platform == platform_type::xbox_series_s ||
+        platform == platform_type::xbox_series_x,
+        &errors, &hl::thread_pool::get_default());
+
+    // Report any files which failed to convert.
+    bool succeeded = true;
+    for (std::size_t i = 0; i < errors.size(); ++i)
+    {
+        if (!errors[i]) continue;
+
+        succeeded = false;
+        try
+        {
+            std::rethrow_exception(errors[i]);
+        }
+        catch (const std::exception& ex)
+        {
+            hl::nfprintf(stderr, HL_NTEXT("ERROR: Failed to convert \"%s\": %hs\n"),
+                inputs[i].c_str(), ex.what());
+        }
+        catch (...)
+        {
+            hl::nfprintf(stderr, HL_NTEXT("ERROR: Failed to convert \"%s\".\n"),
+                inputs[i].c_str());
+        }
+    }
+
+    return succeeded;
+}
+
+static bool convert_game_dir_to_hson(const hl::set_object_type_database& objTypeDB,
+    const hl::nchar* inputDir, const hl::nchar* outputDir, platform_type platform)
+{
+    switch (objTypeDB.format)
+    {
+    case hl::set_object_format::gedit_v3:
+        return convert_gedit_v3_dir_to_hson(objTypeDB, inputDir, outputDir, platform);
+
+    default:
+        return true;
+    }
+}
+
 static void convert_game_to_hson(const hl::set_object_type_database& objTypeDB,
     const hl::nchar* input, const hl::nchar* output, platform_type platform)
 {
@@ -192,7 +278,8 @@ static void convert_hson_to_gedit_v3(const hl::set_object_type_database& objType
         platform == platform_type::pc ||
         platform == platform_type::xbox_one ||
         platform == platform_type::xbox_series_s ||
-        platform == platform_type::xbox_series_x);
+        platform == platform_type::xbox_series_x,
+        nullptr, &hl::thread_pool::get_default());
 }
 
 static void convert_hson_to_game(const hl::set_object_type_database& objTypeDB,
@@ -313,15 +400,32 @@ int HL_NMAIN(int argc, hl::nchar* argv[])
             return EXIT_FAILURE;
         }
 
-        // Load templates for the given game.
+        // Load templates for the given game, using (or generating) a binary
+        // cache alongside them so they don't need to be re-parsed every time.
         hl::nprintf(HL_NTEXT("Loading templates for %s...\n"), game);
+        const auto templatePath = hl::path::combine(templateDir, game);
         const hl::set_object_type_database objTypeDB(
-            hl::path::combine(templateDir, game) +
-            HL_NTEXT(".json"));
+            templatePath + HL_NTEXT(".json"), templatePath +
+            hl::set_object_type_database_cache_extension);
 
-        // Convert HSON to game format.
+        // Convert every file in a directory of game format files to HSON.
         const auto ext = hl::path::get_ext(input);
-        if (hl::text::iequal(ext, HL_NTEXT(".hson")))
+        if (hl::path::is_dir(input))
+        {
+            if (!output)
+            {
+                output = input;
+            }
+
+            if (!convert_game_dir_to_hson(objTypeDB, input, output, platform))
+            {
+                hl::console::pause_if_necessary(current_language);
+                return EXIT_FAILURE;
+            }
+        }
+
+        // Convert HSON to game format.
+        else if (hl::text::iequal(ext, HL_NTEXT(".hson")))
         {
             if (!output)
             {
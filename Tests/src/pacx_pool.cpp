@@ -0,0 +1,247 @@
+#include <hedgelib/hl_tool_helpers.h>
+#include <hedgelib/archives/hl_pacx.h>
+#include <hedgelib/io/hl_file.h>
+#include <hedgelib/io/hl_path.h>
+#include <hedgelib/hl_thread_pool.h>
+#include <exception>
+#include <vector>
+#include <cstring>
+#include <cstdio>
+
+// Checks that saving a pac with a thread pool produces exactly
+// the same bytes as saving it serially, for every PACx version.
+
+enum class pac_version
+{
+    v2,
+    v3,
+    v402,
+    v403,
+    v405
+};
+
+struct test_case
+{
+    const char* name;
+    const hl::nchar* dirName;
+    pac_version version;
+    hl::compress_type compressType;
+    hl::bina::endian_flag endianFlag;
+};
+
+static const test_case test_cases[] =
+{
+    { "v2 (little endian)", HL_NTEXT("v2_le"), pac_version::v2,
+        hl::compress_type::none, hl::bina::endian_flag::little },
+
+    { "v2 (big endian)", HL_NTEXT("v2_be"), pac_version::v2,
+        hl::compress_type::none, hl::bina::endian_flag::big },
+
+    { "v3 (little endian)", HL_NTEXT("v3_le"), pac_version::v3,
+        hl::compress_type::none, hl::bina::endian_flag::little },
+
+    { "v3 (big endian)", HL_NTEXT("v3_be"), pac_version::v3,
+        hl::compress_type::none, hl::bina::endian_flag::big },
+
+    { "v402 lz4 (little endian)", HL_NTEXT("v402_lz4_le"), pac_version::v402,
+        hl::compress_type::lz4, hl::bina::endian_flag::little },
+
+    { "v402 lz4 (big endian)", HL_NTEXT("v402_lz4_be"), pac_version::v402,
+        hl::compress_type::lz4, hl::bina::endian_flag::big },
+
+    { "v403 lz4 (little endian)", HL_NTEXT("v403_lz4_le"), pac_version::v403,
+        hl::compress_type::lz4, hl::bina::endian_flag::little },
+
+    { "v403 lz4 (big endian)", HL_NTEXT("v403_lz4_be"), pac_version::v403,
+        hl::compress_type::lz4, hl::bina::endian_flag::big },
+
+    { "v403 deflate (little endian)", HL_NTEXT("v403_deflate_le"), pac_version::v403,
+        hl::compress_type::deflate, hl::bina::endian_flag::little },
+
+    { "v403 deflate (big endian)", HL_NTEXT("v403_deflate_be"), pac_version::v403,
+        hl::compress_type::deflate, hl::bina::endian_flag::big },
+
+    { "v405 deflate (little endian)", HL_NTEXT("v405_deflate_le"), pac_version::v405,
+        hl::compress_type::deflate, hl::bina::endian_flag::little },
+
+    { "v405 deflate (big endian)", HL_NTEXT("v405_deflate_be"), pac_version::v405,
+        hl::compress_type::deflate, hl::bina::endian_flag::big }
+};
+
+// NOTE: These are small enough that the test runs quickly, but still
+// big enough that every pac is split and every root is compressed
+// as multiple chunks.
+constexpr hl::u32 split_limit = 0x40000;
+constexpr hl::u32 max_chunk_size = 0x10000;
+constexpr hl::u32 data_alignment = 16;
+
+static hl::archive_entry_list make_test_archive()
+{
+    static const char* const exts[] =
+    {
+        "dds", "lua", "model", "material", "xml"
+    };
+
+    hl::archive_entry_list arc;
+    hl::u32 state = 0x12345678;
+
+    for (unsigned int i = 0; i < 60; ++i)
+    {
+        // Generate some compressible pseudo-random data.
+        state = (state * 1664525U + 1013904223U);
+        std::vector<hl::u8> data(100 + (state % 200000));
+
+        for (auto& b : data)
+        {
+            state = (state * 1664525U + 1013904223U);
+            b = static_cast<hl::u8>(((state >> 24) % 9) * 5);
+        }
+
+        // Add file to archive.
+        char name[32];
+        std::snprintf(name, sizeof(name), "file%02u.%s", i, exts[i % 5]);
+
+        arc.push_back(hl::archive_entry::make_regular_file_utf8(
+            name, data.size(), data.data()));
+    }
+
+    return arc;
+}
+
+static void save_test_pac(hl::archive_entry_list& arc,
+    const test_case& test, const hl::nstring& filePath,
+    hl::thread_pool* pool)
+{
+    // NOTE: Pacs are given random UIDs, so we have to re-seed the UID
+    // generator to get the same UIDs when saving serially and in parallel.
+    hl::pacx::v3::seed_uid_generator(0);
+
+    switch (test.version)
+    {
+    case pac_version::v2:
+        hl::pacx::v2::save(arc, test.endianFlag, hl::pacx::lw_exts,
+            hl::pacx::lw_ext_count, filePath, split_limit,
+            data_alignment, nullptr, pool);
+        break;
+
+    case pac_version::v3:
+        hl::pacx::v3::save(arc, test.endianFlag, hl::pacx::forces_exts,
+            hl::pacx::forces_ext_count, filePath, split_limit,
+            data_alignment, nullptr, pool);
+        break;
+
+    case pac_version::v402:
+        hl::pacx::v4::v02::save(arc, max_chunk_size, test.compressType,
+            test.endianFlag, hl::pacx::forces_ext_count, hl::pacx::forces_exts,
+            filePath.c_str(), split_limit, data_alignment, false, pool);
+        break;
+
+    case pac_version::v403:
+        hl::pacx::v4::v03::save(arc, nullptr, max_chunk_size, test.compressType,
+            test.endianFlag, hl::pacx::rangers_ext_count, hl::pacx::rangers_exts,
+            filePath.c_str(), split_limit, data_alignment, false, pool);
+        break;
+
+    case pac_version::v405:
+        hl::pacx::v4::v05::save(arc, nullptr, max_chunk_size, test.compressType,
+            test.endianFlag, hl::pacx::miller_ext_count, hl::pacx::miller_exts,
+            filePath.c_str(), split_limit, data_alignment, false, pool);
+        break;
+    }
+}
+
+static bool files_equal(const hl::nstring& filePath1, const hl::nstring& filePath2)
+{
+    if (!hl::path::exists(filePath2.c_str()))
+    {
+        return false;
+    }
+
+    std::size_t size1, size2;
+    const auto data1 = hl::file::load(filePath1, &size1);
+    const auto data2 = hl::file::load(filePath2, &size2);
+
+    return (size1 == size2 && std::memcmp(data1.get(), data2.get(), size1) == 0);
+}
+
+static bool dirs_equal(const hl::nstring& dirPath1, const hl::nstring& dirPath2)
+{
+    std::size_t fileCount1 = 0, fileCount2 = 0;
+    for (const auto& entry : hl::path::dir(dirPath1))
+    {
+        if (entry.type() != hl::path::dir_entry_type::regular)
+            continue;
+
+        if (!files_equal(hl::path::combine(dirPath1.c_str(), entry.name()),
+            hl::path::combine(dirPath2.c_str(), entry.name())))
+        {
+            return false;
+        }
+
+        ++fileCount1;
+    }
+
+    for (const auto& entry : hl::path::dir(dirPath2))
+    {
+        if (entry.type() == hl::path::dir_entry_type::regular)
+        {
+            ++fileCount2;
+        }
+    }
+
+    return (fileCount1 == fileCount2);
+}
+
+int HL_NMAIN(int argc, hl::nchar* argv[])
+{
+    if (argc < 2)
+    {
+        std::fputs("Usage: PacxPoolTest <output directory>\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        hl::archive_entry_list arc = make_test_archive();
+        const hl::nstring outDir(argv[1]);
+        hl::thread_pool pool;
+        int result = EXIT_SUCCESS;
+
+        hl::path::create_dir(outDir);
+
+        for (const auto& test : test_cases)
+        {
+            // Save pac serially.
+            const hl::nstring testDir = hl::path::combine(outDir.c_str(), test.dirName);
+            const hl::nstring serialDir = hl::path::combine(testDir.c_str(), HL_NTEXT("serial"));
+            const hl::nstring pooledDir = hl::path::combine(testDir.c_str(), HL_NTEXT("pooled"));
+
+            hl::path::create_dir(testDir);
+            hl::path::create_dir(serialDir);
+            hl::path::create_dir(pooledDir);
+
+            save_test_pac(arc, test, hl::path::combine(
+                serialDir.c_str(), HL_NTEXT("test.pac")), nullptr);
+
+            // Save pac using a thread pool.
+            save_test_pac(arc, test, hl::path::combine(
+                pooledDir.c_str(), HL_NTEXT("test.pac")), &pool);
+
+            // Ensure both pacs (and all of their splits) are identical.
+            const bool isEqual = dirs_equal(serialDir, pooledDir);
+            std::printf("%s: %s\n", test.name, (isEqual) ? "OK" : "FAILED");
+
+            if (!isEqual)
+            {
+                result = EXIT_FAILURE;
+            }
+        }
+
+        return result;
+    }
+    catch (const std::exception& ex)
+    {
+        std::fprintf(stderr, "ERROR: %s\n", ex.what());
+        return EXIT_FAILURE;
+    }
+}